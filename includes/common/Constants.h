@@ -9,28 +9,44 @@ namespace Constants {
     inline constexpr int DEFAULT_WINDOW_WIDTH = 800;
     inline constexpr int DEFAULT_WINDOW_HEIGHT = 600;
 
+    // Resolutions offered in the options menu
+    struct Resolution {
+        int width;
+        int height;
+    };
+    inline constexpr Resolution RESOLUTIONS[] = { { 800, 600 }, { 1200, 800 }, { 1920, 1080 } };
+
     // Card dimensions
     inline constexpr int CARD_WIDTH = 150;
     inline constexpr int CARD_HEIGHT = 200;
     inline constexpr Uint32 CARD_HOVER_DELAY = 2000;
     inline constexpr float CARD_MAGNIFICATION_SCALE = 1.5f;
+    inline constexpr Uint32 CARD_MAGNIFY_DURATION = 150;
+    inline constexpr Uint32 CARD_MOVE_DURATION = 200;
+    inline constexpr Uint32 DAMAGE_NUMBER_DURATION = 800;
     inline constexpr Uint8 CARD_LOW_ENERGY_ALPHA = 128;
     inline constexpr Uint8 CARD_FULL_ALPHA = 255;
 
-    // Reward scene card positions
+    // Debug overlay (F3) averaging window
+    inline constexpr Uint32 OVERLAY_REFRESH_MS = 500;
+
+    // Battle hint search time per request
+    inline constexpr double HINT_SEARCH_MS = 150.0;
+
+    // Reward scene card positions (reference pixels, scaled by Layout)
     inline constexpr int REWARD_CARD_BASE_X = 200;
     inline constexpr int REWARD_CARD_Y = 200;
     inline constexpr int REWARD_CARD_SPACING = 150;
 
-    // Reward scene rarity probabilities
-    inline constexpr float RARITY_PROBABILITY_THRESHOLD = 0.5f;
-
     // File paths
     inline const std::string ASSET_PATH = "assets/";
+    inline const std::string ASSET_PACK_PATH = "assets.pack"; // baked by RoguelikeAssetPacker next to the executable
+    inline const std::string EVENT_LOG_PATH = "events.rcel"; // battles played, appended every session; read with RoguelikeSimulator events
     inline const std::string CARD_PATH = ASSET_PATH + "cards/";
     inline const std::string CARD_SUFFIX = "_card.png";
     inline const std::string FONT_PATH = ASSET_PATH + "fonts/arial.ttf";
     inline constexpr int FONT_SIZE = 24;
+    inline constexpr unsigned int FONT_BASE_DPI = 72; // SDL_ttf default that FONT_SIZE was tuned for
 
     // Colors
     inline const SDL_Color COLOR_WHITE = { 255, 255, 255, 255 };
@@ -4,34 +4,47 @@
 #include <SDL.h>
 #include <SDL_ttf.h>
 #include <SDL_image.h>
+#include <cstdint>
 #include <memory>
+#include <random>
 #include <vector>
 #include <string>
 #include "../scenes/Scene.h"
 #include "../ui/Card.h"
-#include "../entities/Enemy.h"
 #include "../systems/TextureManager.h"
+#include "../systems/FontManager.h"
+#include "../systems/TweenScheduler.h"
+#include "../systems/InputManager.h"
+#include "../systems/SimulationThread.h"
+#include "../systems/MemoryStats.h"
+#include "../systems/AssetWatcher.h"
+#include "../ui/DebugOverlay.h"
+#include "../simulation/CardLibrary.h"
+#include "../simulation/EventLog.h"
 
 class GameScene;
 class OptionsScene;
 
 class Game {
 public:
-    enum class GameState { MENU, DECK_SELECTION, GAME, BATTLE, REWARD, OPTIONS };
-    enum class DeckType { DAMAGE, BALANCED, ELEMENTAL, DEFENSE };
-    enum class CardRarity { Common, Rare, Epic };
+    enum class GameState { MENU, DECK_SELECTION, GAME, BATTLE, REWARD, OPTIONS, STRESS_TEST };
+    using DeckType = StarterDeck;
+    using CardRarity = ::CardRarity;
 
     Game();
     ~Game();
     bool init(const char* title, int width, int height);
     void handleEvents();
+    void update();
+    void update(Uint32 now); // drives tweens and the scene from a caller-supplied clock
     void render();
     void clean();
     bool running() const { return isRunning; }
 
     void setState(GameState newState);
     void selectDeck(DeckType deck);
-    void startBattle(const std::string& enemyName, int enemyHP, int enemyDamage);
+    void startBattle(int encounter); // index into EnemyTable::getDefault()
+    void startBattle(std::unique_ptr<Scene> scene); // a BattleScene the map built ahead
     void endBattle(bool won);
     const std::vector<Card>& getSelectedDeck() const { return selectedDeck; }
 
@@ -45,8 +58,22 @@ public:
     void setResolution(int width, int height);
     void setFullScreen(bool fullScreen);
 
+    // Returns the UI font at the given reference point size, scaled for the current
+    // resolution and display DPI. Fonts are cached, so this is cheap to call.
+    TTF_Font* getFont(int pointSize);
+    TweenScheduler& getTweens() { return tweens; }
+    // Background worker for hint searches and deck analysis.
+    SimulationThread& getSimulation() { return simulation; }
+    // Where battles record their plays; null when the log could not be opened.
+    EventLog::Buffer* getEvents() { return events.get(); }
+    // Seeds for battle shuffles and reward rolls. Random unless setSeed() fixed the
+    // sequence, which makes a run reproducible (render harness, bug reports).
+    std::uint64_t nextSeed() { return seeds(); }
+    void setSeed(std::uint64_t seed) { seeds.seed(seed); }
+
     void addCardToDeck(const Card& card);
-    std::vector<Card> getRewardCards(CardRarity maxRarity, int count = 1);
+    // Card widget for an index into CardLibrary::getCardPool().
+    const Card& getPoolCard(int index) const { return allCards[index]; }
 
     void handleBattleCompletion(bool won);
 
@@ -70,15 +97,66 @@ private:
 
     std::vector<Card> allCards;
     void initializeCards();
-    void reloadFont(); // New method to reload font
+    void updateFont();
 
     std::unique_ptr<Scene> menuScene;
     std::unique_ptr<Scene> deckSelectionScene;
     std::unique_ptr<Scene> battleScene;
     std::unique_ptr<Scene> rewardScene;
     std::unique_ptr<Scene> optionsScene;
+    std::unique_ptr<Scene> stressTestScene;
 
     TextureManager textureManager;
+    FontManager fontManager;
+    unsigned int fontDpi;
+    std::mt19937_64 seeds;
+
+    // F3 overlay, averaged over Constants::OVERLAY_REFRESH_MS
+    struct FrameTotals {
+        int frames;
+        double frameMs;
+        double renderMs;
+        long long drawCalls;
+        long long textureSwitches;
+    };
+    DebugOverlay overlay;
+    bool overlayVisible;
+    Uint64 lastFrameStart;
+    Uint32 overlayUpdatedAt;
+    FrameTotals frameTotals;
+    MemoryStats::Counters overlayMemoryStart;
+    void updateOverlay(Uint64 frameStart, Uint64 renderEnd);
+
+    // Allocations charged to each state since startup, for the exit summary of the
+    // ROGUECARDS_MEMORY_STATS build. A scene's construction counts towards it,
+    // or towards the map when the map built it ahead.
+    struct SceneMemory {
+        int visits;
+        long long frames;
+        long long heapAllocations;
+        long long heapBytes;
+        long long sdlAllocations;
+        long long sdlBytes;
+        long long texturesCreated;
+    };
+    static constexpr int STATE_COUNT = static_cast<int>(GameState::STRESS_TEST) + 1;
+    SceneMemory sceneMemory[STATE_COUNT];
+    MemoryStats::Counters sceneMemoryStart;
+    void recordSceneMemory(); // charges everything since the last call to the current state
+    void printMemorySummary() const;
+
+    // ROGUECARDS_HOT_RELOAD: card art and enemy data saved while the game runs are
+    // applied at the start of the next update, before that frame renders.
+    AssetWatcher assetWatcher;
+    std::vector<std::string> changedAssets; // reused every poll
+    void applyAssetChanges();
+
+    EventLog eventLog;
+    std::unique_ptr<EventLog::Buffer> events;
+    TweenScheduler tweens;
+    InputManager input;
+    // Declared last so its worker is joined first when the game shuts down.
+    SimulationThread simulation;
 };
 
 #endif
\ No newline at end of file
@@ -4,71 +4,149 @@
 #include "Scene.h"
 #include "../ui/Card.h"
 #include "../ui/Button.h"
-#include "../entities/Enemy.h"
+#include "../ui/Layout.h"
+#include "../ui/HitGrid.h"
 #include "../systems/TextureManager.h"
+#include "../simulation/CombatState.h"
+#include "../simulation/CombatHistory.h"
+#include "../simulation/EventLog.h"
+#include "../systems/TripleBuffer.h"
 #include <vector>
 #include <functional>
+#include <memory>
+#include <string>
 
 class Game;
 
 class BattleScene : public Scene {
 public:
-    BattleScene(SDL_Renderer* renderer, TTF_Font* font, const Enemy& enemy, Game* game);
+    BattleScene(SDL_Renderer* renderer, TTF_Font* font, int encounter, Game* game);
+    ~BattleScene();
     void render() override;
     void handleEvent(SDL_Event& e) override;
+    void handleAction(InputAction action) override;
+    void update(Uint32 now) override;
     bool isBattleOver() const;
     bool hasPlayerWon() const;
     bool isReadyToEnd() const; 
     void setRenderer(SDL_Renderer* renderer) override;
     void setFont(TTF_Font* font) override;
+    void reloadTexture(const std::string& path) override { textureManager.reloadTexture(path); }
 
 private:
+    struct DamageNumber {
+        SDL_Texture* texture;
+        SDL_Rect rect;
+        TweenScheduler::Handle tween;
+    };
+
+    // Published by the simulation thread when a hint search finishes.
+    struct HintResult {
+        unsigned request;
+        int action;
+        int handIndex;
+        long long rollouts;
+        double elapsedMs;
+    };
+
     SDL_Renderer* renderer;
     TTF_Font* font;
     Game* game;
-    Enemy enemy;
+    std::string enemyName; // the numbers live in `state`
+    std::string encounterId; // for the event log
+    bool loggedStart;
+    bool loggedEnd;
     SDL_Texture* enemyHPText;
-    int playerHP;
+    SDL_Texture* intentText; // the enemy's next move, above its HP
     SDL_Texture* playerHPText;
-    int playerArmor;
     SDL_Texture* armorText;
     bool battleWon;
     bool playerDefeated;
     bool readyToEnd; 
     Button continueButton;
     SDL_Rect boardRect;
+    // The battle itself. Card widgets only mirror state.hand: piles are spec ids,
+    // so a snapshot for undo or a preview is a plain copy.
+    CombatState state;
+    CombatHistory history; // plays within the current turn
+    std::vector<Card> specCards; // one widget per combat deck spec, copied into the hand on draw
     std::vector<Card> hand;
-    std::vector<Card> drawPile;
-    std::vector<Card> discard;
-    int playerEnergy;
-    int maxEnergy;
+    std::vector<Card> discardingCards; // copies animating towards the discard pile
+    std::vector<DamageNumber> damageNumbers;
     SDL_Texture* energyText;
     Button skipTurnButton;
+    Button hintButton;
+    Button undoButton;
+    Button redoButton;
     TextureManager textureManager;
     SDL_Rect playerTextRect;
     SDL_Texture* playerText;
     SDL_Rect enemyTextRect;
     SDL_Texture* enemyText;
+    SDL_Rect enemyHPRect;
+    SDL_Rect intentRect;
+    SDL_Rect playerHPRect;
+    SDL_Rect armorRect;
+    SDL_Rect energyRect;
+    SDL_Texture* previewText;
+    SDL_Rect previewRect;
+    int previewIndex;   // hand slot the preview describes, -1 if none
+
+    Layout layout;
+    int boardAnchor;
+    int enemyHPAnchor;
+    int intentAnchor;
+    int playerHPAnchor;
+    int armorAnchor;
+    int energyAnchor;
+    int enemyTextAnchor;
+    int playerTextAnchor;
+    int continueAnchor;
+    int skipTurnAnchor;
+    int hintAnchor;
+    int undoAnchor;
+    int redoAnchor;
+    int previewAnchor;
+    int drawPileAnchor;
+    int discardPileAnchor;
+    int handRow;
+    HitGrid handHitGrid;
+    int hoveredIndex;
+    int draggingIndex;
 
+    CombatDeck combatDeck;
+    int hintIndex;      // hand slot the agent suggests playing, -1 if none
+    bool hintEndTurn;
+    unsigned hintRequest; // results for any other request are stale
+    std::shared_ptr<TripleBuffer<HintResult>> hintResults;
 
     void updateHPText();
+    void updateIntentText();
     void updatePlayerHPText();
     void updateArmorText();
     void updateEnergyText();
-    void drawCard();
-    void playCard(Card& card);
-    void applyWeakenEffect(int value, int turns);
-    void applyPoisonEffect(int damage, int turns);
-    void applyThornsEffect();
-    void applyWetEffect(int turns);
-    void applyLightningEffect(int damage);
-    void applyIceEffect(int damage, int freezeTurns);
-    void updateEnemyEffects();
-    void enemyAttack();
+    void playCard(int handIndex);
     void endTurn();
-    void resetTurn();
+    void undo();
+    void redo();
+    // Refreshes texts, damage numbers and battle flags after `state` moved on from `before`.
+    void applyStateChange(const CombatState& before, SDL_Color enemyDamageColor);
+    // The game's event buffer, or null. The battle's first row is written on its first
+    // action, so a scene prebuilt for a node the player never entered logs nothing.
+    EventLog::Buffer* eventsFrom(const CombatState& before);
+    void logOutcome(EventLog::Buffer* events);
+    void syncHand(bool rebuild);
+    void reloadCardImage(Card& card);
     void updateCardPositions();
+    void updatePreview();
+    void clearPreview();
     void updateTextTextures();
+    void refreshLayout();
+    SDL_Rect placeText(int anchorId, SDL_Texture* texture) const;
+    void spawnDamageNumber(int amount, const SDL_Rect& origin, SDL_Color color);
+    void clearDamageNumbers();
+    void showHint();
+    void clearHint();
 };
 
 #endif
\ No newline at end of file
@@ -3,6 +3,10 @@
 
 #include "Scene.h"
 #include "../ui/Button.h"
+#include "../ui/Layout.h"
+#include "../systems/TripleBuffer.h"
+#include <memory>
+#include <string>
 #include <vector>
 
 class Game;
@@ -10,8 +14,11 @@ class Game;
 class DeckSelectionScene : public Scene {
 public:
     DeckSelectionScene(SDL_Renderer* renderer, TTF_Font* font, Game* game);
+    ~DeckSelectionScene();
     void render() override;
     void handleEvent(SDL_Event& e) override;
+    void handleAction(InputAction action) override;
+    void update(Uint32 now) override;
     void setRenderer(SDL_Renderer* renderer) override;
     void setFont(TTF_Font* font) override; // New method
 
@@ -20,6 +27,18 @@ private:
     TTF_Font* font;
     Game* game;
     std::vector<Button> buttons;
+    Layout layout;
+    int buttonColumn;
+    // One line of exact deck statistics per button, computed once on the
+    // simulation thread since starter decks never change.
+    std::vector<std::string> statLines;
+    std::vector<SDL_Texture*> statTextures;
+    std::shared_ptr<TripleBuffer<std::vector<std::string>>> statResults;
+
+    void refreshLayout();
+    void requestStatLines();
+    void createStatTextures();
+    void destroyStatTextures();
 };
 
 #endif
\ No newline at end of file
@@ -3,8 +3,12 @@
 
 #include "Scene.h"
 #include "../ui/Node.h"
+#include "../ui/Layout.h"
+#include "../ui/HitGrid.h"
+#include "../simulation/MapGraph.h"
 #include <vector>
 #include <functional>
+#include <memory>
 
 class Game;
 
@@ -13,24 +17,41 @@ public:
     GameScene(SDL_Renderer* renderer, TTF_Font* font, Game* game);
     void render() override;
     void handleEvent(SDL_Event& e) override;
+    void update(Uint32 now) override;
     void setRenderer(SDL_Renderer* renderer) override;
     void setFont(TTF_Font* font) override;
     void markNodeAsCompleted(int nodeIndex);
     void lockSiblingNodes(int completedNodeIndex);
     void updateProgression();
     bool isGameOver() const { return gameOver; }
+    // Drops scenes built ahead, e.g. when the data they were built from changed.
+    void discardPrewarmed();
 
 private:
     SDL_Renderer* renderer;
     TTF_Font* font;
     Game* game;
+    MapGraph graph;
     std::vector<Node> nodes;
     std::vector<int> activeNodes;
     std::vector<int> lockedNodes;
     int currentNodeIndex;
     bool gameOver;
     SDL_Texture* gameOverText;
+    Layout layout;
+    std::vector<int> nodeAnchors;
+    HitGrid nodeHitGrid; // clickable nodes only
+    bool hitGridDirty;
+    // The scene behind each reachable node, built on map frames before the click so
+    // entering a node only swaps it in. Indexed by node; cleared whenever the map is
+    // rebuilt, since the deck and the reachable nodes may have changed.
+    std::vector<std::unique_ptr<Scene>> prewarmed;
+    int hoveredNode; // built first
+    std::unique_ptr<Scene> buildNodeScene(int index);
     void initializeNodes();
+    void enterNode(int index);
+    void refreshLayout();
+    void rebuildHitGrid();
     void updateActiveNodes();
     void unlockNextNode();
 };
@@ -2,6 +2,7 @@
 #define MENU_SCENE_H
 
 #include "../ui/Button.h"
+#include "../ui/Layout.h"
 #include "Scene.h"
 #include <SDL.h>
 #include <SDL_ttf.h>
@@ -14,6 +15,7 @@ public:
     MenuScene(SDL_Renderer* renderer, TTF_Font* font, Game* game);
     void render() override;
     void handleEvent(SDL_Event& e) override;
+    void handleAction(InputAction action) override;
     void setRenderer(SDL_Renderer* renderer) override;
     void setFont(TTF_Font* font) override;
 
@@ -22,6 +24,10 @@ private:
     TTF_Font* font;
     Game* game;
     std::vector<Button> buttons;
+    Layout layout;
+    int buttonColumn;
+
+    void refreshLayout();
 };
 
 #endif
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "Scene.h"
 #include "../ui/Button.h"
+#include "../ui/Layout.h"
 #include <SDL.h>
 #include <SDL_ttf.h>
 #include <vector>
@@ -14,6 +15,7 @@ public:
     OptionsScene(SDL_Renderer* renderer, TTF_Font* font, Game* game);
     void render() override;
     void handleEvent(SDL_Event& e) override;
+    void handleAction(InputAction action) override;
     void setRenderer(SDL_Renderer* renderer) override;
     void setFont(TTF_Font* font) override; // New method
 
@@ -23,9 +25,12 @@ private:
     Game* game;
     std::vector<Button> buttons;
     Button* fullScreenButton;
+    Layout layout;
+    int buttonColumn;
 
     void initializeButtons();
     void updateFullScreenButton();
+    void refreshLayout();
 };
 
 #endif
\ No newline at end of file
@@ -3,18 +3,25 @@
 
 #include "Scene.h"
 #include "../ui/Card.h"
+#include "../ui/Layout.h"
+#include "../simulation/CardLibrary.h"
+#include "../systems/TripleBuffer.h"
+#include <memory>
+#include <string>
 #include <vector>
 
 class Game;
 
 class RewardScene : public Scene {
 public:
-    enum class RewardType { Green, Purple };
+    using RewardType = RewardTier;
 
     RewardScene(SDL_Renderer* renderer, TTF_Font* font, Game* game, RewardType rewardType);
     ~RewardScene(); // Add destructor to clean up texture
     void render() override;
     void handleEvent(SDL_Event& e) override;
+    void handleAction(InputAction action) override;
+    void update(Uint32 now) override;
     void setRenderer(SDL_Renderer* renderer) override;
     void setFont(TTF_Font* font) override;
 
@@ -27,9 +34,21 @@ private:
     std::vector<SDL_Rect> cardRects;
     SDL_Rect skipButtonRect;
     SDL_Texture* skipButtonTexture;
+    Layout layout;
+    int cardRow;
+    int skipAnchor;
+    // What each offered card would change in the current deck's per-turn numbers,
+    // computed on the simulation thread.
+    std::vector<std::string> previewLines;
+    std::vector<SDL_Texture*> previewTextures;
+    std::shared_ptr<TripleBuffer<std::vector<std::string>>> previewResults;
 
     void initializeRewardCards();
+    void requestPreviewLines();
+    void createPreviewTextures();
+    void destroyPreviewTextures();
     void createSkipButton();
+    void refreshLayout();
 };
 
 #endif
\ No newline at end of file
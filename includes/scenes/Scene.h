@@ -3,14 +3,19 @@
 
 #include <SDL.h>
 #include <SDL_ttf.h>
+#include <string>
+#include "../systems/InputManager.h"
 
 class Scene {
 public:
     virtual ~Scene() = default;
     virtual void render() = 0;
     virtual void handleEvent(SDL_Event& e) = 0;
+    virtual void handleAction(InputAction action) {} // Key presses mapped by InputManager
+    virtual void update(Uint32 now) {} // Called once per tick after the tween scheduler advances
     virtual void setRenderer(SDL_Renderer* renderer) = 0;
     virtual void setFont(TTF_Font* font) = 0; // New method
+    virtual void reloadTexture(const std::string& path) {} // Hot reload, for scenes with their own TextureManager
 };
 
 #endif
\ No newline at end of file
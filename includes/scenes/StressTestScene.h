@@ -0,0 +1,63 @@
+#ifndef STRESS_TEST_SCENE_H
+#define STRESS_TEST_SCENE_H
+
+#include "Scene.h"
+#include "../ui/Card.h"
+#include "../ui/Node.h"
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <vector>
+
+class Game;
+
+// Debug scene (F9 from the menu) that fills the window with card and map node
+// widgets and ramps their number through STEPS. Each step is measured over
+// SAMPLE_FRAMES frames for frame time, scene render time, draw calls and texture
+// switches, printed to the console and kept on screen. Every other card is dimmed
+// as unaffordable, every fourth is magnified and the nodes alternate opacity, so
+// each path through Card::render and Node::render is covered. Enter restarts the
+// ramp, Esc returns to the menu.
+class StressTestScene : public Scene {
+public:
+    static constexpr int STEPS[] = { 100, 250, 500, 1000, 2000, 4000 }; // widgets, half cards and half nodes
+    static constexpr int WARMUP_FRAMES = 10; // lazily created label and text textures
+    static constexpr int SAMPLE_FRAMES = 120;
+
+    StressTestScene(SDL_Renderer* renderer, TTF_Font* font, Game* game);
+    ~StressTestScene();
+    void render() override;
+    void handleEvent(SDL_Event& e) override {}
+    void handleAction(InputAction action) override;
+    void update(Uint32 now) override;
+    void setRenderer(SDL_Renderer* renderer) override;
+    void setFont(TTF_Font* font) override;
+
+private:
+    struct StepResult {
+        int elements;
+        double frameMs;
+        double renderMs;
+        double drawCalls;
+        double textureSwitches;
+    };
+
+    SDL_Renderer* renderer;
+    TTF_Font* font;
+    Game* game;
+    std::vector<Card> cards;
+    std::vector<Node> nodes; // reserved up front: Node owns its label texture and must not be copied
+    int step;
+    int frames;
+    Uint64 lastFrameStart;
+    StepResult totals;
+    std::vector<StepResult> results;
+    SDL_Texture* resultsText;
+    SDL_Rect resultsRect;
+
+    void restart();
+    void spawn(int elements);
+    void finishStep();
+    void updateResultsText();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,65 @@
+#ifndef BATCH_COMBAT_H
+#define BATCH_COMBAT_H
+
+#include <cstdint>
+#include "CombatState.h"
+
+// Plays many copies of one battle in lockstep, LANES fights at a time.
+//
+// Every fight's state (HP, armor, energy, statuses, enemy intent, hand, piles and RNG)
+// lives in structure-of-arrays form, one lane per fight, so choosing a card,
+// playing it and resolving the enemy phase are straight-line vector kernels:
+// each lane either plays a card or ends its turn, and the other half of the work
+// is masked off. Only the end-of-turn draws stay per lane, since few lanes end
+// their turn in the same step. The enemy's action table is eight entries per
+// field, so resolving each lane's intent is one register lookup per field. A
+// finished lane is refilled with the next fight straight away, so the vectors
+// stay full until the end.
+//
+// Cards are picked by the same random policy MCTS uses for rollouts, and fight i
+// draws from the same RNG stream as CombatState::begin(..., seed + i), so a batch
+// report matches runScalar() exactly and differs only in speed.
+//
+// The kernels need AVX2 (ROGUECARDS_AVX2). Narrower SSE2 and plain-loop versions
+// ran at 0.5-0.8x the scalar engine, so without AVX2 run() is runScalar().
+class BatchCombat {
+public:
+    static constexpr int LANES = 8;
+
+    struct Config {
+        int maxTurns;           // a fight still going after this many turns counts as a stall
+        std::uint64_t seed;
+
+        Config() : maxTurns(30), seed(1) {}
+    };
+
+    struct Report {
+        long long fights;
+        long long wins;
+        long long stalls;
+        long long totalTurns;
+        long long totalHP;      // player HP left, summed over wins
+        double elapsedMs;
+    };
+
+    // A null behavior attacks for enemyDamage every turn; otherwise it must outlive the batch.
+    BatchCombat(const CombatDeck& deck, int enemyHP, int enemyDamage, const Config& config = Config(),
+        const EnemyBehavior* behavior = nullptr);
+
+    Report run(long long fights) const;
+    // The same fights one at a time on CombatState, for comparison.
+    Report runScalar(long long fights) const;
+
+    // Which engine run() uses in this build: "AVX2" or "scalar".
+    static const char* getKernelName();
+    static bool isLockstep();
+
+private:
+    const CombatDeck& deck;
+    int enemyHP;
+    int enemyDamage;
+    Config config;
+    const EnemyBehavior* behavior;
+};
+
+#endif
\ No newline at end of file
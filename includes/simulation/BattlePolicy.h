@@ -0,0 +1,16 @@
+#ifndef BATTLE_POLICY_H
+#define BATTLE_POLICY_H
+
+#include "CombatState.h"
+
+// Cheap scripted play for bulk simulation, where a search per move would be too slow.
+namespace BattlePolicy {
+    // Immediate payoff of playing a card from hand: damage dealt, damage prevented
+    // this turn, healing, and set-up value for Wet before Lightning or Ice.
+    float scoreCard(const CombatState& state, const CombatDeck& deck, int spec);
+    // Plays the affordable card with the highest score and ends the turn when none helps.
+    // Returns a CombatState action id.
+    int greedy(const CombatState& state, const CombatDeck& deck);
+}
+
+#endif
\ No newline at end of file
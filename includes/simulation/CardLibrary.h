@@ -0,0 +1,28 @@
+#ifndef CARD_LIBRARY_H
+#define CARD_LIBRARY_H
+
+#include <string>
+#include <vector>
+#include <random>
+#include "CombatDeck.h"
+
+enum class StarterDeck { DAMAGE, BALANCED, ELEMENTAL, DEFENSE };
+enum class CardRarity { Common, Rare, Epic };
+enum class RewardTier { Green, Purple };
+
+// Card definitions shared by the game and the headless tools, so a simulated
+// battle always plays with the same numbers as the one on screen.
+namespace CardLibrary {
+    // Every card that can appear as a reward.
+    const std::vector<CardSpec>& getCardPool();
+    std::vector<CardSpec> getStarterDeck(StarterDeck deck);
+    CardRarity getRarity(const CardSpec& card);
+    // Rolls the cards offered by a reward node, as indices into getCardPool(),
+    // from the default RewardTable: three distinct cards.
+    std::vector<int> rollRewardOffer(RewardTier tier, std::mt19937& rng);
+    CombatDeck buildCombatDeck(const std::vector<CardSpec>& cards);
+    // Accepts the lowercase deck name ("damage", "balanced", ...).
+    bool parseStarterDeck(const std::string& name, StarterDeck& deck);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,48 @@
+#ifndef COMBAT_DECK_H
+#define COMBAT_DECK_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "../ui/CardEffect.h"
+
+// Everything the combat rules need to know about a card, without any rendering state.
+struct CardSpec {
+    std::string name;
+    int damage;
+    int energyCost;
+    CardEffect effect;
+
+    CardSpec(const std::string& n = "", int d = 0, int cost = 0, CardEffect e = CardEffect())
+        : name(n), damage(d), energyCost(cost), effect(e) {}
+
+    bool operator==(const CardSpec& other) const {
+        return name == other.name && damage == other.damage && energyCost == other.energyCost &&
+            effect.type == other.effect.type && effect.value == other.effect.value && effect.count == other.effect.count;
+    }
+};
+
+// A deck as seen by the simulation: each distinct card appears once in the spec
+// table and piles refer to it by a one-byte id, so combat states stay small and
+// trivially copyable.
+class CombatDeck {
+public:
+    using CardId = std::uint8_t;
+    static constexpr int MAX_SPECS = 32;
+
+    // Adds one copy of the card and returns its spec id, or -1 if the table is full.
+    int addCard(const CardSpec& spec);
+    // Spec id of an identical card, or -1. Names alone are not unique (the
+    // elemental deck carries two different Water Guns).
+    int findSpec(const CardSpec& spec) const;
+
+    const CardSpec& getSpec(int id) const { return specs[id]; }
+    int getSpecCount() const { return static_cast<int>(specs.size()); }
+    const std::vector<CardId>& getCards() const { return cards; }
+
+private:
+    std::vector<CardSpec> specs;
+    std::vector<CardId> cards;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef COMBAT_HISTORY_H
+#define COMBAT_HISTORY_H
+
+#include "CombatState.h"
+
+// Undo/redo over whole CombatState snapshots. A snapshot is a plain copy of a
+// couple of hundred bytes, so recording one per play costs nanoseconds and no
+// allocation; the oldest entries fall off the ring once it is full.
+class CombatHistory {
+public:
+    static constexpr int CAPACITY = 32;
+
+    CombatHistory();
+
+    // Forgets everything and starts from `state`.
+    void reset(const CombatState& state);
+    // Records the state after a move; anything that was undone is dropped.
+    void push(const CombatState& state);
+    // Steps back or forward, writing the restored snapshot to `state`.
+    bool undo(CombatState& state);
+    bool redo(CombatState& state);
+
+    bool canUndo() const { return cursor > 0; }
+    bool canRedo() const { return cursor + 1 < count; }
+
+private:
+    CombatState entries[CAPACITY];
+    int start;   // ring slot of the oldest snapshot
+    int count;   // snapshots kept
+    int cursor;  // offset from `start` of the current snapshot
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,137 @@
+#ifndef COMBAT_SOLVER_H
+#define COMBAT_SOLVER_H
+
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "CombatState.h"
+
+// Exact expectimax over a battle: the player maximises, draws average over the
+// remaining pile. Piles are treated as multisets (card order inside the hand or
+// draw pile cannot change the outcome), which is what keeps small decks solvable.
+//
+// Solved decision points go into a transposition table keyed by a Zobrist hash of
+// the pile counts, HP, armor, energy, enemy statuses, the enemy's intent and the
+// remaining turns. The enemy's next intent is a chance node like a draw. Worker
+// threads search the same root in different move orders and share the table, so
+// each one mostly picks up subtrees the others have not finished yet.
+//
+// One deliberate coarsening keeps armor decks solvable: armor above the enemy's
+// worst single attack is dropped. Stacked armor would otherwise split every line
+// into positions that differ only by how much shield is banked for later turns.
+// Dropping it can only lower a value, so reported win chances are a lower bound.
+class CombatSolver {
+public:
+    static constexpr int MAX_SPECS = 16;
+
+    struct Config {
+        int maxTurns;          // a fight not won within this many player turns counts as lost
+        int threads;           // 0 = one per hardware thread
+        size_t maxEntries;     // table stops growing beyond this many positions
+        long long maxNodes;    // the search gives up (solved = false) after expanding this many
+
+        Config() : maxTurns(20), threads(0), maxEntries(4u << 20), maxNodes(48ll << 20) {}
+    };
+
+    struct ActionValue {
+        int action;            // spec id or MctsAgent-style END_TURN (CombatDeck::MAX_SPECS)
+        double winProbability;
+    };
+
+    struct Result {
+        bool solved;           // false if the deck was too varied or the node budget ran out
+        bool saturated;        // the table filled up, so later positions were searched again instead of looked up
+        double winProbability;
+        std::vector<ActionValue> actions; // only for solve(), best first
+        long long nodes;
+        size_t entries;
+        double elapsedMs;
+    };
+
+    explicit CombatSolver(const Config& config = Config());
+
+    // Optimal win probability from a decision point, with the value of each legal move.
+    Result solve(const CombatState& state, const CombatDeck& deck);
+    // Optimal win probability of a fresh battle, averaged over every opening hand.
+    // A null behavior attacks for enemyDamage every turn.
+    Result solveOpening(const CombatDeck& deck, int enemyHP, int enemyDamage, std::uint16_t enemyResistances = 0,
+        const EnemyBehavior* behavior = nullptr);
+
+private:
+    enum Pile { HAND, DRAW, DISCARD, PILE_COUNT };
+    static constexpr int FIELD_COUNT = 16;
+
+    // Canonical position. Kept free of padding so equality is a memcmp.
+    struct Position {
+        std::uint8_t counts[PILE_COUNT][MAX_SPECS];
+        std::int16_t playerHP;
+        std::int16_t playerArmor;
+        std::int16_t playerPoison;
+        std::int16_t playerPoisonTurns;
+        std::int16_t energy;
+        std::int16_t enemyHP;
+        std::int16_t enemyBlock;
+        std::int16_t enemyStrength;
+        std::int16_t intent;
+        std::int16_t damageReduction;
+        std::int16_t weakenTurns;
+        std::int16_t poisonDamage;
+        std::int16_t poisonTurns;
+        std::int16_t wetTurns;
+        std::int16_t frozen;
+        std::int16_t turnsLeft;
+        std::int16_t pileSizes[PILE_COUNT];
+        std::int16_t padding;
+        std::uint64_t hash;
+    };
+    static_assert(sizeof(Position) == 96, "Position must not have implicit padding");
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::uint64_t, std::pair<Position, double>> entries;
+    };
+
+    static constexpr int SHARD_COUNT = 64;
+
+    Config config;
+    std::uint64_t pileKeys[PILE_COUNT][MAX_SPECS][CombatState::MAX_PILE + 1];
+    std::uint64_t fieldKeys[FIELD_COUNT][256];
+    Shard shards[SHARD_COUNT];
+    std::atomic<long long> nodeCount;
+    std::atomic<size_t> entryCount;
+    std::atomic<bool> aborted; // over the node budget: every search returns at once and stores nothing
+
+    const CombatDeck* deck;
+    int maxEnergy;
+    int enemyDamage;
+    int enemyMaxHP;
+    std::uint16_t resistances;
+    const EnemyBehavior* behavior;
+    int turnDamageBound;   // most damage the player can deal in one turn, poison tick included
+    std::uint64_t fieldKey(int field, int value) const;
+    void setField(Position& position, std::int16_t& field, int index, int value) const;
+    void moveCard(Position& position, Pile from, Pile to, int spec) const;
+    void rehash(Position& position) const;
+    Position fromState(const CombatState& state) const;
+    int incomingDamage(const Position& position) const;
+    // The enemy's worst attack at its current strength; see the class comment.
+    int armorCap(const Position& position) const;
+
+    bool lookup(const Position& position, double& value);
+    void store(const Position& position, double value);
+
+    double decide(const Position& position, int order);
+    double playCard(const Position& position, int spec, int order);
+    double endTurn(const Position& position, int order);
+    double drawThen(const Position& position, int cards, int order);
+    // Averages over the enemy's next intent, then draws.
+    double pickIntentThen(const Position& position, int cards, int order);
+
+    Result run(const Position& root, bool opening, int cards);
+    void reset(const CombatDeck& combatDeck, int energy, int damage, int maxHP, std::uint16_t enemyResistances,
+        const EnemyBehavior* enemyBehavior);
+};
+
+#endif
\ No newline at end of file
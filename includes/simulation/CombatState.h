@@ -0,0 +1,106 @@
+#ifndef COMBAT_STATE_H
+#define COMBAT_STATE_H
+
+#include <cstdint>
+#include <type_traits>
+#include "CombatDeck.h"
+#include "EnemyBehavior.h"
+
+// One battle reduced to plain values: the same rules as BattleScene, with no
+// textures, strings or heap allocations. Copying a state is a memcpy, which is
+// what lets search and batch simulation fork millions of them.
+//
+// The draw pile is kept unordered and cards are drawn from it uniformly at
+// random, which is equivalent to the scene's shuffled pile but does not leak the
+// real order to an agent playing from a snapshot.
+struct CombatState {
+    using CardId = CombatDeck::CardId;
+
+    static constexpr int MAX_HAND = 5;
+    static constexpr int REFILL_HAND = 3;
+    static constexpr int MAX_PILE = 48;
+    static constexpr int PLAYER_MAX_HP = 20;
+    static constexpr int PLAYER_MAX_ENERGY = 3;
+    static constexpr int THORNS_DAMAGE = 3;
+    // Action ids used by agents and policies: a spec id plays that card, END_TURN ends the turn.
+    static constexpr int END_TURN = CombatDeck::MAX_SPECS;
+
+    int playerHP;
+    int playerArmor;
+    int playerPoison;      // from the enemy's poison intent, ticks like the enemy's own poison
+    int playerPoisonTurns;
+    int energy;
+    int maxEnergy;
+
+    int enemyHP;
+    int enemyMaxHP;
+    int enemyDamage;
+    int damageReduction;
+    int weakenTurns;
+    int poisonDamage;
+    int poisonTurns;
+    int wetTurns;
+    bool frozen;
+    std::uint16_t resistances; // resistanceBit() per status the enemy ignores
+    int enemyBlock;        // soaks the player's damage, gone when the enemy acts again
+    int enemyStrength;     // added to every attack hit
+    int enemyIntent;       // what the enemy does next turn, an index into `behavior`
+    const EnemyBehavior* behavior; // null: attack for enemyDamage every turn
+
+    int turn;
+    std::uint8_t handCount;
+    std::uint8_t drawCount;
+    std::uint8_t discardCount;
+    CardId hand[MAX_HAND];
+    CardId drawPile[MAX_PILE];
+    CardId discard[MAX_PILE];
+    std::uint64_t rng;
+
+    CombatState();
+
+    // A fresh battle: the whole deck in the draw pile and the opening hand drawn.
+    static CombatState begin(const CombatDeck& deck, int enemyHP, int enemyDamage, std::uint64_t seed);
+
+    // Switches to an intent pattern and picks the first intent. The pattern must outlive the state.
+    void setBehavior(const EnemyBehavior* enemyBehavior);
+
+    void seed(std::uint64_t value);
+    std::uint32_t random(std::uint32_t bound);
+    // The generator behind random(), for callers that keep the state word elsewhere.
+    static std::uint32_t random(std::uint64_t& state, std::uint32_t bound);
+
+    // Weaken, Poison and Wet resist their status; Ice resists the freeze. Damage always lands.
+    static constexpr std::uint16_t resistanceBit(CardEffectType type) { return static_cast<std::uint16_t>(1u << static_cast<int>(type)); }
+    bool resists(CardEffectType type) const { return (resistances & resistanceBit(type)) != 0; }
+
+    // Damage the telegraphed intent would deal to the player's armor and HP, 0 while frozen.
+    int incomingDamage() const;
+    // Player damage to the enemy, taken off its block first.
+    void hitEnemy(int damage);
+
+    bool isOver() const { return enemyHP <= 0 || playerHP <= 0; }
+    // Matches the scene: an enemy dying to poison on the same turn it kills the player still counts as a win.
+    bool hasWon() const { return enemyHP <= 0; }
+
+    bool canPlay(int handIndex, const CombatDeck& deck) const;
+    void playCard(int handIndex, const CombatDeck& deck);
+    // Enemy phase, status ticks, next intent, refill and energy reset, in BattleScene::endTurn order.
+    void endTurn();
+    void drawCard();
+    // Plays the first card of the given kind in hand, or ends the turn.
+    void applyAction(int action, const CombatDeck& deck);
+
+    bool addToHand(CardId card);
+    bool addToDrawPile(CardId card);
+    bool addToDiscard(CardId card);
+    int findInHand(CardId card) const;
+
+private:
+    void enemyAct();
+    void updateEffects();
+    void pickIntent();
+};
+
+static_assert(std::is_trivially_copyable<CombatState>::value, "CombatState is copied by value in search loops");
+
+#endif
\ No newline at end of file
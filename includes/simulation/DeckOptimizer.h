@@ -0,0 +1,99 @@
+#ifndef DECK_OPTIMIZER_H
+#define DECK_OPTIMIZER_H
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "MapGraph.h"
+#include "RunSimulator.h"
+
+// A candidate archetype: a starting deck drawn from the reward pool plus a
+// preference for each pool card when it shows up as a reward.
+struct DeckGenome {
+    std::vector<int> counts;        // copies of each CardLibrary::getCardPool() card in the starting deck
+    std::vector<int> rewardWeights; // 0 = never take, higher is preferred
+
+    int getDeckSize() const;
+    std::vector<CardSpec> buildDeck() const;
+    RunPolicy buildPolicy() const;
+    std::string describe() const;
+
+    // Compact text form, used as the memo key and in checkpoints.
+    std::string toKey() const;
+    static bool fromKey(const std::string& key, DeckGenome& genome);
+};
+
+struct DeckFitness {
+    double score;         // what the search maximises
+    double runClearRate;  // fraction of whole runs cleared
+    double rosterScore;   // per-enemy win rate weighted by HP left, averaged over the map's fights
+};
+
+// Evolves deck genomes towards higher fitness. Fitness comes from batch
+// simulation with fixed seeds, so a genome always scores the same and is only
+// ever evaluated once; the memo doubles as the catalogue of every archetype seen,
+// which is where the weakest ones are reported from.
+class DeckOptimizer {
+public:
+    struct Config {
+        int population;
+        int generations;
+        int minDeckSize;
+        int maxDeckSize;
+        int maxCopies;
+        int eliteCount;
+        int tournamentSize;
+        float mutationRate;
+        long long runsPerEvaluation;
+        int battlesPerEnemy;
+        int threads;            // 0 = one per hardware thread
+        std::uint64_t seed;
+        std::string checkpointPath; // written after every generation when not empty
+
+        Config()
+            : population(32), generations(20), minDeckSize(4), maxDeckSize(8), maxCopies(3), eliteCount(2),
+            tournamentSize(3), mutationRate(0.2f), runsPerEvaluation(400), battlesPerEnemy(100), threads(0), seed(1) {}
+    };
+
+    struct Entry {
+        DeckGenome genome;
+        DeckFitness fitness;
+    };
+
+    DeckOptimizer(const MapGraph& graph, const Config& config);
+
+    // Runs until config.generations; resumes where a loaded checkpoint left off.
+    void run(const std::function<void(int generation, const Entry& best)>& onGeneration = nullptr);
+
+    bool saveCheckpoint(const std::string& path) const;
+    bool loadCheckpoint(const std::string& path);
+
+    std::vector<Entry> getStrongest(int count) const;
+    std::vector<Entry> getWeakest(int count) const;
+    size_t getEvaluatedCount() const { return memo.size(); }
+    int getGeneration() const { return generation; }
+
+    DeckFitness evaluate(const DeckGenome& genome) const;
+
+private:
+    MapGraph graph;
+    Config config;
+    std::mt19937 rng;
+    int generation;
+    std::vector<DeckGenome> population;
+    std::unordered_map<std::string, Entry> memo;
+
+    void evaluatePopulation();
+    const DeckFitness& fitnessOf(const DeckGenome& genome) const;
+    DeckGenome randomGenome();
+    DeckGenome crossover(const DeckGenome& a, const DeckGenome& b);
+    void mutate(DeckGenome& genome);
+    void repair(DeckGenome& genome);
+    const DeckGenome& tournament();
+    std::vector<Entry> sortedEntries(bool strongestFirst, int count) const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,53 @@
+#ifndef DECK_STATISTICS_H
+#define DECK_STATISTICS_H
+
+#include <cstddef>
+#include <vector>
+#include "CombatDeck.h"
+
+// Exact per-turn odds for a deck, computed by dynamic programming over pile
+// composition instead of by simulation.
+//
+// A position is how many copies of each card sit in the hand and in the draw
+// pile (the discard pile is the rest), plus the enemy statuses that change
+// damage. Each turn plays a fixed rule: Water Gun style cards first when the deck
+// can exploit Wet, then the best damage-plus-armor per energy that still fits.
+// Draws follow CombatState (fill to three, or one card, capped at five, with a
+// reshuffle when the draw pile runs out). Each draw branches into every multiset
+// of cards it could produce, weighted by the multivariate hypergeometric
+// distribution.
+//
+// Turns-to-kill counts only the player's damage; whether the player survives
+// that long is up to the enemy's attack and the BattleScene numbers.
+struct DeckTurnStats {
+    std::vector<double> inHand;   // per spec id: chance at least one copy is in hand when the turn starts
+    double expectedDamage;        // including poison ticking at the end of the turn
+    double expectedArmor;
+};
+
+struct DeckReport {
+    std::vector<DeckTurnStats> turns;
+    // killedBy[enemy][turn]: chance that enemy is dead by the end of that turn (0-based)
+    std::vector<std::vector<double>> killedBy;
+    size_t peakPositions;         // largest number of distinct positions in one turn
+    double elapsedUs;
+
+    // Mean turns to kill, counting fights not won within the horizon as horizon + 1.
+    double getExpectedTurnsToKill(int enemy) const;
+    double getMeanDamagePerTurn() const;
+    double getMeanArmorPerTurn() const;
+};
+
+namespace DeckStatistics {
+    constexpr int DEFAULT_TURNS = 6;
+    constexpr int MAX_TURNS = 16;
+
+    // Returns false (and leaves the report empty) if the deck is too varied to index exactly.
+    bool analyze(const CombatDeck& deck, const std::vector<int>& enemyHP, int turns, DeckReport& report);
+
+    // Closed form for a single card: the chance that `draws` cards taken from
+    // `population` include at least one of `copies`.
+    double atLeastOne(int population, int copies, int draws);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,87 @@
+#ifndef ENEMY_BEHAVIOR_H
+#define ENEMY_BEHAVIOR_H
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+enum class IntentType : std::uint8_t {
+    Attack,     // value damage per hit, `hits` times
+    Block,      // value block that soaks the player's damage until the enemy's next turn
+    Buff,       // value added to every later attack hit
+    Poison      // value damage to the player at the end of each of the next `turns` turns
+};
+
+// One entry of an enemy's pattern as written in the data file.
+struct IntentDef {
+    IntentType type;
+    int value;
+    int hits;
+    int turns;
+    int weight;          // chance to be picked while the enemy is above half HP
+    int lowHPWeight;     // the same at or below half HP
+    bool repeat;         // false: never picked twice in a row
+};
+
+// An enemy's intent pattern compiled into a fixed-size action table.
+//
+// Every intent is a row of plain deltas (damage, hits, block, strength, player
+// poison), so resolving one is the same arithmetic whatever its type. The next
+// intent depends only on the HP half the enemy is in and the intent it just
+// used; each of those cases has a cumulative weight row out of WEIGHT_ONE, and
+// picking is a count of thresholds below a random number. Fields are int32
+// arrays padded to MAX_INTENTS so the batch engine can load them as vectors.
+class EnemyBehavior {
+public:
+    static constexpr int MAX_INTENTS = 8;
+    static constexpr int NO_INTENT = MAX_INTENTS;      // the "last intent" before the first pick
+    static constexpr int ROWS = 2 * (MAX_INTENTS + 1);
+    static constexpr std::uint32_t WEIGHT_ONE = 1u << 16;
+
+    struct alignas(32) Table {
+        std::int32_t type[MAX_INTENTS];
+        std::int32_t damage[MAX_INTENTS];
+        std::int32_t hits[MAX_INTENTS];
+        std::int32_t block[MAX_INTENTS];
+        std::int32_t strength[MAX_INTENTS];
+        std::int32_t poison[MAX_INTENTS];
+        std::int32_t poisonTurns[MAX_INTENTS];
+        std::int32_t thresholds[ROWS][MAX_INTENTS]; // cumulative; unused slots hold WEIGHT_ONE
+    };
+
+    EnemyBehavior();
+
+    // A single attack every turn.
+    static EnemyBehavior attackOnly(int damage);
+
+    // Builds the table; `damageBonus` is added to every attack hit (act scaling).
+    bool compile(const std::vector<IntentDef>& intents, int damageBonus, std::string& error);
+
+    int getIntentCount() const { return count; }
+    const Table& getTable() const { return table; }
+
+    static int row(bool lowHP, int lastIntent) { return (lowHP ? MAX_INTENTS + 1 : 0) + lastIntent; }
+    // `roll` is uniform in [0, WEIGHT_ONE).
+    int pick(int row, std::uint32_t roll) const {
+        const std::int32_t* thresholds = table.thresholds[row];
+        int intent = 0;
+        for (int i = 0; i < MAX_INTENTS; ++i) {
+            intent += static_cast<std::int32_t>(roll) >= thresholds[i];
+        }
+        return intent;
+    }
+    double probability(int row, int intent) const;
+
+    // Appends a short label for the UI, e.g. "Attack 3x2" or "Block 6". `attackBonus`
+    // is added to each hit (the enemy's strength less any weaken on it). Takes a pmr
+    // string so the scene can format into its frame arena.
+    void describe(int intent, int attackBonus, std::pmr::string& text) const;
+    static bool parseType(const std::string& name, IntentType& type);
+
+private:
+    Table table;
+    int count;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,68 @@
+#ifndef ENEMY_TABLE_H
+#define ENEMY_TABLE_H
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+#include "EnemyBehavior.h"
+
+struct EnemyDef {
+    std::string id;
+    std::string name;
+    int hp;
+    int damage;
+    int hpPerAct;
+    int damagePerAct;
+    std::uint16_t resistances; // CombatState::resistances bits
+    std::vector<IntentDef> intents; // empty: attack for `damage` every turn
+};
+
+// One fight as it appears on the map: an enemy at an act, with the act's
+// scaling already applied so callers read the final numbers.
+struct EncounterDef {
+    std::string id;
+    int enemy;           // index into the table's enemies
+    int act;
+    std::string name;
+    int hp;
+    int damage;
+    std::uint16_t resistances;
+    EnemyBehavior behavior;  // for CombatState::setBehavior
+};
+
+// Enemy roster and encounters loaded from a text file (see assets/data/enemies.txt
+// for the format). Everything after loading refers to entries by index, so map
+// nodes, the battle scene and the simulators share one definition per fight.
+class EnemyTable {
+public:
+    static constexpr const char* DEFAULT_PATH = "assets/data/enemies.txt";
+
+    // Loaded from DEFAULT_PATH on first use; empty if that failed.
+    static const EnemyTable& getDefault();
+    // Hot reload: reads DEFAULT_PATH again and makes it the default if it parses
+    // and keeps every existing encounter at its index (map nodes store indices).
+    // Replaced tables stay alive, since a battle in progress and background jobs
+    // hold pointers into them. Main thread only.
+    static bool reloadDefault();
+
+    bool loadFromFile(const std::string& path);
+    // Replaces the table. On error, reports "source:line: message" and leaves the table empty.
+    bool load(std::istream& in, const std::string& source);
+
+    int findEnemy(const std::string& id) const;
+    int findEncounter(const std::string& id) const;
+    const EnemyDef& getEnemy(int index) const { return enemies[index]; }
+    const EncounterDef& getEncounter(int index) const { return encounters[index]; }
+    int getEnemyCount() const { return static_cast<int>(enemies.size()); }
+    int getEncounterCount() const { return static_cast<int>(encounters.size()); }
+
+    // Bit for one resistable status name ("weaken", "poison", "wet", "freeze"), or 0.
+    static std::uint16_t parseResistance(const std::string& status);
+
+private:
+    std::vector<EnemyDef> enemies;
+    std::vector<EncounterDef> encounters;
+};
+
+#endif
\ No newline at end of file
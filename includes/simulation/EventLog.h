@@ -0,0 +1,117 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "CombatState.h"
+
+// Append-only log of what happened in battles, written the same way by the game
+// and the headless simulators so runs can be analysed without parsing console
+// output. Only played moves are logged, never search rollouts.
+//
+// Each thread records into its own Buffer, which keeps one column per field and
+// hands the log a finished chunk every CHUNK_ROWS rows. A chunk stands alone:
+//
+//   "RCEL", u32 version, u32 rows, u32 words
+//   words x (varint length, bytes)            card and encounter names
+//   COLUMN_COUNT x (varint size, bytes)       in Column order
+//
+// A column is a list of (varint count, zigzag varint delta) runs: `count` rows
+// that each add `delta` to the previous row's value, starting from 0. Constant
+// and counting columns (battle, turn, encounter) shrink to a run or two, and the
+// rest mostly to a byte or two per row. Names are indices into the chunk's words.
+// Chunks from different threads interleave. Battle ids count up per open() and
+// sessions appending to the same file are told apart by a random session id.
+class EventLog {
+public:
+    static constexpr char MAGIC[4] = { 'R', 'C', 'E', 'L' };
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr int CHUNK_ROWS = 16384;
+
+    enum class Kind : std::uint8_t {
+        BattleStarted,
+        CardPlayed,
+        TurnEnded,      // enemy phase and status ticks
+        BattleEnded,
+        Undone,         // the game's undo; the state is the one restored
+        Redone
+    };
+    enum class Result : std::uint8_t { None, Won, Lost, Stalled };
+
+    enum Column {
+        SESSION,
+        KIND,
+        BATTLE,
+        TURN,
+        ENCOUNTER,      // word
+        CARD,           // word, -1 when no card
+        EFFECT,         // CardEffectType the play applied; None if there was none or it was resisted
+        ENEMY_DAMAGE,   // enemy HP lost in this event
+        PLAYER_DAMAGE,  // player HP lost in this event
+        PLAYER_HP,      // after the event
+        ENEMY_HP,
+        RESULT,
+        COLUMN_COUNT
+    };
+
+    struct Chunk {
+        int rows;
+        std::vector<std::string> words;
+        std::vector<std::int64_t> columns[COLUMN_COUNT];
+    };
+
+    // Records for one thread. Not thread-safe; flushes what is left when destroyed.
+    class Buffer {
+    public:
+        explicit Buffer(EventLog& log);
+        ~Buffer();
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+
+        // Starts a new battle id; later events belong to it.
+        void battleStarted(std::string_view encounter, const CombatState& state);
+        void cardPlayed(const CardSpec& card, const CombatState& before, const CombatState& after);
+        void turnEnded(const CombatState& before, const CombatState& after);
+        void battleEnded(const CombatState& state, Result result);
+        void historyMoved(Kind kind, const CombatState& before, const CombatState& after);
+        void flush();
+
+    private:
+        EventLog& log;
+        std::vector<std::int64_t> columns[COLUMN_COUNT];
+        std::map<std::string, int, std::less<>> dictionary;
+        std::vector<std::string_view> words; // keys of `dictionary`, by index
+        std::int64_t battle;
+        int encounter;
+        std::vector<unsigned char> bytes;
+
+        int intern(std::string_view word);
+        void push(Kind kind, const CombatState& before, const CombatState& after, int card, CardEffectType effect, Result result);
+    };
+
+    EventLog() : session(0), nextBattle(0) {}
+
+    // Appends to `path`, so sessions accumulate in one file.
+    bool open(const std::string& path);
+    bool isOpen() const { return file.is_open(); }
+
+    // Calls `visit` for each chunk in the file; false on a read or format error.
+    static bool read(const std::string& path, const std::function<void(const Chunk&)>& visit);
+
+private:
+    std::mutex mutex;
+    std::ofstream file;
+    std::int64_t session;
+    std::atomic<std::int64_t> nextBattle;
+
+    void write(const std::vector<unsigned char>& chunk);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,53 @@
+#ifndef MAP_GRAPH_H
+#define MAP_GRAPH_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "CardLibrary.h"
+#include "EnemyTable.h"
+
+enum class NodeType { Fight, Reward };
+
+struct MapNode {
+    std::string label;
+    NodeType type;
+    std::uint32_t color; // 0xRRGGBB
+    int encounter; // index into EnemyTable::getDefault(), fights only
+    RewardTier rewardTier;
+    std::vector<int> nextNodes;
+    std::vector<int> locks; // nodes that close once this one is completed
+};
+
+// The run's node graph. GameScene draws it and the headless run simulator walks
+// it, so both agree on which nodes open up after which.
+class MapGraph {
+public:
+    // The run's map, with fights taken from EnemyTable::getDefault() by encounter id.
+    static MapGraph createDefault();
+
+    int addFight(const std::string& label, std::uint32_t color, int encounter,
+        std::vector<int> nextNodes, std::vector<int> locks = {});
+    int addReward(const std::string& label, std::uint32_t color, RewardTier tier,
+        std::vector<int> nextNodes, std::vector<int> locks = {});
+
+    const MapNode& getNode(int index) const { return nodes[index]; }
+    // The encounter behind a fight node.
+    const EncounterDef& getEncounter(int index) const { return EnemyTable::getDefault().getEncounter(nodes[index].encounter); }
+    int getNodeCount() const { return static_cast<int>(nodes.size()); }
+    // The fight encounter with the most HP, or null if the map has no fights.
+    const EncounterDef* getToughestEncounter() const;
+    // False if a fight points at an encounter the enemy table does not have,
+    // e.g. because assets/data/enemies.txt failed to load.
+    bool isValid() const;
+
+    // Nodes that can be entered next: the first node at the start of a run, then any
+    // node reachable from a completed one that is neither completed nor locked.
+    // An empty result means the run is over.
+    std::vector<int> getAvailableNodes(const std::vector<bool>& completed, const std::vector<int>& locked) const;
+
+private:
+    std::vector<MapNode> nodes;
+};
+
+#endif
\ No newline at end of file
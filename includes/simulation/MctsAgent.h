@@ -0,0 +1,65 @@
+#ifndef MCTS_AGENT_H
+#define MCTS_AGENT_H
+
+#include <cstdint>
+#include <vector>
+#include "CombatState.h"
+
+// Chooses the next move in a battle with Monte Carlo Tree Search.
+//
+// Moves are "play a card of this kind" or "end the turn". The search is open
+// loop: tree nodes hold action sequences rather than states, and every iteration
+// replays the sequence on a fresh copy of the root with its own draws, so hidden
+// draw order is sampled instead of assumed. Each worker thread grows its own tree
+// from the root (root parallelism) and the visit counts are merged at the end,
+// which needs no locking on the hot path.
+class MctsAgent {
+public:
+    static constexpr int END_TURN = CombatState::END_TURN;
+    static constexpr int ACTION_COUNT = CombatDeck::MAX_SPECS + 1;
+
+    struct Config {
+        double budgetMs;        // wall-clock time per decision
+        int threads;            // 0 = one per hardware thread
+        int maxTurns;           // rollouts that run longer are scored as unfinished
+        long long maxIterations; // per thread, 0 = until the budget runs out
+        int maxNodes;           // per thread tree size; further iterations only roll out
+        float exploration;
+        std::uint64_t seed;
+
+        Config()
+            : budgetMs(50.0), threads(0), maxTurns(30), maxIterations(0), maxNodes(1 << 20),
+            exploration(0.7f), seed(0x5EED) {}
+    };
+
+    struct ActionStats {
+        int action;
+        long long visits;
+        double meanValue;
+    };
+
+    struct Result {
+        int action;             // spec id to play, END_TURN, or -1 if the battle is over
+        int handIndex;          // first hand slot holding the chosen card, -1 for END_TURN
+        long long rollouts;
+        double elapsedMs;
+        std::vector<ActionStats> actions; // root statistics, most visited first
+    };
+
+    MctsAgent() = default;
+    explicit MctsAgent(const Config& config) : config(config) {}
+
+    Result chooseAction(const CombatState& root, const CombatDeck& deck) const;
+
+    static void applyAction(CombatState& state, const CombatDeck& deck, int action) { state.applyAction(action, deck); }
+    // Score in [0, 1] used for backpropagation; wins always outrank losses.
+    static float evaluate(const CombatState& state);
+
+    const Config& getConfig() const { return config; }
+    void setConfig(const Config& newConfig) { config = newConfig; }
+
+private:
+    Config config;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,62 @@
+#ifndef REWARD_TABLE_H
+#define REWARD_TABLE_H
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "CardLibrary.h"
+
+// Walker's alias method (Vose's construction): O(n) to build, O(1) to sample
+// a fixed discrete distribution. A sample is two 32-bit draws and no floating
+// point, so a seed rolls the same on every platform.
+class AliasTable {
+public:
+    AliasTable() {}
+    // Entries with weight <= 0 are never drawn; an all-zero table is empty.
+    explicit AliasTable(const std::vector<double>& weights);
+
+    bool isEmpty() const { return threshold.empty(); }
+    int sample(std::mt19937& rng) const;
+
+private:
+    std::vector<std::uint64_t> threshold; // keep the column when the coin is below this, out of 2^32
+    std::vector<int> alias;
+};
+
+// Reward offers from precomputed alias tables: one over slot rarities per
+// reward tier, and one over the pool's cards per (tier, rarity). Rolling a slot
+// is two samples; a card already in the offer is re-rolled, which stays O(1)
+// expected as long as the tier has a few more cards than the offer has slots.
+class RewardTable {
+public:
+    static constexpr int TIER_COUNT = 2;
+    static constexpr int RARITY_COUNT = 3;
+
+    struct Config {
+        // Per tier, per getCardPool() index; missing entries weigh 1.
+        std::vector<double> cardWeights[TIER_COUNT];
+        // Per tier, odds of each slot rarity (Common, Rare, Epic).
+        double rarityWeights[TIER_COUNT][RARITY_COUNT];
+        int offerSize;
+
+        Config() : rarityWeights{ { 0.5, 0.5, 0.0 }, { 0.25, 0.25, 0.5 } }, offerSize(3) {}
+    };
+
+    explicit RewardTable(const Config& config = Config());
+
+    // Replaces `offer` with distinct indices into CardLibrary::getCardPool().
+    // Holds fewer than offerSize when the tier has fewer cards to give, or when
+    // weights are so lopsided that the rerolls run out.
+    void roll(RewardTier tier, std::mt19937& rng, std::vector<int>& offer) const;
+
+private:
+    static constexpr int MAX_REROLLS = 64;
+
+    AliasTable rarities[TIER_COUNT];
+    AliasTable cards[TIER_COUNT][RARITY_COUNT];
+    std::vector<int> members[TIER_COUNT][RARITY_COUNT]; // pool index of each alias column
+    int drawable[TIER_COUNT];                           // distinct cards a tier can offer
+    int offerSize;
+};
+
+#endif
\ No newline at end of file
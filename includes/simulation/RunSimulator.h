@@ -0,0 +1,89 @@
+#ifndef RUN_SIMULATOR_H
+#define RUN_SIMULATOR_H
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+#include "CardLibrary.h"
+#include "CombatState.h"
+#include "EventLog.h"
+#include "MapGraph.h"
+#include "RewardTable.h"
+
+// Decisions a headless run has to make. Policies are called from several worker
+// threads at once, so they must not keep mutable state of their own; use the rng.
+struct RunPolicy {
+    // Picks one of `available` (never empty).
+    using NodeChooser = std::function<int(const MapGraph& graph, const std::vector<int>& available,
+        const std::vector<CardSpec>& deck, std::mt19937& rng)>;
+    // Picks a position in `offer` (indices into CardLibrary::getCardPool()), or -1 to skip.
+    using RewardChooser = std::function<int(const std::vector<CardSpec>& deck, const std::vector<int>& offer,
+        std::mt19937& rng)>;
+    // Returns a CombatState action id.
+    using BattleChooser = std::function<int(const CombatState& state, const CombatDeck& deck)>;
+
+    NodeChooser chooseNode;
+    RewardChooser chooseReward;
+    BattleChooser chooseAction;
+
+    // Random path, random reward, greedy battles.
+    static RunPolicy defaults();
+    static int randomNode(const MapGraph& graph, const std::vector<int>& available, const std::vector<CardSpec>& deck, std::mt19937& rng);
+    static int randomReward(const std::vector<CardSpec>& deck, const std::vector<int>& offer, std::mt19937& rng);
+    static int skipReward(const std::vector<CardSpec>& deck, const std::vector<int>& offer, std::mt19937& rng);
+    // Highest damage-plus-effect per energy.
+    static int bestValueReward(const std::vector<CardSpec>& deck, const std::vector<int>& offer, std::mt19937& rng);
+};
+
+// Plays whole runs without SDL: walks the map graph, fights with the CombatState
+// rules, takes rewards through the policy and carries the growing deck forward the
+// way Game::addCardToDeck does. Runs are spread over worker threads; each run is
+// seeded from its index, so a report does not depend on the thread count.
+class RunSimulator {
+public:
+    struct Config {
+        StarterDeck deck;
+        std::vector<CardSpec> startingCards; // overrides `deck` when not empty
+        long long runs;
+        int threads;        // 0 = one per hardware thread
+        int maxTurns;       // a battle still going after this many turns counts as a stall
+        std::uint64_t seed;
+        RewardTable::Config rewards;
+        EventLog* events;   // every battle's plays and outcome, one buffer per worker; null for none
+
+        Config() : deck(StarterDeck::BALANCED), runs(10000), threads(0), maxTurns(50), seed(1), events(nullptr) {}
+    };
+
+    struct NodeStats {
+        long long entered;
+        long long deaths;   // includes stalls
+    };
+
+    struct Report {
+        long long runs;
+        long long wins;
+        long long deaths;
+        long long stalls;
+        std::vector<NodeStats> nodes;
+        double meanFinalDeckSize;
+        double elapsedMs;
+    };
+
+    RunSimulator(const MapGraph& graph, const RunPolicy& policy);
+
+    Report simulate(const Config& config) const;
+
+private:
+    enum class Outcome { Won, Died, Stalled };
+
+    MapGraph graph;
+    RunPolicy policy;
+
+    Outcome playRun(const std::vector<CardSpec>& startingDeck, const RewardTable& rewards, int maxTurns, std::uint64_t seed,
+        std::vector<NodeStats>& stats, size_t& deckSize, EventLog::Buffer* events) const;
+    bool fight(const MapNode& node, const std::vector<CardSpec>& deck, int maxTurns, std::uint64_t seed, bool& stalled,
+        EventLog::Buffer* events) const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,86 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <SDL.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Read side of assets.pack, the single file RoguelikeAssetPacker bakes from the
+// assets folder at build time. Card art is stored already decoded as RGBA32 rows,
+// so textures upload and mip levels filter straight out of the mapping with no
+// PNG inflate; fonts are stored as-is and opened from memory. The file is mapped once
+// and stays mapped for the life of the process.
+//
+// Layout: Header, then `entryCount` Entry records sorted by name, then the data,
+// each blob aligned to DATA_ALIGNMENT. Names are the asset paths the game already
+// uses ("assets/cards/strike_card.png"), lower-cased with forward slashes.
+//
+// Without a pack (or for a name it lacks) callers fall back to the loose files,
+// so development builds keep working from the assets folder. The data tables in
+// assets/data stay loose text: the SDL-free simulator reads them too.
+class AssetPack {
+public:
+    static constexpr char MAGIC[4] = { 'R', 'C', 'P', 'K' };
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr size_t NAME_SIZE = 64;
+    static constexpr std::uint64_t DATA_ALIGNMENT = 64;
+
+    enum class Kind : std::uint32_t { Texture = 1, File = 2 };
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t entryCount;
+        std::uint32_t reserved;
+    };
+
+    struct Entry {
+        char name[NAME_SIZE]; // NUL-terminated
+        Kind kind;
+        std::uint32_t width;  // Texture only
+        std::uint32_t height;
+        std::uint32_t pitch;
+        std::uint64_t offset; // from the start of the file
+        std::uint64_t size;
+    };
+    static_assert(sizeof(Header) == 16 && sizeof(Entry) == 96, "pack records are written as raw structs");
+
+    // Maps Constants::ASSET_PACK_PATH on first use; empty if there is none.
+    static const AssetPack& getDefault();
+
+    AssetPack();
+    ~AssetPack();
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    bool open(const std::string& path);
+    bool isOpen() const { return entries != nullptr; }
+
+    // Stored form of an asset path: lower case, forward slashes. False if it does
+    // not fit in NAME_SIZE.
+    static bool normalizeName(std::string_view path, char (&name)[NAME_SIZE]);
+
+    // Name lookup is case-insensitive, matching the Windows file system the game
+    // was first written against.
+    const Entry* find(std::string_view name) const;
+    // An RGBA32 surface over the mapped pixels, without a copy, or null if the pack
+    // lacks `name`. Read-only, as the mapping is. The caller frees it.
+    SDL_Surface* createSurface(std::string_view name) const;
+    // Read-only stream over a stored file, or null. The caller closes it.
+    SDL_RWops* openFile(std::string_view name) const;
+
+private:
+    const unsigned char* data;
+    size_t size;
+    const Entry* entries;
+    std::uint32_t entryCount;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+
+    void close();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,37 @@
+#ifndef ASSET_WATCHER_H
+#define ASSET_WATCHER_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// Development hot reload behind the ROGUECARDS_HOT_RELOAD build option: reports
+// files written in the watched folders so Game can swap in new card art and enemy
+// data between frames. On Linux this is inotify on a non-blocking descriptor, so
+// a poll with nothing pending is one read() that fails with EAGAIN. Elsewhere
+// watch() fails and the game runs as usual.
+class AssetWatcher {
+public:
+#ifdef ROGUECARDS_HOT_RELOAD
+    static constexpr bool ENABLED = true;
+#else
+    static constexpr bool ENABLED = false;
+#endif
+
+    AssetWatcher();
+    ~AssetWatcher();
+    AssetWatcher(const AssetWatcher&) = delete;
+    AssetWatcher& operator=(const AssetWatcher&) = delete;
+
+    // `directory` ends in '/', e.g. Constants::CARD_PATH. Not recursive.
+    bool watch(const std::string& directory);
+    // Appends the path of every file finished since the last poll, each once,
+    // e.g. "assets/cards/strike_card.png". Catches editors that save by renaming.
+    void poll(std::vector<std::string>& changed);
+
+private:
+    int fd;
+    std::vector<std::pair<int, std::string>> directories; // watch descriptor, path
+};
+
+#endif
\ No newline at end of file
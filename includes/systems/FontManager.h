@@ -0,0 +1,70 @@
+#ifndef FONT_MANAGER_H
+#define FONT_MANAGER_H
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <string>
+#include <map>
+#include <tuple>
+#include <iostream>
+#include "AssetPack.h"
+
+// Opens each (face, point size, DPI) combination once and keeps it for the
+// lifetime of the game. Fonts do not depend on the renderer, so a resolution
+// change only selects a different cached size instead of reopening the file.
+class FontManager {
+public:
+	FontManager() = default;
+	~FontManager() { clear(); }
+	FontManager(const FontManager&) = delete;
+	FontManager& operator=(const FontManager&) = delete;
+
+	TTF_Font* getFont(const std::string& path, int pointSize, unsigned int dpi) {
+		FontKey key{ path, pointSize, dpi };
+		auto it = fonts.find(key);
+		if (it != fonts.end()) {
+			return it->second;
+		}
+
+		// The pack's copy is mapped for the life of the process, so the font can
+		// keep reading from it.
+		TTF_Font* font = nullptr;
+		if (SDL_RWops* stream = AssetPack::getDefault().openFile(path)) {
+			font = TTF_OpenFontDPIRW(stream, 1, pointSize, dpi, dpi);
+		}
+		if (!font) {
+			font = TTF_OpenFontDPI(path.c_str(), pointSize, dpi, dpi);
+		}
+		if (!font) {
+			std::cerr << "Failed to load font " << path << " at " << pointSize << "pt/" << dpi << "dpi - TTF_Error: " << TTF_GetError() << std::endl;
+			return nullptr;
+		}
+
+		fonts[key] = font;
+		std::cout << "Loaded font " << path << " at " << pointSize << "pt/" << dpi << "dpi" << std::endl;
+		return font;
+	}
+
+	// Must run before TTF_Quit().
+	void clear() {
+		for (auto& entry : fonts) {
+			TTF_CloseFont(entry.second);
+		}
+		fonts.clear();
+	}
+
+private:
+	struct FontKey {
+		std::string path;
+		int pointSize;
+		unsigned int dpi;
+
+		bool operator<(const FontKey& other) const {
+			return std::tie(path, pointSize, dpi) < std::tie(other.path, other.pointSize, other.dpi);
+		}
+	};
+
+	std::map<FontKey, TTF_Font*> fonts;
+};
+
+#endif
\ No newline at end of file
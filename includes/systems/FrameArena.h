@@ -0,0 +1,66 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+// Scratch memory for one frame on the main thread. Labels, log lines and asset
+// paths built while handling a frame are bump-allocated from a fixed buffer
+// instead of the heap, and Game::render rewinds the buffer after presenting, so
+// nothing allocated here may outlive the frame (copy it into a std::string to
+// keep it). A frame that outgrows the buffer spills to the heap until the next
+// reset; spills are counted so CAPACITY can be tuned. Not for the simulation
+// thread.
+class FrameArena final : public std::pmr::memory_resource {
+public:
+    static constexpr size_t CAPACITY = 64 * 1024;
+
+    static FrameArena& get();
+
+    void reset();
+    size_t getUsed() const { return used; }
+    size_t getPeak() const { return peak; }
+    long long getSpills() const { return spills; }
+
+private:
+    std::unique_ptr<std::byte[]> buffer;
+    size_t used;
+    size_t peak;
+    long long spills;
+    std::pmr::monotonic_buffer_resource overflow;
+
+    FrameArena();
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {} // released by reset()
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// Append-only text in the frame arena, for the few places that format a label or
+// a path: `FrameText text; text << "Energy: " << energy;` then hand c_str() to
+// SDL_ttf before the frame ends.
+class FrameText {
+public:
+    FrameText();
+
+    FrameText& operator<<(std::string_view value) { text.append(value.data(), value.size()); return *this; }
+    FrameText& operator<<(const char* value) { return *this << std::string_view(value); }
+    FrameText& operator<<(const std::string& value) { return *this << std::string_view(value); }
+    FrameText& operator<<(char value) { text.push_back(value); return *this; }
+    FrameText& operator<<(int value) { return *this << static_cast<long long>(value); }
+    FrameText& operator<<(long long value);
+    // Fixed-point, e.g. fixed(12.345, 2) appends "12.35".
+    FrameText& fixed(double value, int precision);
+
+    const char* c_str() const { return text.c_str(); }
+    std::string_view view() const { return text; }
+    std::pmr::string& str() { return text; }
+
+private:
+    std::pmr::string text;
+};
+
+#endif
\ No newline at end of file
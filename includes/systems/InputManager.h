@@ -2,10 +2,35 @@
 #define INPUTMANAGER_H
 
 #include <SDL.h>
+#include <map>
+#include <vector>
 
+enum class InputAction { None, Back, Confirm, EndTurn, Undo, Redo, ToggleOverlay, StressTest };
+
+// One entry of the per-tick input batch. Pointer and window events keep their raw
+// SDL_Event; key presses bound to an action carry that action instead.
+struct InputEvent {
+	SDL_Event event;
+	InputAction action;
+};
+
+// Drains the SDL queue once per tick. Runs of mouse-motion events are coalesced
+// into one (latest position, summed relative motion), so a fast mouse produces a
+// single motion per frame however many the OS delivered.
 class InputManager {
 public:
-	void processInput(bool& isRunning);
+	InputManager();
+
+	void pollEvents();
+	const std::vector<InputEvent>& getEvents() const { return events; }
+	bool quitRequested() const { return quit; }
+
+	void bindKey(SDL_Keycode key, InputAction action) { keyBindings[key] = action; }
+
+private:
+	std::vector<InputEvent> events;
+	std::map<SDL_Keycode, InputAction> keyBindings;
+	bool quit;
 };
 
 #endif
\ No newline at end of file
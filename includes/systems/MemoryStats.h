@@ -0,0 +1,42 @@
+#ifndef MEMORY_STATS_H
+#define MEMORY_STATS_H
+
+#include <SDL.h>
+
+// Allocation counters behind the ROGUECARDS_MEMORY_STATS build option. That build
+// replaces the global operator new/delete and hands SDL counting allocators
+// through SDL_SetMemoryFunctions, so heap and SDL traffic (SDL_ttf surfaces,
+// texture pixels on the software renderer) can be told apart. Game reports the
+// numbers per frame in the F3 overlay and per scene when it shuts down.
+//
+// Textures are counted in every build: all creation and destruction goes through
+// the wrappers below, which cost one increment each.
+class MemoryStats {
+public:
+#ifdef ROGUECARDS_MEMORY_STATS
+    static constexpr bool ENABLED = true;
+#else
+    static constexpr bool ENABLED = false;
+#endif
+
+    struct Counters {
+        long long heapAllocations;   // operator new, any thread
+        long long heapBytes;
+        long long heapLiveBytes;
+        long long sdlAllocations;    // SDL_malloc, SDL_calloc and growing SDL_realloc calls
+        long long sdlBytes;
+        long long sdlLiveBytes;
+        long long texturesCreated;
+        long long liveTextures;
+    };
+
+    static Counters snapshot();
+    // Must run before SDL_Init; SDL refuses to switch allocators once it has allocated.
+    static void installSDLHooks();
+
+    static SDL_Texture* createTexture(SDL_Renderer* renderer, Uint32 format, int access, int width, int height);
+    static SDL_Texture* createTextureFromSurface(SDL_Renderer* renderer, SDL_Surface* surface);
+    static void destroyTexture(SDL_Texture* texture);
+};
+
+#endif
\ No newline at end of file
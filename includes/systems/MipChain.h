@@ -0,0 +1,48 @@
+#ifndef MIP_CHAIN_H
+#define MIP_CHAIN_H
+
+#include <SDL.h>
+#include <memory>
+#include <vector>
+
+// An image and its pre-filtered half-size copies, largest first, each its own
+// texture. Card art is drawn far below its source size (660x1029 art in a 100x150
+// hand slot), and SDL scales a single texture by sampling it, which aliases and
+// reads texels the result never shows. Drawing from select() instead starts at
+// most a factor of two above the target.
+//
+// Levels halve down to MIN_SIZE and are filtered with a 2x2 box weighted by
+// alpha, so transparent pixels do not darken the edges.
+class MipChain {
+public:
+    static constexpr int MIN_SIZE = 32;
+
+    // `image` is SDL_PIXELFORMAT_RGBA32; it is only read. Null on failure.
+    static std::shared_ptr<MipChain> create(SDL_Renderer* renderer, SDL_Surface* image);
+
+    MipChain() = default;
+    ~MipChain();
+    MipChain(const MipChain&) = delete;
+    MipChain& operator=(const MipChain&) = delete;
+
+    // Refilters every level from new pixels of the same size (hot reload).
+    bool update(SDL_Surface* image);
+
+    // The smallest level that covers a draw of width x height, else the largest.
+    SDL_Texture* select(int width, int height) const;
+    SDL_Texture* getBase() const { return levels.empty() ? nullptr : levels.front().texture; }
+    int getLevelCount() const { return static_cast<int>(levels.size()); }
+
+    // Halves an RGBA32 image; the last row or column of an odd size is dropped.
+    static void downsample(const Uint8* source, int sourceWidth, int sourceHeight, int sourcePitch, Uint8* destination);
+
+private:
+    struct Level {
+        SDL_Texture* texture;
+        int width;
+        int height;
+    };
+    std::vector<Level> levels;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef RENDER_STATS_H
+#define RENDER_STATS_H
+
+#include <SDL.h>
+
+// Counts what the scenes and widgets submit to the renderer each frame, for the
+// debug overlay and the stress test. SDL does not report its own batching, so a
+// draw call is every copy or rect handed to it, and a texture switch is a draw
+// whose texture differs from the previous draw's (rects count as no texture),
+// which is what ends a batch. Only the main thread draws, so no locking.
+class RenderStats {
+public:
+    struct Frame {
+        int drawCalls;
+        int textureSwitches;
+    };
+
+    static void beginFrame();
+    static const Frame& current() { return frame; }
+
+    static int copy(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect* destination);
+    static int fillRect(SDL_Renderer* renderer, const SDL_Rect* rect);
+    static int drawRect(SDL_Renderer* renderer, const SDL_Rect* rect);
+    static int drawLine(SDL_Renderer* renderer, int x1, int y1, int x2, int y2);
+
+private:
+    static Frame frame;
+    static SDL_Texture* lastTexture;
+
+    static void count(SDL_Texture* texture);
+};
+
+#endif
\ No newline at end of file
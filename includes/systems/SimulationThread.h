@@ -0,0 +1,39 @@
+#ifndef SIMULATION_THREAD_H
+#define SIMULATION_THREAD_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// A second core for work that does not fit in a frame: hint searches, deck
+// statistics, reward previews. Jobs run one at a time in posting order and must
+// not touch SDL or the scene that posted them; they hand results back through a
+// TripleBuffer the scene polls in update(). Rendering and anything creating
+// textures stays on the main thread, which owns the renderer.
+class SimulationThread {
+public:
+    using Job = std::function<void()>;
+
+    SimulationThread();
+    ~SimulationThread(); // drops pending jobs and waits for the running one
+
+    void post(Job job);
+    // Blocks until every job posted so far has finished. For tools that need a
+    // scene's background results before they look at it; the game never waits.
+    void waitIdle();
+
+private:
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::deque<Job> jobs;
+    bool busy;
+    bool stopping;
+
+    void run();
+};
+
+#endif
\ No newline at end of file
@@ -4,46 +4,109 @@
 #include <SDL.h>
 #include <SDL_image.h>
 #include <string>
+#include <string_view>
 #include <map>
 #include <memory>
 #include <iostream>
+#include "AssetPack.h"
+#include "MipChain.h"
 
 class TextureManager {
 public:
 	TextureManager() = default;
 	~TextureManager() = default;
 
-	std::shared_ptr<SDL_Texture> loadTexture(const std::string& path, SDL_Renderer* renderer) {
-		auto it = textures.find(path);
+	// Cached by path; a hit needs no allocation, so callers can build the path in
+	// the frame arena. A miss builds the mip chain from the asset pack's
+	// pre-decoded pixels when there is a pack and only decodes the PNG otherwise.
+	std::shared_ptr<MipChain> loadImage(std::string_view pathView, SDL_Renderer* renderer) {
+		auto it = textures.find(pathView);
 		if (it != textures.end()) {
 			return it->second;
 		}
 
-		SDL_Surface* surface = IMG_Load(path.c_str());
+		std::string path(pathView);
+		SDL_Surface* surface = AssetPack::getDefault().createSurface(path);
+		bool packed = surface != nullptr;
+		if (!packed) {
+			surface = decode(path);
+		}
 		if (!surface) {
-			std::cerr << "Failed to load image from " << path << " - IMG_Error: " << IMG_GetError() << std::endl;
 			return nullptr;
 		}
 
-		SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+		std::shared_ptr<MipChain> chain = MipChain::create(renderer, surface);
 		SDL_FreeSurface(surface);
-
-		if (!texture) {
-			std::cerr << "Failed to create texture from " << path << " - SDL_Error: " << SDL_GetError() << std::endl;
+		if (!chain) {
+			std::cerr << "Failed to create texture from " << path << std::endl;
 			return nullptr;
 		}
 
-		auto sharedTexture = std::shared_ptr<SDL_Texture>(texture, SDL_DestroyTexture);
-		textures[path] = sharedTexture;
-		std::cout << "Loaded texture from " << path << std::endl;
-		return sharedTexture;
+		textures[path] = chain;
+		if (!packed) {
+			std::cout << "Loaded texture from " << path << " with " << chain->getLevelCount() << " mip levels" << std::endl;
+		}
+		return chain;
+	}
+
+	// Hot reload: decodes the file at `path` into the mip chain already cached for
+	// it, so every card holding it draws the new art on its next frame. Art saved
+	// at a different size is scaled to the old one until the next start. False if
+	// the path is not cached here or the file cannot be read.
+	bool reloadTexture(const std::string& path) {
+		auto it = textures.find(path);
+		if (it == textures.end()) {
+			return false;
+		}
+		int width = 0;
+		int height = 0;
+		if (SDL_QueryTexture(it->second->getBase(), nullptr, nullptr, &width, &height) != 0) {
+			return false;
+		}
+
+		SDL_Surface* surface = decode(path);
+		if (surface && (surface->w != width || surface->h != height)) {
+			SDL_Surface* scaled = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+			if (scaled) {
+				SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+				SDL_BlitScaled(surface, nullptr, scaled, nullptr);
+				std::cout << path << " changed size; scaled to " << width << "x" << height << " until restart" << std::endl;
+			}
+			SDL_FreeSurface(surface);
+			surface = scaled;
+		}
+		bool updated = surface && it->second->update(surface);
+		if (surface) {
+			SDL_FreeSurface(surface);
+		}
+		if (!updated) {
+			std::cerr << "Failed to reload texture from " << path << std::endl;
+			return false;
+		}
+		std::cout << "Reloaded texture from " << path << std::endl;
+		return true;
 	}
 
 	void clear() {
 		textures.clear();
 	}
 private:
-	std::map<std::string, std::shared_ptr<SDL_Texture>> textures;
+	std::map<std::string, std::shared_ptr<MipChain>, std::less<>> textures;
+
+	// The loose PNG as RGBA32, the layout MipChain filters.
+	static SDL_Surface* decode(const std::string& path) {
+		SDL_Surface* loaded = IMG_Load(path.c_str());
+		if (!loaded) {
+			std::cerr << "Failed to load image from " << path << " - IMG_Error: " << IMG_GetError() << std::endl;
+			return nullptr;
+		}
+		SDL_Surface* surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+		SDL_FreeSurface(loaded);
+		if (!surface) {
+			std::cerr << "Failed to convert image from " << path << " - SDL_Error: " << SDL_GetError() << std::endl;
+		}
+		return surface;
+	}
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+
+// Single-producer, single-consumer hand-off of whole snapshots without locks.
+// The producer fills its back buffer and publishes it; the consumer swaps in the
+// newest published one whenever it likes. Neither side ever waits, and the
+// consumer skips snapshots it was too slow to see rather than queueing them.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : middle(1), writeIndex(0), readIndex(2) {}
+
+    // Producer side.
+    T& getWriteBuffer() { return buffers[writeIndex]; }
+    void publish() {
+        int previous = middle.exchange(writeIndex | FRESH, std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    // Consumer side: true if a newer snapshot than the current read buffer was taken.
+    bool update() {
+        if (!(middle.load(std::memory_order_acquire) & FRESH)) {
+            return false;
+        }
+        int previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        return true;
+    }
+    const T& getReadBuffer() const { return buffers[readIndex]; }
+
+private:
+    static constexpr int INDEX_MASK = 3;
+    static constexpr int FRESH = 4;
+
+    T buffers[3];
+    std::atomic<int> middle; // index of the buffer between the two sides, plus FRESH
+    int writeIndex;          // producer only
+    int readIndex;           // consumer only
+};
+
+#endif
\ No newline at end of file
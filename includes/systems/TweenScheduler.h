@@ -0,0 +1,52 @@
+#ifndef TWEEN_SCHEDULER_H
+#define TWEEN_SCHEDULER_H
+
+#include <SDL.h>
+#include <vector>
+
+enum class Easing { Linear, EaseOutCubic, EaseInOutQuad };
+
+// Time-driven float tweens. Active tweens live in one contiguous array that is
+// walked once per tick; finished tweens are swap-removed, so an idle scene costs
+// a single empty() check. Owners keep a Handle and read the current value.
+class TweenScheduler {
+public:
+    using Handle = Uint32;
+    static constexpr Handle INVALID_HANDLE = 0;
+
+    TweenScheduler();
+
+    Handle start(float from, float to, Uint32 durationMs, Easing easing = Easing::EaseOutCubic);
+    void cancel(Handle handle);
+    bool isActive(Handle handle) const;
+    // Value of an active tween, or `fallback` once the tween has finished.
+    float getValue(Handle handle, float fallback) const;
+
+    void update(Uint32 now);
+    bool isIdle() const { return tweens.empty(); }
+
+private:
+    struct Tween {
+        Handle handle;
+        float from;
+        float to;
+        float value;
+        Uint32 startTime;
+        Uint32 duration;
+        Easing easing;
+    };
+
+    static constexpr Uint32 NO_INDEX = 0xFFFFFFFF;
+
+    std::vector<Tween> tweens;
+    std::vector<Uint32> slotIndex;      // slot -> index into tweens
+    std::vector<Uint16> slotGeneration; // bumped when a slot is reused
+    std::vector<Uint32> freeSlots;
+    Uint32 currentTime;
+
+    static float ease(Easing easing, float t);
+    const Tween* find(Handle handle) const;
+    void remove(Uint32 index);
+};
+
+#endif
\ No newline at end of file
@@ -23,6 +23,7 @@ public:
     void setRenderer(SDL_Renderer* renderer);
     void updateText(const std::string& newLabel, TTF_Font* font, SDL_Renderer* renderer);
     void setPosition(int x, int y);
+    void setRect(const SDL_Rect& newRect);
 
 private:
     SDL_Rect rect;
@@ -7,16 +7,8 @@
 #include <iostream>
 #include <memory>
 #include "../systems/TextureManager.h"
-
-enum class CardEffectType { None, Armor, Heal, MultiStrike, Weaken, Poison, Thorns, Wet, Lightning, Ice };
-
-struct CardEffect {
-    CardEffectType type;
-    int value;
-    int count;
-
-    CardEffect(CardEffectType t = CardEffectType::None, int v = 0, int c = 0) : type(t), value(v), count(c) {}
-};
+#include "../systems/TweenScheduler.h"
+#include "CardEffect.h"
 
 class Card {
 public:
@@ -32,8 +24,13 @@ public:
     ~Card() = default;
 
     void render(SDL_Renderer* renderer, int playerEnergy, int windowWidth, int windowHeight);
-    void handleEvent(SDL_Event& e);
-    void loadImage(const std::string& path, SDL_Renderer* renderer, TextureManager& textureManager);
+    // `inside` is the scene's hit-test result for the pointer position of `e`.
+    void handleEvent(SDL_Event& e, bool inside);
+    void clearHover();
+    // Advances hover-to-magnify timing and pulls animated values from the scheduler.
+    void update(Uint32 now);
+    // Loads assets/cards/<name in lower case, spaces as underscores>_card.png.
+    void loadImage(SDL_Renderer* renderer, TextureManager& textureManager);
     void resetPosition();
 
     void setPosition(int x, int y) {
@@ -43,21 +40,36 @@ public:
         originalRect.y = y;
     }
 
+    // Moves the card's resting slot; a card being dragged keeps following the pointer.
+    // Animated when a tween scheduler is attached.
+    void setRect(const SDL_Rect& newRect);
+    // Moves the card to a rect immediately, e.g. to start a draw animation from the pile.
+    void placeAt(const SDL_Rect& newRect);
+    // Cards without a scheduler snap instead of animating.
+    void setTweenScheduler(TweenScheduler* scheduler) { tweens = scheduler; }
+    bool isMoving() const { return moveTween != TweenScheduler::INVALID_HANDLE; }
+
     void setRenderer(SDL_Renderer* renderer);
     void setFont(TTF_Font* font);
+    // Font used for the text while the card is magnified, so it is rasterized at
+    // the larger size instead of being stretched. Falls back to the regular font.
+    void setMagnifiedFont(TTF_Font* font);
+    // Hover magnifies on its own; this forces it, e.g. for the render stress test.
+    void setMagnified(bool magnified);
 
     SDL_Rect& getRect() { return rect; }
     SDL_Rect& getOriginalRect() {
         std::cout << "Modifying originalRect for card: " << name << "\n";
         return originalRect;
     }
-    std::string getName() const { return name; }
+    const std::string& getName() const { return name; }
     int getDamage() const { return damage; }
     int getEnergyCost() const { return energyCost; }
     CardEffect getEffect() const { return effect; }
 
     bool isDragging;
     bool getIsMagnified() const { return isMagnified; }
+    float getMagnification() const { return magnification; }
 
 private:
     SDL_Rect rect;
@@ -68,15 +80,25 @@ private:
     CardEffect effect;
     SDL_Renderer* renderer;
     TTF_Font* font;
+    TTF_Font* magnifiedFont;
     std::shared_ptr<SDL_Texture> textTexture;
-    std::shared_ptr<SDL_Texture> imageTexture;
+    std::shared_ptr<SDL_Texture> magnifiedTextTexture;
+    std::shared_ptr<MipChain> image; // drawn from the level closest to the card's size
     bool isHovered;
     Uint32 hoverStartTime;
     static const Uint32 HOVER_DELAY = 2000;
     bool isMagnified;
+    float magnification;
+    TweenScheduler* tweens;
+    TweenScheduler::Handle magnifyTween;
+    TweenScheduler::Handle moveTween;
+    SDL_Rect moveFrom;
     bool needsTextTextureUpdate; // Flag to defer text texture creation
+    bool needsMagnifiedTextUpdate;
 
     void createTextTexture(); // New method to create the text texture
+    void createMagnifiedTextTexture();
+    std::shared_ptr<SDL_Texture> renderText(TTF_Font* textFont, int wrapWidth) const;
 };
 
 #endif
\ No newline at end of file
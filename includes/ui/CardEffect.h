@@ -1,8 +1,6 @@
 #ifndef CARD_EFFECT_H
 #define CARD_EFFECT_H
 
-#include <string>
-
 enum class CardEffectType {
 	None,
 	Armor,
@@ -19,8 +17,8 @@ enum class CardEffectType {
 struct CardEffect {
 	CardEffectType type;
 	int value;
-	int count; 
-	CardEffect(CardEffectType t = CardEffectType::None, int v = 0, int c = 1) : type(t), value(v), count(c) {}
+	int count;
+	CardEffect(CardEffectType t = CardEffectType::None, int v = 0, int c = 0) : type(t), value(v), count(c) {}
 };
 
 #endif
\ No newline at end of file
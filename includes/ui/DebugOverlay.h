@@ -0,0 +1,36 @@
+#ifndef DEBUG_OVERLAY_H
+#define DEBUG_OVERLAY_H
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <string>
+#include <string_view>
+
+// Block of text drawn over the current scene (F3): frame time, draw calls and the
+// like. The texture is rebuilt only when the text changes, so keeping it on
+// screen costs one rect and one copy per frame.
+class DebugOverlay {
+public:
+    DebugOverlay();
+    ~DebugOverlay();
+    DebugOverlay(const DebugOverlay&) = delete;
+    DebugOverlay& operator=(const DebugOverlay&) = delete;
+
+    void setRenderer(SDL_Renderer* renderer);
+    void setFont(TTF_Font* font);
+    void setText(std::string_view text); // lines separated by '\n'
+    void render();
+
+private:
+    SDL_Renderer* renderer;
+    TTF_Font* font;
+    SDL_Texture* texture;
+    SDL_Rect rect;
+    std::string text;
+    bool needsTextureUpdate;
+
+    void createTexture();
+    void destroyTexture();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef HIT_GRID_H
+#define HIT_GRID_H
+
+#include <SDL.h>
+#include <vector>
+
+// Uniform grid over the window used to route pointer events to the topmost
+// element. Rebuilt only when a scene's layout or clickable set changes; a query
+// touches a single cell, so its cost does not grow with the element count.
+class HitGrid {
+public:
+    explicit HitGrid(int cellSize = 64);
+
+    // Starts a rebuild; call insert() for every element and then build().
+    void reset(int width, int height);
+    void insert(int id, const SDL_Rect& rect, int z = 0);
+    void build();
+
+    // Returns the id of the topmost element containing the point, or -1.
+    int query(int x, int y) const;
+    bool empty() const { return entries.empty(); }
+
+private:
+    struct Entry {
+        int id;
+        SDL_Rect rect;
+        int z;
+    };
+
+    int cellSize;
+    int columns;
+    int rows;
+    std::vector<Entry> entries;
+    std::vector<int> cellStart; // per cell offset into cellEntries, columns * rows + 1 values
+    std::vector<int> cellEntries;
+
+    bool cellRange(const SDL_Rect& rect, int& minColumn, int& minRow, int& maxColumn, int& maxRow) const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,91 @@
+#ifndef LAYOUT_H
+#define LAYOUT_H
+
+#include <SDL.h>
+#include <vector>
+#include "../common/Constants.h"
+
+// Places an element relative to the window. Offsets and sizes are given in
+// reference pixels (DEFAULT_WINDOW_WIDTH x DEFAULT_WINDOW_HEIGHT) and are scaled
+// uniformly; relativeWidth/relativeHeight add a fraction of the window size.
+struct LayoutAnchor {
+    float anchorX;
+    float anchorY;
+    float pivotX;
+    float pivotY;
+    int offsetX;
+    int offsetY;
+    int width;
+    int height;
+    float relativeWidth;
+    float relativeHeight;
+
+    LayoutAnchor(float ax = 0.0f, float ay = 0.0f, float px = 0.0f, float py = 0.0f,
+        int ox = 0, int oy = 0, int w = 0, int h = 0, float rw = 0.0f, float rh = 0.0f)
+        : anchorX(ax), anchorY(ay), pivotX(px), pivotY(py), offsetX(ox), offsetY(oy),
+        width(w), height(h), relativeWidth(rw), relativeHeight(rh) {}
+};
+
+enum class FlexDirection { Row, Column };
+
+// A line of equally sized items. The box anchor positions the whole line; its
+// size is derived from the item count, so the pivot decides the alignment.
+struct LayoutFlex {
+    LayoutAnchor box;
+    FlexDirection direction;
+    int itemWidth;
+    int itemHeight;
+    int spacing;
+
+    LayoutFlex(const LayoutAnchor& box, FlexDirection direction, int itemWidth, int itemHeight, int spacing)
+        : box(box), direction(direction), itemWidth(itemWidth), itemHeight(itemHeight), spacing(spacing) {}
+};
+
+// Computes rects once per window resize or content change and caches them.
+// Scenes call update() every frame; it only recomputes when something changed.
+class Layout {
+public:
+    explicit Layout(int referenceWidth = Constants::DEFAULT_WINDOW_WIDTH, int referenceHeight = Constants::DEFAULT_WINDOW_HEIGHT);
+
+    int addAnchor(const LayoutAnchor& anchor);
+    int addFlex(const LayoutFlex& flex, int itemCount);
+    void setItemCount(int flexId, int count);
+
+    // Returns true if the cached rects were recomputed.
+    bool update(int windowWidth, int windowHeight);
+    void invalidate() { dirty = true; }
+
+    const SDL_Rect& getRect(int anchorId) const { return anchorRects[anchorId]; }
+    const SDL_Rect& getItemRect(int flexId, int index) const { return flexes[flexId].rects[index]; }
+    int getItemCount(int flexId) const { return flexes[flexId].count; }
+
+    // Aligns content of the given size inside an anchor's rect using its pivot.
+    // For zero-sized anchors this places the content's pivot on the anchor point.
+    SDL_Rect placeContent(int anchorId, int contentWidth, int contentHeight) const;
+
+    float getScale() const { return scale; }
+    int scaled(int value) const { return static_cast<int>(value * scale); }
+
+private:
+    struct FlexEntry {
+        LayoutFlex spec;
+        int count;
+        std::vector<SDL_Rect> rects;
+    };
+
+    int referenceWidth;
+    int referenceHeight;
+    int windowWidth;
+    int windowHeight;
+    float scale;
+    bool dirty;
+
+    std::vector<LayoutAnchor> anchors;
+    std::vector<SDL_Rect> anchorRects;
+    std::vector<FlexEntry> flexes;
+
+    SDL_Rect resolve(const LayoutAnchor& anchor, int width, int height) const;
+    void computeFlex(FlexEntry& flex) const;
+};
+
+#endif
\ No newline at end of file
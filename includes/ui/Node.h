@@ -6,8 +6,7 @@
 #include <string>
 #include <functional>
 #include <vector>
-
-enum class NodeType { Fight, Reward };
+#include "../simulation/MapGraph.h"
 
 class Node {
 public:
@@ -19,6 +18,7 @@ public:
     bool handleEvent(SDL_Event& e);
     void setRenderer(SDL_Renderer* renderer);
     void setFont(TTF_Font* font); // New method
+    void setRect(const SDL_Rect& newRect);
 
     SDL_Rect rect;
     std::string label;
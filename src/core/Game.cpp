@@ -6,13 +6,22 @@
 #include "../includes/scenes/BattleScene.h"
 #include "../includes/scenes/RewardScene.h"
 #include "../includes/scenes/OptionsScene.h"
+#include "../includes/scenes/StressTestScene.h"
+#include "../includes/systems/RenderStats.h"
+#include "../includes/systems/FrameArena.h"
+#include "../includes/systems/MemoryStats.h"
+#include "../includes/simulation/MapGraph.h"
 #include <iostream>
-#include <random>
+#include <iomanip>
+#include <algorithm>
 
 Game::Game() : isRunning(false), window(nullptr), renderer(nullptr), font(nullptr),
 currentState(GameState::MENU), currentScene(nullptr), selectedDeckType(DeckType::DAMAGE),
 currentNodeIndex(0), isCleaned(false),
-windowWidth(Constants::DEFAULT_WINDOW_WIDTH), windowHeight(Constants::DEFAULT_WINDOW_HEIGHT), fullScreen(false) {
+windowWidth(Constants::DEFAULT_WINDOW_WIDTH), windowHeight(Constants::DEFAULT_WINDOW_HEIGHT), fullScreen(false),
+fontDpi(Constants::FONT_BASE_DPI), seeds(std::random_device{}()),
+overlayVisible(false), lastFrameStart(0), overlayUpdatedAt(0), frameTotals{}, overlayMemoryStart{},
+sceneMemory{}, sceneMemoryStart{} {
 }
 
 Game::~Game() {
@@ -20,6 +29,7 @@ Game::~Game() {
 }
 
 bool Game::init(const char* title, int width, int height) {
+    MemoryStats::installSDLHooks();
     if (SDL_Init(SDL_INIT_VIDEO) < 0) {
         std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
         return false;
@@ -45,30 +55,57 @@ bool Game::init(const char* title, int width, int height) {
         return false;
     }
 
-    font = TTF_OpenFont(Constants::FONT_PATH.c_str(), Constants::FONT_SIZE);
+    updateFont();
     if (!font) {
         std::cerr << "Failed to load font! TTF_Error: " << TTF_GetError() << std::endl;
         return false;
     }
-    std::cout << "Font 'assets/Arial.TTF' loaded successfully" << std::endl;
 
     initializeCards();
+    if (!MapGraph::createDefault().isValid()) {
+        std::cerr << "Failed to load enemy data from " << EnemyTable::DEFAULT_PATH << std::endl;
+        return false;
+    }
+    if (AssetWatcher::ENABLED) {
+        assetWatcher.watch(Constants::CARD_PATH);
+        assetWatcher.watch(Constants::ASSET_PATH + "data/");
+    }
+    // Playing without the log is fine; open() already said why it failed.
+    if (eventLog.open(Constants::EVENT_LOG_PATH)) {
+        events = std::make_unique<EventLog::Buffer>(eventLog);
+    }
 
     currentState = GameState::MENU;
     menuScene = std::make_unique<MenuScene>(renderer, font, this);
     currentScene = menuScene.get();
+    overlay.setRenderer(renderer);
+    overlay.setFont(font);
+    sceneMemoryStart = MemoryStats::snapshot();
+    sceneMemory[static_cast<int>(currentState)].visits = 1;
     isRunning = true;
     return true;
 }
 
-void Game::reloadFont() {
-    if (font) {
-        TTF_CloseFont(font);
-        font = nullptr;
+TTF_Font* Game::getFont(int pointSize) {
+    float scale = std::min(static_cast<float>(windowWidth) / Constants::DEFAULT_WINDOW_WIDTH,
+        static_cast<float>(windowHeight) / Constants::DEFAULT_WINDOW_HEIGHT);
+    int scaledSize = std::max(1, static_cast<int>(pointSize * scale + 0.5f));
+    return fontManager.getFont(Constants::FONT_PATH, scaledSize, fontDpi);
+}
+
+void Game::updateFont() {
+    // Rasterize at the output's pixel density so high-DPI back buffers get sharp
+    // glyphs; a regular window keeps the 72 DPI metrics the layout was designed with.
+    int outputWidth = windowWidth;
+    if (renderer) {
+        SDL_GetRendererOutputSize(renderer, &outputWidth, nullptr);
     }
-    font = TTF_OpenFont(Constants::FONT_PATH.c_str(), Constants::FONT_SIZE);
+    float density = windowWidth > 0 ? static_cast<float>(outputWidth) / windowWidth : 1.0f;
+    fontDpi = static_cast<unsigned int>(Constants::FONT_BASE_DPI * std::max(1.0f, density) + 0.5f);
+
+    font = getFont(Constants::FONT_SIZE);
     if (!font) {
-        std::cerr << "Failed to reload font! TTF_Error: " << TTF_GetError() << std::endl;
+        std::cerr << "Failed to select font! TTF_Error: " << TTF_GetError() << std::endl;
     }
 }
 
@@ -104,8 +141,12 @@ void Game::setResolution(int width, int height) {
         return;
     }
 
-    // Reload the font
-    reloadFont();
+    // Pick the cached font for the new resolution
+    updateFont();
+
+    // Reload textures in TextureManager before the scenes rebuild, since some copy pool cards
+    textureManager.clear();
+    initializeCards(); // Reload card textures with the new renderer
 
     // Update the renderer and font in all scenes
     if (menuScene) {
@@ -137,10 +178,12 @@ void Game::setResolution(int width, int height) {
         scene->setRenderer(renderer);
         scene->setFont(font);
     }
-
-    // Reload textures in TextureManager
-    textureManager.clear();
-    initializeCards(); // Reload card textures with the new renderer
+    if (stressTestScene) {
+        stressTestScene->setRenderer(renderer);
+        stressTestScene->setFont(font);
+    }
+    overlay.setRenderer(renderer);
+    overlay.setFont(font);
 }
 
 void Game::setFullScreen(bool fullScreen) {
@@ -149,12 +192,25 @@ void Game::setFullScreen(bool fullScreen) {
 }
 
 void Game::handleEvents() {
-    SDL_Event e;
-    while (SDL_PollEvent(&e)) {
-        if (e.type == SDL_QUIT) {
-            isRunning = false;
+    input.pollEvents();
+    if (input.quitRequested()) {
+        isRunning = false;
+    }
+    for (const InputEvent& inputEvent : input.getEvents()) {
+        if (!currentScene) {
+            break;
+        }
+        if (inputEvent.action == InputAction::ToggleOverlay) {
+            overlayVisible = !overlayVisible;
+            lastFrameStart = 0;
+            frameTotals = FrameTotals{};
+            overlayMemoryStart = MemoryStats::snapshot();
         }
-        if (currentScene) {
+        else if (inputEvent.action != InputAction::None) {
+            currentScene->handleAction(inputEvent.action);
+        }
+        else {
+            SDL_Event e = inputEvent.event;
             currentScene->handleEvent(e);
         }
     }
@@ -175,10 +231,102 @@ void Game::handleEvents() {
     }
 }
 
+void Game::update() {
+    update(SDL_GetTicks());
+}
+
+void Game::update(Uint32 now) {
+    if (AssetWatcher::ENABLED) {
+        applyAssetChanges();
+    }
+    tweens.update(now);
+    if (currentScene) {
+        currentScene->update(now);
+    }
+}
+
 void Game::render() {
     if (currentScene) {
+        RenderStats::beginFrame();
+        Uint64 start = SDL_GetPerformanceCounter();
         currentScene->render();
+        if (overlayVisible) {
+            updateOverlay(start, SDL_GetPerformanceCounter());
+            overlay.render();
+        }
+        SDL_RenderPresent(renderer);
+        ++sceneMemory[static_cast<int>(currentState)].frames;
+    }
+    FrameArena::get().reset();
+}
+
+void Game::applyAssetChanges() {
+    changedAssets.clear();
+    assetWatcher.poll(changedAssets);
+    for (const std::string& path : changedAssets) {
+        if (path == EnemyTable::DEFAULT_PATH) {
+            // Fights started from now on use the new numbers; the current one keeps its own.
+            if (EnemyTable::reloadDefault() && gameScene) {
+                gameScene->discardPrewarmed();
+            }
+        }
+        else if (path.size() > Constants::CARD_SUFFIX.size() &&
+            path.compare(path.size() - Constants::CARD_SUFFIX.size(), std::string::npos, Constants::CARD_SUFFIX) == 0) {
+            // Pool cards and the scenes that copy them share this cache; a battle has its own.
+            textureManager.reloadTexture(path);
+            if (battleScene) {
+                battleScene->reloadTexture(path);
+            }
+            if (gameScene) {
+                gameScene->discardPrewarmed(); // prebuilt battles have their own caches
+            }
+        }
+    }
+}
+
+void Game::updateOverlay(Uint64 frameStart, Uint64 renderEnd) {
+    double ticksPerMs = SDL_GetPerformanceFrequency() / 1000.0;
+    if (lastFrameStart != 0) {
+        const RenderStats::Frame& counts = RenderStats::current();
+        ++frameTotals.frames;
+        frameTotals.frameMs += (frameStart - lastFrameStart) / ticksPerMs;
+        frameTotals.renderMs += (renderEnd - frameStart) / ticksPerMs;
+        frameTotals.drawCalls += counts.drawCalls;
+        frameTotals.textureSwitches += counts.textureSwitches;
+    }
+    lastFrameStart = frameStart;
+
+    Uint32 now = SDL_GetTicks();
+    if (frameTotals.frames == 0 || now - overlayUpdatedAt < Constants::OVERLAY_REFRESH_MS) {
+        return;
     }
+    double frames = frameTotals.frames;
+    double frameMs = frameTotals.frameMs / frames;
+    FrameText text;
+    text << "Frame ";
+    text.fixed(frameMs, 2) << " ms (";
+    text.fixed(frameMs > 0.0 ? 1000.0 / frameMs : 0.0, 0) << " fps)\nScene render ";
+    text.fixed(frameTotals.renderMs / frames, 2) << " ms\nDraw calls ";
+    text.fixed(frameTotals.drawCalls / frames, 0) << "\nTexture switches ";
+    text.fixed(frameTotals.textureSwitches / frames, 0);
+
+    MemoryStats::Counters memory = MemoryStats::snapshot();
+    const MemoryStats::Counters& start = overlayMemoryStart;
+    if (MemoryStats::ENABLED) {
+        text << "\nHeap ";
+        text.fixed((memory.heapAllocations - start.heapAllocations) / frames, 1) << " allocs, ";
+        text.fixed((memory.heapBytes - start.heapBytes) / frames / 1024.0, 1) << " KB per frame, ";
+        text.fixed(memory.heapLiveBytes / 1024.0, 0) << " KB live\nSDL ";
+        text.fixed((memory.sdlAllocations - start.sdlAllocations) / frames, 1) << " allocs, ";
+        text.fixed((memory.sdlBytes - start.sdlBytes) / frames / 1024.0, 1) << " KB per frame, ";
+        text.fixed(memory.sdlLiveBytes / 1024.0, 0) << " KB live";
+    }
+    text << "\nTextures " << memory.liveTextures << " live, ";
+    text.fixed((memory.texturesCreated - start.texturesCreated) / frames, 2) << " created per frame";
+    overlayMemoryStart = memory;
+    overlay.setText(text.view());
+    overlayUpdatedAt = now;
+    frameTotals = FrameTotals{};
 }
 
 void Game::clean() {
@@ -186,6 +334,12 @@ void Game::clean() {
         return;
     }
 
+    if (MemoryStats::ENABLED) {
+        recordSceneMemory();
+        printMemorySummary();
+    }
+    events.reset(); // writes the last partial chunk
+
     if (renderer) {
         SDL_DestroyRenderer(renderer);
         renderer = nullptr;
@@ -195,10 +349,8 @@ void Game::clean() {
         window = nullptr;
     }
 
-    if (font) {
-        TTF_CloseFont(font);
-        font = nullptr;
-    }
+    font = nullptr;
+    fontManager.clear();
     TTF_Quit();
 
     IMG_Quit();
@@ -208,7 +360,9 @@ void Game::clean() {
 }
 
 void Game::setState(GameState newState) {
+    recordSceneMemory();
     currentState = newState;
+    ++sceneMemory[static_cast<int>(currentState)].visits;
     if (currentState == GameState::MENU) {
         menuScene = std::make_unique<MenuScene>(renderer, font, this);
         currentScene = menuScene.get();
@@ -217,6 +371,7 @@ void Game::setState(GameState newState) {
         battleScene.reset();
         rewardScene.reset();
         optionsScene.reset();
+        stressTestScene.reset();
         completedNodes.clear();
     }
     else if (currentState == GameState::DECK_SELECTION) {
@@ -253,6 +408,16 @@ void Game::setState(GameState newState) {
         battleScene.reset();
         optionsScene.reset();
     }
+    else if (currentState == GameState::STRESS_TEST) {
+        stressTestScene = std::make_unique<StressTestScene>(renderer, font, this);
+        currentScene = stressTestScene.get();
+        menuScene.reset();
+        deckSelectionScene.reset();
+        gameScene.reset();
+        battleScene.reset();
+        rewardScene.reset();
+        optionsScene.reset();
+    }
     else if (currentState == GameState::OPTIONS) {
         optionsScene = std::make_unique<OptionsScene>(renderer, font, this);
         currentScene = optionsScene.get();
@@ -267,40 +432,58 @@ void Game::setState(GameState newState) {
 void Game::selectDeck(DeckType deck) {
     selectedDeckType = deck;
     selectedDeck.clear();
-    if (deck == DeckType::DAMAGE) {
-        selectedDeck.emplace_back(0, 0, "Slash", 8, 2, renderer, font);
-        selectedDeck.emplace_back(0, 0, "Strike", 5, 1, renderer, font);
-        selectedDeck.emplace_back(0, 0, "Block", 0, 1, renderer, font, CardEffect(CardEffectType::Armor, 5));
-        selectedDeck.emplace_back(0, 0, "Block", 0, 1, renderer, font, CardEffect(CardEffectType::Armor, 5));
-    }
-    else if (deck == DeckType::BALANCED) {
-        selectedDeck.emplace_back(0, 0, "Strike", 5, 1, renderer, font);
-        selectedDeck.emplace_back(0, 0, "Block", 0, 1, renderer, font, CardEffect(CardEffectType::Armor, 5));
-        selectedDeck.emplace_back(0, 0, "Water Gun", 1, 1, renderer, font, CardEffect(CardEffectType::Wet, 0, 2));
-        selectedDeck.emplace_back(0, 0, "Lightning Strike", 6, 3, renderer, font, CardEffect(CardEffectType::Lightning, 6));
-        selectedDeck.emplace_back(0, 0, "Ice Shard", 4, 2, renderer, font, CardEffect(CardEffectType::Ice, 4, 1));
-    }
-    else if (deck == DeckType::ELEMENTAL) {
-        selectedDeck.emplace_back(0, 0, "Water Gun", 0, 1, renderer, font, CardEffect(CardEffectType::Wet, 0, 2));
-        selectedDeck.emplace_back(0, 0, "Lightning Strike", 6, 3, renderer, font, CardEffect(CardEffectType::Lightning, 6));
-        selectedDeck.emplace_back(0, 0, "Ice Shard", 4, 2, renderer, font, CardEffect(CardEffectType::Ice, 4, 1));
-        selectedDeck.emplace_back(0, 0, "Heal", 0, 2, renderer, font, CardEffect(CardEffectType::Heal, 5));
-        selectedDeck.emplace_back(0, 0, "Water Gun", 1, 1, renderer, font, CardEffect(CardEffectType::Wet, 0, 2));
-    }
-    else if (deck == DeckType::DEFENSE) {
-        selectedDeck.emplace_back(0, 0, "Block", 0, 1, renderer, font, CardEffect(CardEffectType::Armor, 5));
-        selectedDeck.emplace_back(0, 0, "Superb Shield", 0, 2, renderer, font, CardEffect(CardEffectType::Armor, 10));
-        selectedDeck.emplace_back(0, 0, "Heal", 0, 2, renderer, font, CardEffect(CardEffectType::Heal, 5));
-        selectedDeck.emplace_back(0, 0, "Thorns", 0, 1, renderer, font, CardEffect(CardEffectType::Thorns));
-        selectedDeck.emplace_back(0, 0, "Thorns", 0, 1, renderer, font, CardEffect(CardEffectType::Thorns));
+    for (const CardSpec& spec : CardLibrary::getStarterDeck(deck)) {
+        selectedDeck.emplace_back(0, 0, spec.name, spec.damage, spec.energyCost, renderer, font, spec.effect);
     }
 }
 
-void Game::startBattle(const std::string& enemyName, int enemyHP, int enemyDamage) {
-    Enemy enemy(enemyName, enemyHP, enemyDamage);
-    battleScene = std::make_unique<BattleScene>(renderer, font, enemy, this);
+void Game::startBattle(int encounter) {
+    recordSceneMemory();
+    currentState = GameState::BATTLE;
+    ++sceneMemory[static_cast<int>(currentState)].visits;
+    battleScene = std::make_unique<BattleScene>(renderer, font, encounter, this);
     currentScene = battleScene.get();
+}
+
+void Game::startBattle(std::unique_ptr<Scene> scene) {
+    recordSceneMemory();
     currentState = GameState::BATTLE;
+    ++sceneMemory[static_cast<int>(currentState)].visits;
+    battleScene = std::move(scene);
+    currentScene = battleScene.get();
+}
+
+void Game::recordSceneMemory() {
+    MemoryStats::Counters now = MemoryStats::snapshot();
+    SceneMemory& scene = sceneMemory[static_cast<int>(currentState)];
+    scene.heapAllocations += now.heapAllocations - sceneMemoryStart.heapAllocations;
+    scene.heapBytes += now.heapBytes - sceneMemoryStart.heapBytes;
+    scene.sdlAllocations += now.sdlAllocations - sceneMemoryStart.sdlAllocations;
+    scene.sdlBytes += now.sdlBytes - sceneMemoryStart.sdlBytes;
+    scene.texturesCreated += now.texturesCreated - sceneMemoryStart.texturesCreated;
+    sceneMemoryStart = now;
+}
+
+void Game::printMemorySummary() const {
+    static const char* const names[STATE_COUNT] = { "Menu", "Deck selection", "Map", "Battle", "Reward", "Options", "Stress test" };
+    std::cout << "\nMemory by scene (allocations include building the scene)\n"
+        << std::left << std::setw(16) << "Scene" << std::right << std::setw(8) << "visits" << std::setw(9) << "frames"
+        << std::setw(13) << "heap allocs" << std::setw(11) << "heap KB" << std::setw(12) << "per frame"
+        << std::setw(12) << "SDL allocs" << std::setw(10) << "SDL KB" << std::setw(10) << "textures" << "\n";
+    for (int i = 0; i < STATE_COUNT; ++i) {
+        const SceneMemory& scene = sceneMemory[i];
+        if (scene.visits == 0) {
+            continue;
+        }
+        double perFrame = scene.frames > 0 ? static_cast<double>(scene.heapAllocations) / scene.frames : 0.0;
+        std::cout << std::left << std::setw(16) << names[i] << std::right << std::setw(8) << scene.visits
+            << std::setw(9) << scene.frames << std::setw(13) << scene.heapAllocations << std::setw(11) << scene.heapBytes / 1024
+            << std::setw(12) << std::fixed << std::setprecision(1) << perFrame << std::setw(12) << scene.sdlAllocations
+            << std::setw(10) << scene.sdlBytes / 1024 << std::setw(10) << scene.texturesCreated << "\n";
+    }
+    MemoryStats::Counters now = MemoryStats::snapshot();
+    std::cout << "Live at exit: " << now.heapLiveBytes / 1024 << " KB heap, " << now.sdlLiveBytes / 1024 << " KB SDL, "
+        << now.liveTextures << " textures\n";
 }
 
 void Game::endBattle(bool won) {
@@ -326,73 +509,18 @@ void Game::addCardToDeck(const Card& card) {
     std::cout << "Added " << card.getName() << " to the deck. New deck size: " << selectedDeck.size() << "\n";
 }
 
-std::vector<Card> Game::getRewardCards(CardRarity maxRarity, int count) {
-    std::vector<Card> rewards;
-    std::vector<Card> possibleCards;
-
-    for (const auto& card : allCards) {
-        CardRarity cardRarity = CardRarity::Common;
-        std::string name = card.getName();
-        if (name == "Lightning Strike" || name == "Ice Shard" || name == "Superb Shield") {
-            cardRarity = CardRarity::Rare;
-        }
-        else if (name == "Dragon's Breath") {
-            cardRarity = CardRarity::Epic;
-        }
-
-        if (static_cast<int>(cardRarity) <= static_cast<int>(maxRarity)) {
-            possibleCards.push_back(card);
-        }
-    }
-
-    if (possibleCards.empty()) {
-        std::cerr << "No cards available for max rarity " << static_cast<int>(maxRarity) << "\n";
-        return rewards;
-    }
-
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::shuffle(possibleCards.begin(), possibleCards.end(), g);
-
-    int numRewards = std::min(count, static_cast<int>(possibleCards.size()));
-    for (int i = 0; i < numRewards; ++i) {
-        rewards.push_back(possibleCards[i]);
-    }
-
-    return rewards;
-}
-
 void Game::initializeCards() {
     allCards.clear();
-    allCards.emplace_back(0, 0, "Slash", 8, 2, renderer, font);
-    allCards.emplace_back(0, 0, "Strike", 5, 1, renderer, font);
-    allCards.emplace_back(0, 0, "Block", 0, 1, renderer, font, CardEffect(CardEffectType::Armor, 5));
-    allCards.emplace_back(0, 0, "Water Gun", 1, 1, renderer, font, CardEffect(CardEffectType::Wet, 0, 2));
-    allCards.emplace_back(0, 0, "Lightning Strike", 6, 3, renderer, font, CardEffect(CardEffectType::Lightning, 6));
-    allCards.emplace_back(0, 0, "Ice Shard", 4, 2, renderer, font, CardEffect(CardEffectType::Ice, 4, 1));
-    allCards.emplace_back(0, 0, "Heal", 0, 2, renderer, font, CardEffect(CardEffectType::Heal, 5));
-    allCards.emplace_back(0, 0, "Superb Shield", 0, 2, renderer, font, CardEffect(CardEffectType::Armor, 10));
-    allCards.emplace_back(0, 0, "Thorns", 0, 1, renderer, font, CardEffect(CardEffectType::Thorns));
-    allCards.emplace_back(0, 0, "Dragon's Breath", 10, 3, renderer, font);
+    for (const CardSpec& spec : CardLibrary::getCardPool()) {
+        allCards.emplace_back(0, 0, spec.name, spec.damage, spec.energyCost, renderer, font, spec.effect);
+    }
 
     for (auto& card : allCards) {
-        std::string lowercaseName = card.getName();
-        for (char& c : lowercaseName) {
-            c = std::tolower(c);
-        }
-        std::replace(lowercaseName.begin(), lowercaseName.end(), ' ', '_');
-        std::string imagePath = Constants::CARD_PATH + lowercaseName + Constants::CARD_SUFFIX;
-        card.loadImage(imagePath, renderer, textureManager);
+        card.loadImage(renderer, textureManager);
     }
 
     // Reload selectedDeck cards with the new renderer
     for (auto& card : selectedDeck) {
-        std::string lowercaseName = card.getName();
-        for (char& c : lowercaseName) {
-            c = std::tolower(c);
-        }
-        std::replace(lowercaseName.begin(), lowercaseName.end(), ' ', '_');
-        std::string imagePath = Constants::CARD_PATH + lowercaseName + Constants::CARD_SUFFIX;
-        card.loadImage(imagePath, renderer, textureManager);
+        card.loadImage(renderer, textureManager);
     }
 }
\ No newline at end of file
@@ -10,6 +10,7 @@ int main(int argc, char* argv[]) {
 
     while (game.running()) {
         game.handleEvents();
+        game.update();
         game.render();
         SDL_Delay(16);
     }
@@ -1,44 +1,121 @@
 #include "../includes/scenes/BattleScene.h"
 #include "../includes/common/Constants.h"
 #include "../includes/core/Game.h"
+#include "../includes/simulation/MctsAgent.h"
+#include "../includes/simulation/EnemyTable.h"
+#include "../includes/systems/RenderStats.h"
+#include "../includes/systems/FrameArena.h"
+#include "../includes/systems/MemoryStats.h"
 #include <iostream>
 #include <algorithm>
-#include <random>
-#include <sstream>
-
-BattleScene::BattleScene(SDL_Renderer* renderer, TTF_Font* font, const Enemy& e, Game* game)
-    : renderer(renderer), font(font), game(game), enemy(e), enemyHPText(nullptr),
-    playerHP(20), playerHPText(nullptr), playerArmor(0), armorText(nullptr),
-    battleWon(false), playerDefeated(false),
-    continueButton(350, 400, 100, 50, "Continue", font, renderer, [this]() { this->game->endBattle(true); }),
-    boardRect{ 300, 150, 200, 200 }, playerEnergy(3), maxEnergy(3), energyText(nullptr),
-    skipTurnButton(350, 500, 100, 50, "Skip Turn", font, renderer, [this]() { this->endTurn(); }) {
-    hand.reserve(5);
-    drawPile.reserve(7);
+#include <thread>
+
+BattleScene::BattleScene(SDL_Renderer* renderer, TTF_Font* font, int encounter, Game* game)
+    : renderer(renderer), font(font), game(game),
+    enemyName(EnemyTable::getDefault().getEncounter(encounter).name),
+    encounterId(EnemyTable::getDefault().getEncounter(encounter).id), loggedStart(false), loggedEnd(false),
+    enemyHPText(nullptr), intentText(nullptr),
+    playerHPText(nullptr), armorText(nullptr),
+    battleWon(false), playerDefeated(false), readyToEnd(false),
+    continueButton(0, 0, 100, 50, "Continue", font, renderer, [this]() { this->game->endBattle(true); }),
+    boardRect{ 0, 0, 0, 0 }, energyText(nullptr),
+    skipTurnButton(0, 0, 100, 50, "Skip Turn", font, renderer, [this]() { this->endTurn(); }),
+    hintButton(0, 0, 100, 50, "Hint", font, renderer, [this]() { this->showHint(); }),
+    undoButton(0, 0, 100, 50, "Undo", font, renderer, [this]() { this->undo(); }),
+    redoButton(0, 0, 100, 50, "Redo", font, renderer, [this]() { this->redo(); }),
+    playerTextRect{ 0, 0, 0, 0 }, playerText(nullptr), enemyTextRect{ 0, 0, 0, 0 }, enemyText(nullptr),
+    enemyHPRect{ 0, 0, 0, 0 }, intentRect{ 0, 0, 0, 0 }, playerHPRect{ 0, 0, 0, 0 }, armorRect{ 0, 0, 0, 0 }, energyRect{ 0, 0, 0, 0 },
+    previewText(nullptr), previewRect{ 0, 0, 0, 0 }, previewIndex(-1),
+    boardAnchor(layout.addAnchor(LayoutAnchor(0.5f, 0.0f, 0.5f, 0.0f, 0, 150, 200, 200))),
+    enemyHPAnchor(layout.addAnchor(LayoutAnchor(0.5f, 0.0f, 0.5f, 0.5f, -50, 100))),
+    intentAnchor(layout.addAnchor(LayoutAnchor(0.5f, 0.0f, 0.5f, 0.5f, -50, 70))),
+    playerHPAnchor(layout.addAnchor(LayoutAnchor(0.0f, 0.0f, 0.0f, 0.0f, 50, 50))),
+    armorAnchor(layout.addAnchor(LayoutAnchor(0.0f, 0.0f, 0.0f, 0.0f, 50, 80))),
+    energyAnchor(layout.addAnchor(LayoutAnchor(0.0f, 0.0f, 0.0f, 0.0f, 50, 110))),
+    enemyTextAnchor(layout.addAnchor(LayoutAnchor(0.0f, 0.0f, 0.0f, 0.0f, 50, 50))),
+    playerTextAnchor(layout.addAnchor(LayoutAnchor(0.0f, 1.0f, 0.0f, 0.0f, 50, -50))),
+    continueAnchor(layout.addAnchor(LayoutAnchor(0.5f, 0.0f, 0.5f, 0.0f, 0, 400, 100, 50))),
+    skipTurnAnchor(layout.addAnchor(LayoutAnchor(0.5f, 0.0f, 0.5f, 0.0f, 0, 500, 100, 50))),
+    hintAnchor(layout.addAnchor(LayoutAnchor(0.5f, 0.0f, 0.5f, 0.0f, 120, 500, 100, 50))),
+    undoAnchor(layout.addAnchor(LayoutAnchor(0.5f, 0.0f, 0.5f, 0.0f, -240, 500, 100, 50))),
+    redoAnchor(layout.addAnchor(LayoutAnchor(0.5f, 0.0f, 0.5f, 0.0f, -120, 500, 100, 50))),
+    previewAnchor(layout.addAnchor(LayoutAnchor(0.5f, 0.0f, 0.5f, 0.0f, 0, 360))),
+    drawPileAnchor(layout.addAnchor(LayoutAnchor(0.0f, 1.0f, 1.0f, 1.0f, 0, 0, 100, 150))),
+    discardPileAnchor(layout.addAnchor(LayoutAnchor(1.0f, 1.0f, 0.0f, 1.0f, 0, 0, 100, 150))),
+    handRow(layout.addFlex(LayoutFlex(LayoutAnchor(0.5f, 1.0f, 0.0f, 1.0f, -240, 0), FlexDirection::Row, 100, 150, 10), 0)),
+    hoveredIndex(-1), draggingIndex(-1), hintIndex(-1), hintEndTurn(false), hintRequest(0),
+    hintResults(std::make_shared<TripleBuffer<HintResult>>()) {
+    TTF_Font* magnifiedFont = game->getFont(static_cast<int>(Constants::FONT_SIZE * Constants::CARD_MAGNIFICATION_SCALE));
     const std::vector<Card>& selectedDeck = game->getSelectedDeck();
     std::cout << "Selected deck size: " << selectedDeck.size() << "\n";
     for (const Card& card : selectedDeck) {
+        int spec = combatDeck.addCard(CardSpec(card.getName(), card.getDamage(), card.getEnergyCost(), card.getEffect()));
+        if (spec < static_cast<int>(specCards.size())) {
+            continue;
+        }
         Card newCard(0, 0, card.getName(), card.getDamage(), card.getEnergyCost(), renderer, font, card.getEffect());
-        std::string imagePath = Constants::CARD_PATH + card.getName() + Constants::CARD_SUFFIX;
-        std::replace(imagePath.begin(), imagePath.end(), ' ', '_');
-        std::transform(imagePath.begin(), imagePath.end(), imagePath.begin(), ::tolower);
-        newCard.loadImage(imagePath, renderer, textureManager);
-        drawPile.push_back(std::move(newCard));
+        newCard.setMagnifiedFont(magnifiedFont);
+        newCard.setTweenScheduler(&game->getTweens());
+        reloadCardImage(newCard);
+        specCards.push_back(std::move(newCard));
     }
-    std::cout << "drawPile size after population: " << drawPile.size() << "\n";
 
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::shuffle(drawPile.begin(), drawPile.end(), g);
-    std::cout << "drawPile shuffled\n";
+    const EncounterDef& enemy = EnemyTable::getDefault().getEncounter(encounter);
+    state = CombatState::begin(combatDeck, enemy.hp, enemy.damage, game->nextSeed());
+    state.resistances = enemy.resistances;
+    state.setBehavior(&enemy.behavior);
+    history.reset(state);
+    std::cout << "Draw pile holds " << static_cast<int>(state.drawCount) << " cards after the opening hand\n";
 
+    refreshLayout();
     updateHPText();
+    updateIntentText();
     updatePlayerHPText();
     updateArmorText();
     updateEnergyText();
-    for (int i = 0; i < 3 && !drawPile.empty(); ++i) {
-        drawCard();
+    syncHand(false);
+}
+
+BattleScene::~BattleScene() {
+    for (SDL_Texture* texture : { enemyHPText, intentText, playerHPText, armorText, energyText, playerText, enemyText, previewText }) {
+        if (texture) MemoryStats::destroyTexture(texture);
+    }
+    clearDamageNumbers();
+}
+
+void BattleScene::refreshLayout() {
+    if (!layout.update(game->getWindowWidth(), game->getWindowHeight())) {
+        return;
     }
+    boardRect = layout.getRect(boardAnchor);
+    continueButton.setRect(layout.getRect(continueAnchor));
+    skipTurnButton.setRect(layout.getRect(skipTurnAnchor));
+    hintButton.setRect(layout.getRect(hintAnchor));
+    undoButton.setRect(layout.getRect(undoAnchor));
+    redoButton.setRect(layout.getRect(redoAnchor));
+    handHitGrid.reset(game->getWindowWidth(), game->getWindowHeight());
+    for (size_t i = 0; i < hand.size() && static_cast<int>(i) < layout.getItemCount(handRow); ++i) {
+        const SDL_Rect& slot = layout.getItemRect(handRow, static_cast<int>(i));
+        hand[i].setRect(slot);
+        handHitGrid.insert(static_cast<int>(i), slot, static_cast<int>(i));
+    }
+    handHitGrid.build();
+    enemyHPRect = placeText(enemyHPAnchor, enemyHPText);
+    intentRect = placeText(intentAnchor, intentText);
+    playerHPRect = placeText(playerHPAnchor, playerHPText);
+    armorRect = placeText(armorAnchor, armorText);
+    energyRect = placeText(energyAnchor, energyText);
+    enemyTextRect = placeText(enemyTextAnchor, enemyText);
+    playerTextRect = placeText(playerTextAnchor, playerText);
+    previewRect = placeText(previewAnchor, previewText);
+}
+
+SDL_Rect BattleScene::placeText(int anchorId, SDL_Texture* texture) const {
+    int texW = 0, texH = 0;
+    if (texture) {
+        SDL_QueryTexture(texture, nullptr, nullptr, &texW, &texH);
+    }
+    return layout.placeContent(anchorId, texW, texH);
 }
 
 void BattleScene::setRenderer(SDL_Renderer* newRenderer) {
@@ -47,56 +124,55 @@ void BattleScene::setRenderer(SDL_Renderer* newRenderer) {
 
     // Destroy existing textures
     if (enemyHPText) {
-        SDL_DestroyTexture(enemyHPText);
+        MemoryStats::destroyTexture(enemyHPText);
         enemyHPText = nullptr;
     }
+    if (intentText) {
+        MemoryStats::destroyTexture(intentText);
+        intentText = nullptr;
+    }
     if (playerHPText) {
-        SDL_DestroyTexture(playerHPText);
+        MemoryStats::destroyTexture(playerHPText);
         playerHPText = nullptr;
     }
     if (armorText) {
-        SDL_DestroyTexture(armorText);
+        MemoryStats::destroyTexture(armorText);
         armorText = nullptr;
     }
     if (energyText) {
-        SDL_DestroyTexture(energyText);
+        MemoryStats::destroyTexture(energyText);
         energyText = nullptr;
     }
     if (playerText) {
-        SDL_DestroyTexture(playerText);
+        MemoryStats::destroyTexture(playerText);
         playerText = nullptr;
     }
     if (enemyText) {
-        SDL_DestroyTexture(enemyText);
+        MemoryStats::destroyTexture(enemyText);
         enemyText = nullptr;
     }
 
+    clearDamageNumbers();
+    clearPreview();
+
     // Update buttons
     continueButton.setRenderer(renderer);
     skipTurnButton.setRenderer(renderer);
+    hintButton.setRenderer(renderer);
+    undoButton.setRenderer(renderer);
+    redoButton.setRenderer(renderer);
 
     // Reload card textures
-    for (auto& card : hand) {
-        std::string imagePath = Constants::CARD_PATH + card.getName() + Constants::CARD_SUFFIX;
-        std::replace(imagePath.begin(), imagePath.end(), ' ', '_');
-        std::transform(imagePath.begin(), imagePath.end(), imagePath.begin(), ::tolower);
-        card.loadImage(imagePath, renderer, textureManager);
-    }
-    for (auto& card : drawPile) {
-        std::string imagePath = Constants::CARD_PATH + card.getName() + Constants::CARD_SUFFIX;
-        std::replace(imagePath.begin(), imagePath.end(), ' ', '_');
-        std::transform(imagePath.begin(), imagePath.end(), imagePath.begin(), ::tolower);
-        card.loadImage(imagePath, renderer, textureManager);
+    for (auto& card : specCards) {
+        reloadCardImage(card);
     }
-    for (auto& card : discard) {
-        std::string imagePath = Constants::CARD_PATH + card.getName() + Constants::CARD_SUFFIX;
-        std::replace(imagePath.begin(), imagePath.end(), ' ', '_');
-        std::transform(imagePath.begin(), imagePath.end(), imagePath.begin(), ::tolower);
-        card.loadImage(imagePath, renderer, textureManager);
+    for (auto& card : hand) {
+        reloadCardImage(card);
     }
 
     // Recreate text textures
     updateHPText();
+    updateIntentText();
     updatePlayerHPText();
     updateArmorText();
     updateEnergyText();
@@ -107,18 +183,23 @@ void BattleScene::setFont(TTF_Font* newFont) {
     font = newFont;
     continueButton.updateText(continueButton.getLabel(), font, renderer);
     skipTurnButton.updateText(skipTurnButton.getLabel(), font, renderer);
+    hintButton.updateText(hintButton.getLabel(), font, renderer);
+    undoButton.updateText(undoButton.getLabel(), font, renderer);
+    redoButton.updateText(redoButton.getLabel(), font, renderer);
+    clearPreview();
 
-    for (auto& card : hand) {
-        card.setFont(font);
-    }
-    for (auto& card : drawPile) {
+    TTF_Font* magnifiedFont = game->getFont(static_cast<int>(Constants::FONT_SIZE * Constants::CARD_MAGNIFICATION_SCALE));
+    for (auto& card : specCards) {
         card.setFont(font);
+        card.setMagnifiedFont(magnifiedFont);
     }
-    for (auto& card : discard) {
+    for (auto& card : hand) {
         card.setFont(font);
+        card.setMagnifiedFont(magnifiedFont);
     }
 
     updateHPText();
+    updateIntentText();
     updatePlayerHPText();
     updateArmorText();
     updateEnergyText();
@@ -126,74 +207,91 @@ void BattleScene::setFont(TTF_Font* newFont) {
 }
 
 void BattleScene::updateTextTextures() {
-    std::stringstream enemySS;
-    enemySS << enemy.name << " HP: " << enemy.hp;
-    SDL_Surface* enemySurface = TTF_RenderText_Solid(font, enemySS.str().c_str(), { 255, 0, 0, 255 });
+    if (enemyText) MemoryStats::destroyTexture(enemyText);
+    if (playerText) MemoryStats::destroyTexture(playerText);
+    enemyText = nullptr;
+    playerText = nullptr;
+
+    FrameText enemyLine;
+    enemyLine << enemyName << " HP: " << state.enemyHP;
+    SDL_Surface* enemySurface = TTF_RenderText_Solid(font, enemyLine.c_str(), { 255, 0, 0, 255 });
     if (enemySurface) {
-        enemyText = SDL_CreateTextureFromSurface(renderer, enemySurface);
-        enemyTextRect = { 50, 50, enemySurface->w, enemySurface->h };
+        enemyText = MemoryStats::createTextureFromSurface(renderer, enemySurface);
+        enemyTextRect = layout.placeContent(enemyTextAnchor, enemySurface->w, enemySurface->h);
         SDL_FreeSurface(enemySurface);
     }
 
-    std::stringstream playerSS;
-    playerSS << "Player HP: " << playerHP << " Energy: " << playerEnergy;
-    SDL_Surface* playerSurface = TTF_RenderText_Solid(font, playerSS.str().c_str(), { 0, 0, 255, 255 });
+    FrameText playerLine;
+    playerLine << "Player HP: " << state.playerHP << " Energy: " << state.energy;
+    SDL_Surface* playerSurface = TTF_RenderText_Solid(font, playerLine.c_str(), { 0, 0, 255, 255 });
     if (playerSurface) {
-        playerText = SDL_CreateTextureFromSurface(renderer, playerSurface);
-        playerTextRect = { 50, game->getWindowHeight() - 50, playerSurface->w, playerSurface->h };
+        playerText = MemoryStats::createTextureFromSurface(renderer, playerSurface);
+        playerTextRect = layout.placeContent(playerTextAnchor, playerSurface->w, playerSurface->h);
         SDL_FreeSurface(playerSurface);
     }
 }
 
 void BattleScene::render() {
+    refreshLayout();
+
     SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
     SDL_RenderClear(renderer);
 
     SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
-    SDL_RenderFillRect(renderer, &boardRect);
+    RenderStats::fillRect(renderer, &boardRect);
 
     if (enemyHPText) {
-        int texW, texH;
-        SDL_QueryTexture(enemyHPText, nullptr, nullptr, &texW, &texH);
-        SDL_Rect textRect = { 350 - texW / 2, 100 - texH / 2, texW, texH };
-        SDL_RenderCopy(renderer, enemyHPText, nullptr, &textRect);
+        RenderStats::copy(renderer, enemyHPText, nullptr, &enemyHPRect);
+    }
+
+    if (intentText && !isBattleOver()) {
+        RenderStats::copy(renderer, intentText, nullptr, &intentRect);
     }
 
     if (playerHPText) {
-        int texW, texH;
-        SDL_QueryTexture(playerHPText, nullptr, nullptr, &texW, &texH);
-        SDL_Rect textRect = { 50, 50, texW, texH };
-        SDL_RenderCopy(renderer, playerHPText, nullptr, &textRect);
+        RenderStats::copy(renderer, playerHPText, nullptr, &playerHPRect);
     }
 
     if (armorText) {
-        int texW, texH;
-        SDL_QueryTexture(armorText, nullptr, nullptr, &texW, &texH);
-        SDL_Rect textRect = { 50, 80, texW, texH };
-        SDL_RenderCopy(renderer, armorText, nullptr, &textRect);
+        RenderStats::copy(renderer, armorText, nullptr, &armorRect);
     }
 
     if (energyText) {
-        int texW, texH;
-        SDL_QueryTexture(energyText, nullptr, nullptr, &texW, &texH);
-        SDL_Rect textRect = { 50, 110, texW, texH };
-        SDL_RenderCopy(renderer, energyText, nullptr, &textRect);
+        RenderStats::copy(renderer, energyText, nullptr, &energyRect);
+    }
+
+    for (auto& number : damageNumbers) {
+        float progress = game->getTweens().getValue(number.tween, 1.0f);
+        SDL_Rect rect = number.rect;
+        rect.y -= static_cast<int>(layout.scaled(40) * progress);
+        SDL_SetTextureAlphaMod(number.texture, static_cast<Uint8>(255 * (1.0f - progress)));
+        RenderStats::copy(renderer, number.texture, nullptr, &rect);
+    }
+
+    if (previewText) {
+        RenderStats::copy(renderer, previewText, nullptr, &previewRect);
+    }
+
+    for (auto& card : discardingCards) {
+        card.render(renderer, state.energy, game->getWindowWidth(), game->getWindowHeight());
     }
 
     Card* magnifiedCard = nullptr;
     for (auto& card : hand) {
-        if (card.getIsMagnified() && !card.isDragging) {
+        if (card.getMagnification() > 1.0f && !card.isDragging) {
             magnifiedCard = &card;
             break;
         }
     }
 
     for (auto& card : hand) {
-        card.render(renderer, playerEnergy, game->getWindowWidth(), game->getWindowHeight());
+        if (&card != magnifiedCard) {
+            card.render(renderer, state.energy, game->getWindowWidth(), game->getWindowHeight());
+        }
     }
 
     if (magnifiedCard) {
-        magnifiedCard->render(renderer, playerEnergy, game->getWindowWidth(), game->getWindowHeight());
+        magnifiedCard->render(renderer, state.energy, game->getWindowWidth(), game->getWindowHeight());
     }
 
     if (battleWon) {
@@ -202,10 +300,35 @@ void BattleScene::render() {
 
     skipTurnButton.render();
 
-    SDL_RenderPresent(renderer);
+    if (!isBattleOver()) {
+        hintButton.render();
+        if (history.canUndo()) {
+            undoButton.render();
+        }
+        if (history.canRedo()) {
+            redoButton.render();
+        }
+
+        const SDL_Rect* hintRect = nullptr;
+        SDL_Rect skipRect = skipTurnButton.getRect();
+        if (hintEndTurn) {
+            hintRect = &skipRect;
+        }
+        else if (hintIndex >= 0 && hintIndex < static_cast<int>(hand.size())) {
+            hintRect = &hand[hintIndex].getRect();
+        }
+        if (hintRect) {
+            SDL_Rect outline = { hintRect->x - 4, hintRect->y - 4, hintRect->w + 8, hintRect->h + 8 };
+            SDL_SetRenderDrawColor(renderer, 255, 215, 0, 255);
+            RenderStats::drawRect(renderer, &outline);
+            outline = { outline.x + 1, outline.y + 1, outline.w - 2, outline.h - 2 };
+            RenderStats::drawRect(renderer, &outline);
+        }
+    }
 }
 
 void BattleScene::handleEvent(SDL_Event& e) {
+    refreshLayout();
     if (battleWon && !readyToEnd) {
         continueButton.handleEvent(e);
         return;
@@ -216,59 +339,132 @@ void BattleScene::handleEvent(SDL_Event& e) {
     }
 
     skipTurnButton.handleEvent(e);
+    hintButton.handleEvent(e);
+    if (draggingIndex < 0 && history.canUndo()) {
+        undoButton.handleEvent(e);
+    }
+    if (draggingIndex < 0 && history.canRedo()) {
+        redoButton.handleEvent(e);
+    }
 
-    Card* draggingCard = nullptr;
-    for (auto& card : hand) {
-        if (card.isDragging) {
-            draggingCard = &card;
-            break;
+    if (draggingIndex >= 0) {
+        Card& card = hand[draggingIndex];
+        card.handleEvent(e, true);
+
+        if (e.type == SDL_MOUSEBUTTONUP && e.button.button == SDL_BUTTON_LEFT) {
+            card.isDragging = false;
+            int playedIndex = draggingIndex;
+            draggingIndex = -1;
+
+            SDL_Rect cardRect = card.getRect();
+            bool onBoard = (cardRect.x + cardRect.w >= boardRect.x && cardRect.x <= boardRect.x + boardRect.w &&
+                cardRect.y + cardRect.h >= boardRect.y && cardRect.y <= boardRect.y + boardRect.h);
+            if (onBoard && state.canPlay(playedIndex, combatDeck)) {
+                playCard(playedIndex);
+            }
+            else {
+                card.resetPosition();
+            }
         }
     }
+    else if (e.type == SDL_MOUSEMOTION || (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT)) {
+        int x = e.type == SDL_MOUSEMOTION ? e.motion.x : e.button.x;
+        int y = e.type == SDL_MOUSEMOTION ? e.motion.y : e.button.y;
+        int hit = handHitGrid.query(x, y);
 
-    if (!draggingCard) {
-        for (auto& card : hand) {
-            card.handleEvent(e);
+        // Only the card under the pointer and the one it just left see the event.
+        if (hoveredIndex != hit && hoveredIndex >= 0 && hoveredIndex < static_cast<int>(hand.size())) {
+            hand[hoveredIndex].handleEvent(e, false);
         }
-    }
-    else {
-        draggingCard->handleEvent(e);
-    }
-
-    if (e.type == SDL_MOUSEBUTTONUP && e.button.button == SDL_BUTTON_LEFT) {
-        for (auto it = hand.begin(); it != hand.end(); ++it) {
-            if (it->isDragging) {
-                it->isDragging = false;
-
-                SDL_Rect cardRect = it->getRect();
-                bool onBoard = (cardRect.x + cardRect.w >= boardRect.x && cardRect.x <= boardRect.x + boardRect.w &&
-                    cardRect.y + cardRect.h >= boardRect.y && cardRect.y <= boardRect.y + boardRect.h);
-                bool hasEnoughEnergy = (playerEnergy >= it->getEnergyCost());
-
-                if (onBoard && hasEnoughEnergy) {
-                    playerEnergy -= it->getEnergyCost();
-                    updateEnergyText();
-                    playCard(*it);
-                    hand.erase(it);
-                    updateCardPositions();
-                }
-                else {
-                    it->resetPosition();
-                }
-                break;
+        hoveredIndex = hit;
+        if (hit >= 0) {
+            hand[hit].handleEvent(e, true);
+            if (hand[hit].isDragging) {
+                draggingIndex = hit;
             }
         }
     }
+    updatePreview();
+}
 
-    bool anyDragging = false;
-    for (const auto& card : hand) {
-        if (card.isDragging) {
-            anyDragging = true;
-            break;
+void BattleScene::handleAction(InputAction action) {
+    if (action == InputAction::Confirm && battleWon && !readyToEnd) {
+        game->endBattle(true);
+    }
+    else if (action == InputAction::EndTurn && !isBattleOver() && draggingIndex < 0) {
+        endTurn();
+    }
+    else if (action == InputAction::Undo && !isBattleOver() && draggingIndex < 0) {
+        undo();
+    }
+    else if (action == InputAction::Redo && !isBattleOver() && draggingIndex < 0) {
+        redo();
+    }
+}
+
+void BattleScene::update(Uint32 now) {
+    for (auto& card : hand) {
+        card.update(now);
+    }
+
+    if (!discardingCards.empty()) {
+        for (auto& card : discardingCards) {
+            card.update(now);
+        }
+        discardingCards.erase(std::remove_if(discardingCards.begin(), discardingCards.end(),
+            [](const Card& card) { return !card.isMoving(); }), discardingCards.end());
+    }
+
+    if (!damageNumbers.empty()) {
+        const TweenScheduler& tweens = game->getTweens();
+        auto finished = std::remove_if(damageNumbers.begin(), damageNumbers.end(), [&tweens](const DamageNumber& number) {
+            if (tweens.isActive(number.tween)) {
+                return false;
+            }
+            MemoryStats::destroyTexture(number.texture);
+            return true;
+        });
+        damageNumbers.erase(finished, damageNumbers.end());
+    }
+
+    if (hintResults->update()) {
+        const HintResult& result = hintResults->getReadBuffer();
+        if (result.request == hintRequest && !isBattleOver()) {
+            hintEndTurn = result.action == MctsAgent::END_TURN;
+            hintIndex = hintEndTurn ? -1 : result.handIndex;
+            if (hintEndTurn || (hintIndex >= 0 && hintIndex < static_cast<int>(hand.size()))) {
+                std::cout << "Hint: " << (hintEndTurn ? std::string("end turn") : hand[hintIndex].getName())
+                    << " (" << result.rollouts << " rollouts in " << result.elapsedMs << " ms)\n";
+            }
         }
     }
-    if (anyDragging) {
-        render();
+}
+
+void BattleScene::spawnDamageNumber(int amount, const SDL_Rect& origin, SDL_Color color) {
+    if (amount <= 0 || !font || !renderer) {
+        return;
+    }
+    FrameText text;
+    text << "-" << amount;
+    SDL_Surface* surface = TTF_RenderText_Blended(font, text.c_str(), color);
+    if (!surface) {
+        return;
+    }
+    SDL_Texture* texture = MemoryStats::createTextureFromSurface(renderer, surface);
+    SDL_Rect rect = { origin.x + origin.w + layout.scaled(10), origin.y, surface->w, surface->h };
+    SDL_FreeSurface(surface);
+    if (!texture) {
+        return;
+    }
+    damageNumbers.push_back(DamageNumber{ texture, rect,
+        game->getTweens().start(0.0f, 1.0f, Constants::DAMAGE_NUMBER_DURATION, Easing::EaseOutCubic) });
+}
+
+void BattleScene::clearDamageNumbers() {
+    for (auto& number : damageNumbers) {
+        MemoryStats::destroyTexture(number.texture);
     }
+    damageNumbers.clear();
 }
 
 bool BattleScene::isBattleOver() const {
@@ -284,213 +480,277 @@ bool BattleScene::isReadyToEnd() const {
 }
 
 void BattleScene::updateHPText() {
-    if (enemyHPText) SDL_DestroyTexture(enemyHPText);
-    std::string hpText = enemy.name + " HP: " + std::to_string(enemy.hp);
+    if (enemyHPText) MemoryStats::destroyTexture(enemyHPText);
+    FrameText hpText;
+    hpText << enemyName << " HP: " << state.enemyHP;
+    if (state.enemyBlock > 0) {
+        hpText << " Block: " << state.enemyBlock;
+    }
     SDL_Color textColor = { 0, 0, 0, 255 };
     SDL_Surface* surface = TTF_RenderText_Solid(font, hpText.c_str(), textColor);
-    enemyHPText = SDL_CreateTextureFromSurface(renderer, surface);
+    enemyHPText = MemoryStats::createTextureFromSurface(renderer, surface);
     SDL_FreeSurface(surface);
+    enemyHPRect = placeText(enemyHPAnchor, enemyHPText);
+}
+
+void BattleScene::updateIntentText() {
+    if (intentText) MemoryStats::destroyTexture(intentText);
+    intentText = nullptr;
+    FrameText text;
+    if (state.frozen) {
+        text << "Frozen";
+    }
+    else if (state.behavior) {
+        text << "Intent: ";
+        state.behavior->describe(state.enemyIntent, state.enemyStrength - state.damageReduction, text.str());
+    }
+    else {
+        text << "Intent: Attack " << state.incomingDamage();
+    }
+    SDL_Surface* surface = TTF_RenderText_Solid(font, text.c_str(), { 160, 0, 0, 255 });
+    if (surface) {
+        intentText = MemoryStats::createTextureFromSurface(renderer, surface);
+        SDL_FreeSurface(surface);
+    }
+    intentRect = placeText(intentAnchor, intentText);
 }
 
 void BattleScene::updatePlayerHPText() {
-    if (playerHPText) SDL_DestroyTexture(playerHPText);
-    std::string hpText = "Player HP: " + std::to_string(playerHP);
+    if (playerHPText) MemoryStats::destroyTexture(playerHPText);
+    FrameText hpText;
+    hpText << "Player HP: " << state.playerHP;
+    if (state.playerPoisonTurns > 0) {
+        hpText << " (poison " << state.playerPoison << " x" << state.playerPoisonTurns << ")";
+    }
     SDL_Color textColor = { 0, 0, 0, 255 };
     SDL_Surface* surface = TTF_RenderText_Solid(font, hpText.c_str(), textColor);
-    playerHPText = SDL_CreateTextureFromSurface(renderer, surface);
+    playerHPText = MemoryStats::createTextureFromSurface(renderer, surface);
     SDL_FreeSurface(surface);
+    playerHPRect = placeText(playerHPAnchor, playerHPText);
 }
 
 void BattleScene::updateArmorText() {
-    if (armorText) SDL_DestroyTexture(armorText);
-    std::string armorStr = "Armor: " + std::to_string(playerArmor);
+    if (armorText) MemoryStats::destroyTexture(armorText);
+    FrameText armorStr;
+    armorStr << "Armor: " << state.playerArmor;
     SDL_Color textColor = { 0, 0, 0, 255 };
     SDL_Surface* surface = TTF_RenderText_Solid(font, armorStr.c_str(), textColor);
-    armorText = SDL_CreateTextureFromSurface(renderer, surface);
+    armorText = MemoryStats::createTextureFromSurface(renderer, surface);
     SDL_FreeSurface(surface);
+    armorRect = placeText(armorAnchor, armorText);
 }
 
 void BattleScene::updateEnergyText() {
-    if (energyText) SDL_DestroyTexture(energyText);
-    std::string energyStr = "Energy: " + std::to_string(playerEnergy) + "/" + std::to_string(maxEnergy);
+    if (energyText) MemoryStats::destroyTexture(energyText);
+    FrameText energyStr;
+    energyStr << "Energy: " << state.energy << "/" << state.maxEnergy;
     SDL_Color textColor = { 0, 0, 0, 255 };
     SDL_Surface* surface = TTF_RenderText_Solid(font, energyStr.c_str(), textColor);
-    energyText = SDL_CreateTextureFromSurface(renderer, surface);
+    energyText = MemoryStats::createTextureFromSurface(renderer, surface);
     SDL_FreeSurface(surface);
+    energyRect = placeText(energyAnchor, energyText);
 }
 
-void BattleScene::drawCard() {
-    if (drawPile.empty() && !discard.empty()) {
-        drawPile = std::move(discard);
-        discard.clear();
-        std::random_device rd;
-        std::mt19937 g(rd());
-        std::shuffle(drawPile.begin(), drawPile.end(), g);
-    }
-    if (!drawPile.empty() && hand.size() < 5) {
-        hand.push_back(std::move(drawPile.back()));
-        drawPile.pop_back();
-        updateCardPositions();
+void BattleScene::reloadCardImage(Card& card) {
+    card.loadImage(renderer, textureManager);
+}
+
+void BattleScene::syncHand(bool rebuild) {
+    // Cards leave the hand through playCard, which erases their widget, and the
+    // state only ever appends draws, so new cards are always at the end. After
+    // undo or redo the hand is rebuilt and snaps into place instead.
+    if (rebuild) {
+        hand.clear();
+    }
+    for (int i = static_cast<int>(hand.size()); i < state.handCount; ++i) {
+        hand.push_back(specCards[state.hand[i]]);
+        hand.back().placeAt(layout.getRect(drawPileAnchor));
+    }
+    updateCardPositions();
+    if (rebuild) {
+        for (size_t i = 0; i < hand.size() && static_cast<int>(i) < layout.getItemCount(handRow); ++i) {
+            hand[i].placeAt(layout.getItemRect(handRow, static_cast<int>(i)));
+        }
     }
 }
 
 void BattleScene::updateCardPositions() {
-    for (size_t i = 0; i < hand.size(); ++i) {
-        Card& card = hand[i];
-        int newX = 50 + (i + 1) * 110;
-        SDL_Rect newRect = { newX, 450, 100, 150 };
-        card.getRect() = newRect;
-        card.getOriginalRect() = newRect;
-        std::cout << "Positioned " << card.getName() << " at (" << newRect.x << ", " << newRect.y << ")\n";
+    clearHint();
+    clearPreview();
+    // Slot indices shift when the hand changes; hover is re-established on the next motion.
+    for (auto& card : hand) {
+        card.clearHover();
     }
+    hoveredIndex = -1;
+    layout.setItemCount(handRow, static_cast<int>(hand.size()));
+    refreshLayout();
 }
 
-void BattleScene::playCard(Card& card) {
-    enemy.hp -= card.getDamage();
-    std::cout << "Played " << card.getName() << ", " << enemy.name << " HP now: " << enemy.hp << std::endl;
-    updateHPText();
+void BattleScene::playCard(int handIndex) {
+    CombatState before = state;
+    std::cout << "Played " << combatDeck.getSpec(state.hand[handIndex]).name << ", ";
+    state.playCard(handIndex, combatDeck);
+    std::cout << enemyName << " HP now: " << state.enemyHP << std::endl;
+    history.push(state);
+    if (EventLog::Buffer* events = eventsFrom(before)) {
+        events->cardPlayed(combatDeck.getSpec(before.hand[handIndex]), before, state);
+        logOutcome(events);
+    }
+
+    discardingCards.push_back(hand[handIndex]);
+    discardingCards.back().setRect(layout.getRect(discardPileAnchor));
+    hand.erase(hand.begin() + handIndex);
+    updateCardPositions();
+    applyStateChange(before, { 255, 0, 0, 255 });
+}
 
-    CardEffect effect = card.getEffect();
-    switch (effect.type) {
-    case CardEffectType::Armor:
-        playerArmor += effect.value;
-        std::cout << "Gained " << effect.value << " armor, total: " << playerArmor << std::endl;
-        updateArmorText();
-        break;
-    case CardEffectType::Heal:
-        playerHP = std::min(20, playerHP + effect.value);
-        updatePlayerHPText();
-        break;
-    case CardEffectType::MultiStrike:
-        for (int i = 0; i < effect.count; ++i) {
-            enemy.hp -= effect.value;
-            updateHPText();
-            if (enemy.hp <= 0) {
-                battleWon = true;
-                break;
-            }
+void BattleScene::endTurn() {
+    clearHint();
+    CombatState before = state;
+    state.endTurn();
+    if (before.playerHP > state.playerHP) {
+        std::cout << enemyName << " attacks, player HP now: " << state.playerHP << ", armor now: " << state.playerArmor << std::endl;
+    }
+    // Undo stops at the turn boundary: the enemy has acted and new cards were drawn.
+    history.reset(state);
+    if (EventLog::Buffer* events = eventsFrom(before)) {
+        events->turnEnded(before, state);
+        logOutcome(events);
+    }
+    syncHand(false);
+    // Only poison hurts the enemy during its own turn.
+    applyStateChange(before, { 0, 160, 0, 255 });
+}
+
+void BattleScene::undo() {
+    CombatState before = state;
+    if (history.undo(state)) {
+        std::cout << "Undo\n";
+        if (EventLog::Buffer* events = eventsFrom(before)) {
+            events->historyMoved(EventLog::Kind::Undone, before, state);
         }
-        break;
-    case CardEffectType::Weaken:
-        applyWeakenEffect(effect.value, effect.count);
-        break;
-    case CardEffectType::Poison:
-        applyPoisonEffect(effect.value, effect.count);
-        break;
-    case CardEffectType::Thorns:
-        applyThornsEffect();
-        break;
-    case CardEffectType::Wet:
-        applyWetEffect(effect.count);
-        break;
-    case CardEffectType::Lightning:
-        applyLightningEffect(effect.value);
-        break;
-    case CardEffectType::Ice:
-        applyIceEffect(effect.value, effect.count);
-        break;
-    default:
-        break;
-    }
-
-    discard.push_back(std::move(card));
-    if (enemy.hp <= 0) battleWon = true;
-}
-
-void BattleScene::applyWeakenEffect(int value, int turns) {
-    enemy.damageReduction = value;
-    enemy.weakenTurns = turns;
-    std::cout << enemy.name << " is weakened by " << value << " for " << turns << " turns\n";
-}
-
-void BattleScene::applyPoisonEffect(int damage, int turns) {
-    enemy.poisonDamage = damage;
-    enemy.poisonTurns = turns;
-    std::cout << enemy.name << " is poisoned for " << damage << " damage over " << turns << " turns\n";
-}
-
-void BattleScene::applyThornsEffect() {
-    int damage = 3;
-    enemy.hp -= damage;
-    std::cout << enemy.name << " takes " << damage << " damage from Thorns\n";
-    updateHPText();
-    if (enemy.hp <= 0) battleWon = true;
+        syncHand(true);
+        applyStateChange(state, { 255, 0, 0, 255 });
+    }
 }
 
-void BattleScene::applyWetEffect(int turns) {
-    enemy.wetTurns = turns;
-    std::cout << enemy.name << " is now Wet for " << turns << " turns\n";
+void BattleScene::redo() {
+    CombatState before = state;
+    if (history.redo(state)) {
+        std::cout << "Redo\n";
+        if (EventLog::Buffer* events = eventsFrom(before)) {
+            events->historyMoved(EventLog::Kind::Redone, before, state);
+            logOutcome(events);
+        }
+        syncHand(true);
+        applyStateChange(state, { 255, 0, 0, 255 });
+    }
 }
 
-void BattleScene::applyLightningEffect(int damage) {
-    int finalDamage = (enemy.wetTurns > 0) ? damage * 2 : damage;
-    enemy.hp -= finalDamage;
-    std::cout << "Thunder Strike deals " << finalDamage << " lightning damage, " << enemy.name << " HP now: " << enemy.hp << "\n";
-    updateHPText();
+EventLog::Buffer* BattleScene::eventsFrom(const CombatState& before) {
+    EventLog::Buffer* events = game->getEvents();
+    if (events && !loggedStart) {
+        events->battleStarted(encounterId, before);
+        loggedStart = true;
+    }
+    return events;
 }
 
-void BattleScene::applyIceEffect(int damage, int freezeTurns) {
-    enemy.hp -= damage;
-    if (enemy.wetTurns > 0) {
-        enemy.frozen = true;
-        std::cout << enemy.name << " is Frozen for " << freezeTurns << " turn(s) due to Wet status\n";
+// Once per battle: a win undone and replayed is still one outcome.
+void BattleScene::logOutcome(EventLog::Buffer* events) {
+    if (loggedEnd || !state.isOver()) {
+        return;
     }
-    std::cout << "Ice Shard deals " << damage << " ice damage, " << enemy.name << " HP now: " << enemy.hp << "\n";
+    events->battleEnded(state, state.hasWon() ? EventLog::Result::Won : EventLog::Result::Lost);
+    loggedEnd = true;
+}
+
+void BattleScene::applyStateChange(const CombatState& before, SDL_Color enemyDamageColor) {
     updateHPText();
+    updateIntentText();
+    updatePlayerHPText();
+    updateArmorText();
+    updateEnergyText();
+    spawnDamageNumber(before.enemyHP - state.enemyHP, enemyHPRect, enemyDamageColor);
+    spawnDamageNumber(before.playerHP - state.playerHP, playerHPRect, { 255, 0, 0, 255 });
+    battleWon = state.hasWon();
+    playerDefeated = !battleWon && state.playerHP <= 0;
 }
 
-void BattleScene::updateEnemyEffects() {
-    if (enemy.weakenTurns > 0) {
-        enemy.weakenTurns--;
-        if (enemy.weakenTurns == 0) enemy.damageReduction = 0;
+void BattleScene::updatePreview() {
+    int index = draggingIndex >= 0 ? draggingIndex : hoveredIndex;
+    if (isBattleOver() || index >= state.handCount) {
+        index = -1;
     }
-    if (enemy.poisonTurns > 0) {
-        enemy.hp -= enemy.poisonDamage;
-        enemy.poisonTurns--;
-        updateHPText();
-        if (enemy.hp <= 0) battleWon = true;
+    if (index == previewIndex) {
+        return;
     }
-    if (enemy.wetTurns > 0) {
-        enemy.wetTurns--;
-        std::cout << enemy.name << " Wet turns remaining: " << enemy.wetTurns << "\n";
+    clearPreview();
+    previewIndex = index;
+    if (index < 0) {
+        return;
     }
-}
 
-void BattleScene::enemyAttack() {
-    if (enemy.frozen) {
-        std::cout << enemy.name << " is Frozen and skips its turn\n";
-        enemy.frozen = false;
-        return;
+    // What-if: play the card on a copy and describe the difference.
+    CombatState after = state;
+    after.playCard(index, combatDeck);
+    FrameText text;
+    text << combatDeck.getSpec(state.hand[index]).name << ":";
+    if (state.enemyHP > after.enemyHP) text << " " << state.enemyHP - after.enemyHP << " damage";
+    if (after.enemyHP <= 0) text << " (lethal)";
+    if (after.enemyBlock < state.enemyBlock) text << ", " << state.enemyBlock - after.enemyBlock << " blocked";
+    if (after.playerArmor > state.playerArmor) text << " +" << after.playerArmor - state.playerArmor << " armor";
+    if (after.playerHP > state.playerHP) text << " +" << after.playerHP - state.playerHP << " HP";
+    if (after.wetTurns > state.wetTurns) text << ", Wet " << after.wetTurns << " turns";
+    if (after.frozen && !state.frozen) text << ", freezes";
+    if (after.poisonTurns > state.poisonTurns) text << ", poison " << after.poisonDamage << " x" << after.poisonTurns;
+    if (after.weakenTurns > state.weakenTurns) text << ", weaken " << after.damageReduction << " x" << after.weakenTurns;
+    if (!state.canPlay(index, combatDeck)) text << " (not enough energy)";
+
+    SDL_Surface* surface = TTF_RenderText_Solid(font, text.c_str(), { 0, 0, 0, 255 });
+    if (surface) {
+        previewText = MemoryStats::createTextureFromSurface(renderer, surface);
+        previewRect = layout.placeContent(previewAnchor, surface->w, surface->h);
+        SDL_FreeSurface(surface);
     }
-    int effectiveDamage = std::max(0, enemy.damage - enemy.damageReduction);
-    int damageAfterArmor = std::max(0, effectiveDamage - playerArmor);
-    playerArmor = std::max(0, playerArmor - effectiveDamage);
-    playerHP -= damageAfterArmor;
-    std::cout << enemy.name << " attacks for " << effectiveDamage << " damage, reduced by "
-        << (effectiveDamage - damageAfterArmor) << " armor, player HP now: " << playerHP
-        << ", armor now: " << playerArmor << std::endl;
-    updatePlayerHPText();
-    updateArmorText();
-    if (playerHP <= 0) playerDefeated = true;
 }
 
-void BattleScene::endTurn() {
-    if (!battleWon && !playerDefeated) {
-        enemyAttack();
+void BattleScene::clearPreview() {
+    if (previewText) {
+        MemoryStats::destroyTexture(previewText);
+        previewText = nullptr;
     }
-    updateEnemyEffects();
+    previewIndex = -1;
+}
 
-    const int desiredHandSize = 3;
-    const int maxHandSize = 5;
-    int cardsToDraw = (hand.size() < desiredHandSize) ? (desiredHandSize - hand.size()) : 1;
-    cardsToDraw = std::min(cardsToDraw, maxHandSize - static_cast<int>(hand.size()));
-    for (int i = 0; i < cardsToDraw; ++i) {
-        drawCard();
+void BattleScene::showHint() {
+    clearHint();
+    if (isBattleOver() || draggingIndex >= 0) {
+        return;
     }
-    resetTurn();
+
+    // The search runs on the simulation thread; update() picks the answer up
+    // unless the hand has changed in the meantime. The agent only sees what the
+    // player sees: the draw pile is sampled, not read in order.
+    MctsAgent::Config config;
+    config.budgetMs = Constants::HINT_SEARCH_MS;
+    config.seed = SDL_GetTicks();
+    config.threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    CombatState root = state;
+    root.seed(config.seed);
+    CombatDeck deck = combatDeck;
+    unsigned request = hintRequest;
+    std::shared_ptr<TripleBuffer<HintResult>> results = hintResults;
+    game->getSimulation().post([config, root, deck, request, results]() {
+        MctsAgent agent(config);
+        MctsAgent::Result result = agent.chooseAction(root, deck);
+        results->getWriteBuffer() = HintResult{ request, result.action, result.handIndex, result.rollouts, result.elapsedMs };
+        results->publish();
+    });
 }
 
-void BattleScene::resetTurn() {
-    playerEnergy = maxEnergy;
-    updateEnergyText();
+void BattleScene::clearHint() {
+    hintIndex = -1;
+    hintEndTurn = false;
+    ++hintRequest; // a search still running is answering an old position
 }
\ No newline at end of file
@@ -1,29 +1,114 @@
 #include "../includes/scenes/DeckSelectionScene.h"
 #include "../includes/core/Game.h"
+#include "../includes/simulation/DeckStatistics.h"
+#include "../includes/simulation/MapGraph.h"
+#include "../includes/systems/RenderStats.h"
+#include "../includes/systems/MemoryStats.h"
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 
 DeckSelectionScene::DeckSelectionScene(SDL_Renderer* renderer, TTF_Font* font, Game* game)
-    : renderer(renderer), font(font), game(game) {
-    buttons.push_back(Button(300, 150, 200, 50, "Damage Deck", font, renderer, [this, game]() {
+    : renderer(renderer), font(font), game(game),
+    buttonColumn(layout.addFlex(LayoutFlex(LayoutAnchor(0.5f, 0.0f, 0.5f, 0.0f, 0, 150), FlexDirection::Column, 200, 50, 50), 4)),
+    statResults(std::make_shared<TripleBuffer<std::vector<std::string>>>()) {
+    buttons.push_back(Button(0, 0, 200, 50, "Damage Deck", font, renderer, [this, game]() {
         std::cout << "Damage Deck selected\n";
         game->selectDeck(Game::DeckType::DAMAGE);
         game->setState(Game::GameState::GAME);
         }));
-    buttons.push_back(Button(300, 250, 200, 50, "Elemental Deck", font, renderer, [this, game]() {
+    buttons.push_back(Button(0, 0, 200, 50, "Elemental Deck", font, renderer, [this, game]() {
         std::cout << "Elemental Deck selected\n";
         game->selectDeck(Game::DeckType::ELEMENTAL);
         game->setState(Game::GameState::GAME);
         }));
-    buttons.push_back(Button(300, 350, 200, 50, "Defense Deck", font, renderer, [this, game]() {
+    buttons.push_back(Button(0, 0, 200, 50, "Defense Deck", font, renderer, [this, game]() {
         std::cout << "Defense Deck selected\n";
         game->selectDeck(Game::DeckType::DEFENSE);
         game->setState(Game::GameState::GAME);
         }));
-    buttons.push_back(Button(300, 450, 200, 50, "Balanced Deck", font, renderer, [this, game]() {
+    buttons.push_back(Button(0, 0, 200, 50, "Balanced Deck", font, renderer, [this, game]() {
         std::cout << "Balanced Deck selected\n";
         game->selectDeck(Game::DeckType::BALANCED);
         game->setState(Game::GameState::GAME);
         }));
+    requestStatLines();
+    refreshLayout();
+}
+
+DeckSelectionScene::~DeckSelectionScene() {
+    destroyStatTextures();
+}
+
+void DeckSelectionScene::requestStatLines() {
+    std::shared_ptr<TripleBuffer<std::vector<std::string>>> results = statResults;
+    game->getSimulation().post([results]() {
+        // Turns to kill are quoted against the toughest fight on the map.
+        const EncounterDef* toughest = MapGraph::createDefault().getToughestEncounter();
+        std::vector<int> enemyHP;
+        if (toughest) {
+            enemyHP.push_back(toughest->hp);
+        }
+
+        const Game::DeckType decks[] = { Game::DeckType::DAMAGE, Game::DeckType::ELEMENTAL, Game::DeckType::DEFENSE, Game::DeckType::BALANCED };
+        std::vector<std::string>& lines = results->getWriteBuffer();
+        lines.clear();
+        for (Game::DeckType deck : decks) {
+            DeckReport report;
+            CombatDeck combatDeck = CardLibrary::buildCombatDeck(CardLibrary::getStarterDeck(deck));
+            if (!DeckStatistics::analyze(combatDeck, enemyHP, DeckStatistics::DEFAULT_TURNS, report)) {
+                lines.push_back("");
+                continue;
+            }
+            std::ostringstream line;
+            line << std::fixed << std::setprecision(1) << report.getMeanDamagePerTurn() << " dmg, "
+                << report.getMeanArmorPerTurn() << " armor per turn";
+            if (toughest) {
+                line << ", " << toughest->name << " in ~" << report.getExpectedTurnsToKill(0) << " turns";
+            }
+            lines.push_back(line.str());
+        }
+        results->publish();
+    });
+}
+
+void DeckSelectionScene::update(Uint32 now) {
+    if (statResults->update()) {
+        statLines = statResults->getReadBuffer();
+        createStatTextures();
+    }
+}
+
+void DeckSelectionScene::createStatTextures() {
+    destroyStatTextures();
+    SDL_Color textColor = { 0, 0, 0, 255 };
+    for (const std::string& line : statLines) {
+        SDL_Texture* texture = nullptr;
+        SDL_Surface* surface = line.empty() ? nullptr : TTF_RenderText_Solid(font, line.c_str(), textColor);
+        if (surface) {
+            texture = MemoryStats::createTextureFromSurface(renderer, surface);
+            SDL_FreeSurface(surface);
+        }
+        statTextures.push_back(texture);
+    }
+}
+
+void DeckSelectionScene::destroyStatTextures() {
+    for (SDL_Texture* texture : statTextures) {
+        if (texture) {
+            MemoryStats::destroyTexture(texture);
+        }
+    }
+    statTextures.clear();
+}
+
+void DeckSelectionScene::refreshLayout() {
+    if (!layout.update(game->getWindowWidth(), game->getWindowHeight())) {
+        return;
+    }
+    for (size_t i = 0; i < buttons.size(); ++i) {
+        buttons[i].setRect(layout.getItemRect(buttonColumn, static_cast<int>(i)));
+    }
 }
 
 void DeckSelectionScene::setRenderer(SDL_Renderer* newRenderer) {
@@ -31,6 +116,7 @@ void DeckSelectionScene::setRenderer(SDL_Renderer* newRenderer) {
     for (auto& button : buttons) {
         button.setRenderer(renderer);
     }
+    createStatTextures();
 }
 
 void DeckSelectionScene::setFont(TTF_Font* newFont) {
@@ -38,21 +124,36 @@ void DeckSelectionScene::setFont(TTF_Font* newFont) {
     for (auto& button : buttons) {
         button.updateText(button.getLabel(), font, renderer);
     }
+    createStatTextures();
 }
 
 void DeckSelectionScene::render() {
+    refreshLayout();
+
     SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
     SDL_RenderClear(renderer);
 
-    for (auto& button : buttons) {
-        button.render();
+    for (size_t i = 0; i < buttons.size(); ++i) {
+        buttons[i].render();
+        if (i < statTextures.size() && statTextures[i]) {
+            SDL_Rect buttonRect = layout.getItemRect(buttonColumn, static_cast<int>(i));
+            SDL_Rect textRect = { buttonRect.x + buttonRect.w + 20, 0, 0, 0 };
+            SDL_QueryTexture(statTextures[i], nullptr, nullptr, &textRect.w, &textRect.h);
+            textRect.y = buttonRect.y + (buttonRect.h - textRect.h) / 2;
+            RenderStats::copy(renderer, statTextures[i], nullptr, &textRect);
+        }
     }
-
-    SDL_RenderPresent(renderer);
 }
 
 void DeckSelectionScene::handleEvent(SDL_Event& e) {
+    refreshLayout();
     for (auto& button : buttons) {
         button.handleEvent(e);
     }
+}
+
+void DeckSelectionScene::handleAction(InputAction action) {
+    if (action == InputAction::Back) {
+        game->setState(Game::GameState::MENU);
+    }
 }
\ No newline at end of file
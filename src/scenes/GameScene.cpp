@@ -1,15 +1,17 @@
 #include "../includes/scenes/GameScene.h"
 #include "../includes/core/Game.h"
-#include "../includes/entities/Enemy.h"
 #include "../includes/scenes/RewardScene.h"
+#include "../includes/scenes/BattleScene.h"
+#include "../includes/systems/RenderStats.h"
+#include "../includes/systems/MemoryStats.h"
 #include <iostream>
 #include <algorithm>
 
 GameScene::GameScene(SDL_Renderer* renderer, TTF_Font* font, Game* game)
-    : renderer(renderer), font(font), game(game), currentNodeIndex(game->currentNodeIndex), gameOver(false) {
+    : renderer(renderer), font(font), game(game), graph(MapGraph::createDefault()), currentNodeIndex(game->currentNodeIndex), gameOver(false), gameOverText(nullptr), hitGridDirty(true), hoveredNode(-1) {
     lockedNodes.clear();
     if (game->completedNodes.empty()) {
-        game->completedNodes = std::vector<bool>(6, false);
+        game->completedNodes = std::vector<bool>(graph.getNodeCount(), false);
     }
     initializeNodes();
     updateActiveNodes();
@@ -17,6 +19,7 @@ GameScene::GameScene(SDL_Renderer* renderer, TTF_Font* font, Game* game)
 
 void GameScene::setRenderer(SDL_Renderer* newRenderer) {
     renderer = newRenderer;
+    discardPrewarmed();
     for (auto& node : nodes) {
         node.setRenderer(renderer);
     }
@@ -24,8 +27,9 @@ void GameScene::setRenderer(SDL_Renderer* newRenderer) {
 
 void GameScene::setFont(TTF_Font* newFont) {
     font = newFont;
+    discardPrewarmed();
     if (gameOverText) {
-        SDL_DestroyTexture(gameOverText);
+        MemoryStats::destroyTexture(gameOverText);
         gameOverText = nullptr;
     }
     // Update font for nodes if they have text
@@ -37,99 +41,30 @@ void GameScene::setFont(TTF_Font* newFont) {
 void GameScene::initializeNodes() {
     nodes.clear();
 
-    int centerX = game->getWindowWidth() / 2;
-    int baseY = game->getWindowHeight() - 100;
-
-    nodes.emplace_back(
-        centerX - 25, baseY - 25, 50, "Goblin",
-        0.5f,
-        renderer, font,
-        [this]() {
-            std::cout << "Starting Goblin Battle\n";
-            Enemy goblin("Goblin", 10, 3);
-            this->game->setState(Game::GameState::BATTLE);
-            this->game->startBattle(goblin.name, goblin.hp, goblin.damage);
-        },
-        NodeType::Fight,
-        SDL_Color{ 200, 200, 200, 255 },
-        std::vector<int>{1, 2}
-    );
-
-    nodes.emplace_back(
-        centerX + 100 - 25, baseY - 100 - 25, 50, "Green Reward",
-        0.5f,
-        renderer, font,
-        [this]() {
-            std::cout << "Entering Green Reward\n";
-            game->setRewardScene(std::make_unique<RewardScene>(renderer, font, game, RewardScene::RewardType::Green));
-            game->setState(Game::GameState::REWARD);
-            markNodeAsCompleted(currentNodeIndex);
-            lockSiblingNodes(currentNodeIndex);
-        },
-        NodeType::Reward,
-        SDL_Color{ 0, 255, 0, 255 },
-        std::vector<int>{4}
-    );
-
-    nodes.emplace_back(
-        centerX - 100 - 25, baseY - 100 - 25, 50, "Troll",
-        0.5f,
-        renderer, font,
-        [this]() {
-            std::cout << "Starting Troll Battle\n";
-            Enemy troll("Troll", 30, 4);
-            this->game->setState(Game::GameState::BATTLE);
-            this->game->startBattle(troll.name, troll.hp, troll.damage);
-        },
-        NodeType::Fight,
-        SDL_Color{ 255, 0, 0, 255 },
-        std::vector<int>{3}
-    );
-
-    nodes.emplace_back(
-        centerX - 100 - 25, baseY - 200 - 25, 50, "Purple Reward",
-        0.5f,
-        renderer, font,
-        [this]() {
-            std::cout << "Entering Purple Reward\n";
-            game->setRewardScene(std::make_unique<RewardScene>(renderer, font, game, RewardScene::RewardType::Purple));
-            game->setState(Game::GameState::REWARD);
-            markNodeAsCompleted(currentNodeIndex);
-        },
-        NodeType::Reward,
-        SDL_Color{ 128, 0, 128, 255 },
-        std::vector<int>{5}
-    );
-
-    nodes.emplace_back(
-        centerX + 100 - 25, baseY - 200 - 25, 50, "Ogre",
-        0.5f,
-        renderer, font,
-        [this]() {
-            std::cout << "Starting Ogre Battle\n";
-            Enemy ogre("Ogre", 20, 5);
-            this->game->setState(Game::GameState::BATTLE);
-            this->game->startBattle(ogre.name, ogre.hp, ogre.damage);
-        },
-        NodeType::Fight,
-        SDL_Color{ 255, 165, 0, 255 },
-        std::vector<int>{}
-    );
+    for (int i = 0; i < graph.getNodeCount(); ++i) {
+        const MapNode& mapNode = graph.getNode(i);
+        SDL_Color color = { static_cast<Uint8>(mapNode.color >> 16), static_cast<Uint8>(mapNode.color >> 8),
+            static_cast<Uint8>(mapNode.color), 255 };
+        nodes.emplace_back(
+            0, 0, 50, mapNode.label,
+            0.5f,
+            renderer, font,
+            [this, i]() { this->enterNode(i); },
+            mapNode.type,
+            color,
+            mapNode.nextNodes
+        );
+    }
+    discardPrewarmed(); // one empty slot per node
 
-    nodes.emplace_back(
-        centerX - 25, baseY - 300 - 25, 50, "Dragon",
-        0.5f,
-        renderer, font,
-        [this]() {
-            std::cout << "Starting Dragon Battle\n";
-            Enemy dragon("Dragon", 50, 6);
-            this->game->setState(Game::GameState::BATTLE);
-            this->game->startBattle(dragon.name, dragon.hp, dragon.damage);
-        },
-        NodeType::Fight,
-        SDL_Color{ 255, 0, 0, 255 },
-        std::vector<int>{}
-    );
+    // Node centres in reference pixels, relative to the bottom centre of the map
+    const SDL_Point nodeOffsets[] = { { 0, 0 }, { 100, -100 }, { -100, -100 }, { -100, -200 }, { 100, -200 }, { 0, -300 } };
+    layout = Layout();
+    nodeAnchors.clear();
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        nodeAnchors.push_back(layout.addAnchor(LayoutAnchor(0.5f, 1.0f, 0.5f, 0.5f, nodeOffsets[i].x, nodeOffsets[i].y - 100, 50, 50)));
+    }
+    refreshLayout();
 
     if (game->completedNodes.size() < nodes.size()) {
         game->completedNodes.resize(nodes.size(), false);
@@ -143,44 +78,77 @@ void GameScene::initializeNodes() {
     }
 }
 
-void GameScene::updateActiveNodes() {
-    std::vector<int> previousActiveNodes = activeNodes;
-    activeNodes.clear();
+void GameScene::discardPrewarmed() {
+    prewarmed.clear();
+    prewarmed.resize(nodes.size());
+}
 
-    bool anyCompleted = false;
-    for (size_t i = 0; i < game->completedNodes.size(); ++i) {
-        if (game->completedNodes[i]) {
-            anyCompleted = true;
-            break;
-        }
+std::unique_ptr<Scene> GameScene::buildNodeScene(int index) {
+    const MapNode& mapNode = graph.getNode(index);
+    if (mapNode.type == NodeType::Fight) {
+        return std::make_unique<BattleScene>(renderer, font, mapNode.encounter, game);
     }
+    return std::make_unique<RewardScene>(renderer, font, game, mapNode.rewardTier);
+}
 
-    if (!anyCompleted) {
-        activeNodes.push_back(0);
-        currentNodeIndex = 0;
-        game->currentNodeIndex = currentNodeIndex;
-        std::cout << "Unlocked " << nodes[0].label << "\n";
+void GameScene::enterNode(int index) {
+    const MapNode& mapNode = graph.getNode(index);
+    currentNodeIndex = index;
+    game->currentNodeIndex = index;
+    std::unique_ptr<Scene> scene = std::move(prewarmed[index]);
+    discardPrewarmed(); // built for a deck this node is about to change
+    if (!scene) {
+        scene = buildNodeScene(index);
+    }
+    if (mapNode.type == NodeType::Fight) {
+        std::cout << "Starting " << mapNode.label << " Battle\n";
+        game->setState(Game::GameState::BATTLE);
+        game->startBattle(std::move(scene));
     }
     else {
-        for (size_t i = 0; i < nodes.size(); ++i) {
-            if (game->completedNodes[i]) {
-                continue;
-            }
-            if (std::find(lockedNodes.begin(), lockedNodes.end(), i) != lockedNodes.end()) {
-                continue;
-            }
-            for (size_t j = 0; j < nodes.size(); ++j) {
-                if (game->completedNodes[j]) {
-                    for (int nextIndex : nodes[j].nextNodes) {
-                        if (nextIndex == static_cast<int>(i)) {
-                            if (std::find(activeNodes.begin(), activeNodes.end(), i) == activeNodes.end()) {
-                                activeNodes.push_back(i);
-                                std::cout << "Unlocked " << nodes[i].label << "\n";
-                            }
-                        }
-                    }
-                }
-            }
+        std::cout << "Entering " << mapNode.label << "\n";
+        game->setRewardScene(std::move(scene));
+        game->setState(Game::GameState::REWARD);
+        markNodeAsCompleted(index);
+        lockSiblingNodes(index);
+    }
+}
+
+void GameScene::refreshLayout() {
+    if (!layout.update(game->getWindowWidth(), game->getWindowHeight())) {
+        return;
+    }
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i].setRect(layout.getRect(nodeAnchors[i]));
+    }
+    hitGridDirty = true;
+}
+
+void GameScene::rebuildHitGrid() {
+    std::vector<bool> clickable(nodes.size(), false);
+    for (int index : activeNodes) {
+        if (index >= 0 && index < static_cast<int>(nodes.size())) clickable[index] = true;
+    }
+    for (int index : lockedNodes) {
+        if (index >= 0 && index < static_cast<int>(nodes.size())) clickable[index] = false;
+    }
+
+    nodeHitGrid.reset(game->getWindowWidth(), game->getWindowHeight());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (clickable[i] && !nodes[i].isCompleted) {
+            nodeHitGrid.insert(static_cast<int>(i), nodes[i].rect, static_cast<int>(i));
+        }
+    }
+    nodeHitGrid.build();
+    hitGridDirty = false;
+}
+
+void GameScene::updateActiveNodes() {
+    std::vector<int> previousActiveNodes = activeNodes;
+    activeNodes = graph.getAvailableNodes(game->completedNodes, lockedNodes);
+    for (int index : activeNodes) {
+        if (std::find(previousActiveNodes.begin(), previousActiveNodes.end(), index) == previousActiveNodes.end()) {
+            std::cout << "Unlocked " << nodes[index].label << "\n";
         }
     }
 
@@ -219,6 +187,7 @@ void GameScene::updateActiveNodes() {
         std::cout << idx << " ";
     }
     std::cout << "\nCurrent node index: " << currentNodeIndex << "\n";
+    hitGridDirty = true;
 }
 
 void GameScene::markNodeAsCompleted(int nodeIndex) {
@@ -226,27 +195,23 @@ void GameScene::markNodeAsCompleted(int nodeIndex) {
         nodes[nodeIndex].isCompleted = true;
         nodes[nodeIndex].opacity = 0.5f;
         game->completedNodes[nodeIndex] = true;
+        hitGridDirty = true;
         std::cout << "Completed " << nodes[nodeIndex].label << "\n";
     }
 }
 
 void GameScene::lockSiblingNodes(int completedNodeIndex) {
-    if (completedNodeIndex == 2) { // Troll node
-        activeNodes.erase(
-            std::remove(activeNodes.begin(), activeNodes.end(), 1),
-            activeNodes.end()
-        );
-        if (std::find(lockedNodes.begin(), lockedNodes.end(), 1) == lockedNodes.end()) {
-            lockedNodes.push_back(1); // Lock Green Reward
-        }
+    hitGridDirty = true;
+    if (completedNodeIndex < 0 || completedNodeIndex >= graph.getNodeCount()) {
+        return;
     }
-    else if (completedNodeIndex == 1) { // Green Reward node
+    for (int sibling : graph.getNode(completedNodeIndex).locks) {
         activeNodes.erase(
-            std::remove(activeNodes.begin(), activeNodes.end(), 2),
+            std::remove(activeNodes.begin(), activeNodes.end(), sibling),
             activeNodes.end()
         );
-        if (std::find(lockedNodes.begin(), lockedNodes.end(), 2) == lockedNodes.end()) {
-            lockedNodes.push_back(2); // Lock Troll
+        if (std::find(lockedNodes.begin(), lockedNodes.end(), sibling) == lockedNodes.end()) {
+            lockedNodes.push_back(sibling);
         }
     }
 }
@@ -264,6 +229,8 @@ void GameScene::unlockNextNode() {
 }
 
 void GameScene::render() {
+    refreshLayout();
+
     SDL_SetRenderDrawColor(renderer, 240, 240, 240, 255);
     SDL_RenderClear(renderer);
 
@@ -277,7 +244,7 @@ void GameScene::render() {
                 int startY = node.rect.y + node.rect.h / 2;
                 int endX = nextNode.rect.x + nextNode.rect.w / 2;
                 int endY = nextNode.rect.y + nextNode.rect.h / 2;
-                SDL_RenderDrawLine(renderer, startX, startY, endX, endY);
+                RenderStats::drawLine(renderer, startX, startY, endX, endY);
             }
         }
     }
@@ -286,20 +253,47 @@ void GameScene::render() {
         const Node& node = nodes[i];
         node.render();
     }
+}
 
-    SDL_RenderPresent(renderer);
+void GameScene::update(Uint32 now) {
+    if (gameOver) {
+        return;
+    }
+    // One build per frame, the hovered node first, so no map frame pays for more
+    // than the click itself used to.
+    int next = -1;
+    for (int index : activeNodes) {
+        if (prewarmed[index] || nodes[index].isCompleted) {
+            continue;
+        }
+        if (next < 0 || index == hoveredNode) {
+            next = index;
+        }
+    }
+    if (next >= 0) {
+        prewarmed[next] = buildNodeScene(next);
+    }
 }
 
 void GameScene::handleEvent(SDL_Event& e) {
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        bool isActive = std::find(activeNodes.begin(), activeNodes.end(), i) != activeNodes.end();
-        bool isLocked = std::find(lockedNodes.begin(), lockedNodes.end(), i) != lockedNodes.end();
-        if (isActive && !isLocked && !nodes[i].isCompleted) {
-            if (nodes[i].handleEvent(e)) {
-                currentNodeIndex = static_cast<int>(i);
-                game->currentNodeIndex = currentNodeIndex;
-                break;
-            }
+    refreshLayout();
+    if (e.type == SDL_MOUSEMOTION) {
+        if (hitGridDirty) {
+            rebuildHitGrid();
         }
+        hoveredNode = nodeHitGrid.query(e.motion.x, e.motion.y);
+        return;
+    }
+    if (e.type != SDL_MOUSEBUTTONDOWN || e.button.button != SDL_BUTTON_LEFT) {
+        return;
+    }
+    if (hitGridDirty) {
+        rebuildHitGrid();
+    }
+
+    int hit = nodeHitGrid.query(e.button.x, e.button.y);
+    if (hit >= 0 && nodes[hit].handleEvent(e)) {
+        currentNodeIndex = hit;
+        game->currentNodeIndex = currentNodeIndex;
     }
 }
\ No newline at end of file
@@ -3,35 +3,46 @@
 #include <iostream>
 
 MenuScene::MenuScene(SDL_Renderer* renderer, TTF_Font* font, Game* game)
-    : renderer(renderer), font(font), game(game) {
+    : renderer(renderer), font(font), game(game),
+    buttonColumn(layout.addFlex(LayoutFlex(LayoutAnchor(0.5f, 0.0f, 0.5f, 0.0f, 0, 200), FlexDirection::Column, 200, 50, 50), 4)) {
     buttons.emplace_back(
-        (game->getWindowWidth() - 200) / 2, 200, 200, 50, "Play", font, renderer,
+        0, 0, 200, 50, "Play", font, renderer,
         [this]() {
             std::cout << "Play button clicked\n";
             this->game->setState(Game::GameState::DECK_SELECTION);
         }
     );
     buttons.emplace_back(
-        (game->getWindowWidth() - 200) / 2, 300, 200, 50, "Load/Continue", font, renderer,
+        0, 0, 200, 50, "Load/Continue", font, renderer,
         []() {
             std::cout << "Load/Continue button clicked (not implemented)\n";
         }
     );
     buttons.emplace_back(
-        (game->getWindowWidth() - 200) / 2, 400, 200, 50, "Options", font, renderer,
+        0, 0, 200, 50, "Options", font, renderer,
         [this]() {
             std::cout << "Options button clicked\n";
             this->game->setState(Game::GameState::OPTIONS);
         }
     );
     buttons.emplace_back(
-        (game->getWindowWidth() - 200) / 2, 500, 200, 50, "Quit", font, renderer,
+        0, 0, 200, 50, "Quit", font, renderer,
         [this]() {
             std::cout << "Quit button clicked\n";
             this->game->clean();
             exit(0);
         }
     );
+    refreshLayout();
+}
+
+void MenuScene::refreshLayout() {
+    if (!layout.update(game->getWindowWidth(), game->getWindowHeight())) {
+        return;
+    }
+    for (size_t i = 0; i < buttons.size(); ++i) {
+        buttons[i].setRect(layout.getItemRect(buttonColumn, static_cast<int>(i)));
+    }
 }
 
 void MenuScene::setRenderer(SDL_Renderer* newRenderer) {
@@ -49,18 +60,26 @@ void MenuScene::setFont(TTF_Font* newFont) {
 }
 
 void MenuScene::render() {
+    refreshLayout();
+
     SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
     SDL_RenderClear(renderer);
 
     for (auto& button : buttons) {
         button.render();
     }
-
-    SDL_RenderPresent(renderer);
 }
 
 void MenuScene::handleEvent(SDL_Event& e) {
+    refreshLayout();
     for (auto& button : buttons) {
         button.handleEvent(e);
     }
+}
+
+void MenuScene::handleAction(InputAction action) {
+    if (action == InputAction::StressTest) {
+        std::cout << "Starting render stress test\n";
+        game->setState(Game::GameState::STRESS_TEST);
+    }
 }
\ No newline at end of file
@@ -1,9 +1,12 @@
 #include "../includes/scenes/OptionsScene.h"
 #include "../includes/core/Game.h"
+#include "../includes/common/Constants.h"
 #include <iostream>
+#include <iterator>
 
 OptionsScene::OptionsScene(SDL_Renderer* renderer, TTF_Font* font, Game* game)
-    : renderer(renderer), font(font), game(game), fullScreenButton(nullptr) {
+    : renderer(renderer), font(font), game(game), fullScreenButton(nullptr),
+    buttonColumn(layout.addFlex(LayoutFlex(LayoutAnchor(0.5f, 0.0f, 0.5f, 0.0f, 0, 150), FlexDirection::Column, 200, 50, 50), 5)) {
     initializeButtons();
 }
 
@@ -24,38 +27,24 @@ void OptionsScene::setFont(TTF_Font* newFont) {
 
 void OptionsScene::initializeButtons() {
     buttons.clear();
+    buttons.reserve(std::size(Constants::RESOLUTIONS) + 2); // fullScreenButton points into this vector
     int buttonWidth = 200;
     int buttonHeight = 50;
-    int centerX = (game->getWindowWidth() - buttonWidth) / 2;
 
-    buttons.emplace_back(
-        centerX, 200, buttonWidth, buttonHeight, "800x600", font, renderer,
-        [this]() {
-            std::cout << "Set resolution to 800x600\n";
-            game->setResolution(800, 600);
-            initializeButtons();
-        }
-    );
-    buttons.emplace_back(
-        centerX, 300, buttonWidth, buttonHeight, "1200x800", font, renderer,
-        [this]() {
-            std::cout << "Set resolution to 1200x800\n";
-            game->setResolution(1200, 800);
-            initializeButtons();
-        }
-    );
-    buttons.emplace_back(
-        centerX, 400, buttonWidth, buttonHeight, "1920x1080", font, renderer,
-        [this]() {
-            std::cout << "Set resolution to 1920x1080\n";
-            game->setResolution(1920, 1080);
-            initializeButtons();
-        }
-    );
+    for (const Constants::Resolution& resolution : Constants::RESOLUTIONS) {
+        std::string label = std::to_string(resolution.width) + "x" + std::to_string(resolution.height);
+        buttons.emplace_back(
+            0, 0, buttonWidth, buttonHeight, label, font, renderer,
+            [this, resolution, label]() {
+                std::cout << "Set resolution to " << label << "\n";
+                game->setResolution(resolution.width, resolution.height);
+            }
+        );
+    }
 
     std::string fullScreenText = game->isFullScreen() ? "Windowed" : "Full Screen";
     buttons.emplace_back(
-        centerX, 500, buttonWidth, buttonHeight, fullScreenText, font, renderer,
+        0, 0, buttonWidth, buttonHeight, fullScreenText, font, renderer,
         [this]() {
             std::cout << "Toggling full-screen mode\n";
             game->setFullScreen(!game->isFullScreen());
@@ -65,40 +54,53 @@ void OptionsScene::initializeButtons() {
     fullScreenButton = &buttons.back();
 
     buttons.emplace_back(
-        centerX, 600, buttonWidth, buttonHeight, "Back", font, renderer,
+        0, 0, buttonWidth, buttonHeight, "Back", font, renderer,
         [this]() {
             std::cout << "Returning to menu\n";
             game->setState(Game::GameState::MENU);
         }
     );
+
+    layout.invalidate();
+    refreshLayout();
+}
+
+void OptionsScene::refreshLayout() {
+    if (!layout.update(game->getWindowWidth(), game->getWindowHeight())) {
+        return;
+    }
+    for (size_t i = 0; i < buttons.size(); ++i) {
+        buttons[i].setRect(layout.getItemRect(buttonColumn, static_cast<int>(i)));
+    }
 }
 
 void OptionsScene::updateFullScreenButton() {
     if (fullScreenButton) {
         std::string fullScreenText = game->isFullScreen() ? "Windowed" : "Full Screen";
         fullScreenButton->updateText(fullScreenText, font, renderer);
-        int buttonWidth = 200;
-        int buttonHeight = 50;
-        int centerX = (game->getWindowWidth() - buttonWidth) / 2;
-        for (size_t i = 0; i < buttons.size(); ++i) {
-            buttons[i].setPosition(centerX, 150 + i * 100);
-        }
     }
 }
 
 void OptionsScene::render() {
+    refreshLayout();
+
     SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
     SDL_RenderClear(renderer);
 
     for (auto& button : buttons) {
         button.render();
     }
-
-    SDL_RenderPresent(renderer);
 }
 
 void OptionsScene::handleEvent(SDL_Event& e) {
+    refreshLayout();
     for (auto& button : buttons) {
         button.handleEvent(e);
     }
+}
+
+void OptionsScene::handleAction(InputAction action) {
+    if (action == InputAction::Back) {
+        game->setState(Game::GameState::MENU);
+    }
 }
\ No newline at end of file
@@ -2,28 +2,43 @@
 #include "../includes/common/Constants.h"
 #include "../includes/core/Game.h"
 #include "../includes/scenes/GameScene.h"
+#include "../includes/simulation/DeckStatistics.h"
+#include "../includes/simulation/MapGraph.h"
+#include "../includes/systems/RenderStats.h"
+#include "../includes/systems/MemoryStats.h"
+#include <iomanip>
 #include <random>
 #include <iostream>
+#include <sstream>
 
 RewardScene::RewardScene(SDL_Renderer* renderer, TTF_Font* font, Game* game, RewardType rewardType)
-    : renderer(renderer), font(font), game(game), rewardType(rewardType), skipButtonTexture(nullptr) {
+    : renderer(renderer), font(font), game(game), rewardType(rewardType), skipButtonRect{ 0, 0, 0, 0 }, skipButtonTexture(nullptr),
+    cardRow(layout.addFlex(LayoutFlex(
+        LayoutAnchor(0.5f, 0.0f, 0.0f, 0.0f, Constants::REWARD_CARD_BASE_X - Constants::DEFAULT_WINDOW_WIDTH / 2, Constants::REWARD_CARD_Y),
+        FlexDirection::Row, Constants::CARD_WIDTH, Constants::CARD_HEIGHT, Constants::REWARD_CARD_SPACING - Constants::CARD_WIDTH), 0)),
+    skipAnchor(layout.addAnchor(LayoutAnchor(0.5f, 1.0f, 0.5f, 0.0f, 0, -150))),
+    previewResults(std::make_shared<TripleBuffer<std::vector<std::string>>>()) {
     initializeRewardCards();
+    requestPreviewLines();
     createSkipButton();
+    refreshLayout();
 }
 
 RewardScene::~RewardScene() {
     if (skipButtonTexture) {
-        SDL_DestroyTexture(skipButtonTexture);
+        MemoryStats::destroyTexture(skipButtonTexture);
     }
+    destroyPreviewTextures();
 }
 
 void RewardScene::setRenderer(SDL_Renderer* newRenderer) {
     renderer = newRenderer;
     if (skipButtonTexture) {
-        SDL_DestroyTexture(skipButtonTexture);
+        MemoryStats::destroyTexture(skipButtonTexture);
         skipButtonTexture = nullptr;
     }
     createSkipButton();
+    createPreviewTextures();
 }
 
 void RewardScene::setFont(TTF_Font* newFont) {
@@ -31,81 +46,105 @@ void RewardScene::setFont(TTF_Font* newFont) {
     for (auto& card : rewardCards) {
         card.setFont(font);
     }
+    createPreviewTextures();
 }
 
 void RewardScene::initializeRewardCards() {
     rewardCards.clear();
     cardRects.clear();
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    std::mt19937 gen(static_cast<std::mt19937::result_type>(game->nextSeed()));
+    for (int index : CardLibrary::rollRewardOffer(rewardType, gen)) {
+        rewardCards.push_back(game->getPoolCard(index));
+    }
 
-    for (int i = 0; i < 3; ++i) {
-        Game::CardRarity maxRarity = (rewardType == RewardType::Green) ? Game::CardRarity::Rare : Game::CardRarity::Epic;
-        Game::CardRarity rarity = Game::CardRarity::Common;
-        std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-        float roll = dist(gen);
+    cardRects.resize(rewardCards.size());
+    layout.setItemCount(cardRow, static_cast<int>(rewardCards.size()));
+}
 
-        if (rewardType == RewardType::Green) {
-            if (roll < Constants::RARITY_PROBABILITY_THRESHOLD) {
-                rarity = Game::CardRarity::Rare;
-            }
-        }
-        else if (rewardType == RewardType::Purple) {
-            if (roll < Constants::RARITY_PROBABILITY_THRESHOLD) {
-                rarity = Game::CardRarity::Epic;
-            }
-            else {
-                roll = dist(gen);
-                if (roll < Constants::RARITY_PROBABILITY_THRESHOLD) {
-                    rarity = Game::CardRarity::Rare;
-                }
-            }
-        }
+void RewardScene::requestPreviewLines() {
+    std::vector<CardSpec> cards;
+    for (const auto& card : game->getSelectedDeck()) {
+        cards.push_back(CardSpec(card.getName(), card.getDamage(), card.getEnergyCost(), card.getEffect()));
+    }
+    std::vector<CardSpec> offer;
+    for (const auto& card : rewardCards) {
+        offer.push_back(CardSpec(card.getName(), card.getDamage(), card.getEnergyCost(), card.getEffect()));
+    }
 
-        std::vector<Card> possibleCards = game->getRewardCards(maxRarity, 1);
-        if (!possibleCards.empty()) {
-            std::vector<Card> filteredCards;
-            for (const auto& card : possibleCards) {
-                Game::CardRarity cardRarity = Game::CardRarity::Common;
-                std::string name = card.getName();
-                if (name == "Lightning Strike" || name == "Ice Shard" || name == "Superb Shield") {
-                    cardRarity = Game::CardRarity::Rare;
-                }
-                else if (name == "Dragon's Breath") {
-                    cardRarity = Game::CardRarity::Epic;
-                }
-                if (cardRarity == rarity) {
-                    filteredCards.push_back(card);
-                }
-            }
+    // The offer is fixed for the scene's lifetime, so each deck is analysed once,
+    // off the main thread, and the lines show up when the analysis is done.
+    std::shared_ptr<TripleBuffer<std::vector<std::string>>> results = previewResults;
+    game->getSimulation().post([cards, offer, results]() mutable {
+        const EncounterDef* toughest = MapGraph::createDefault().getToughestEncounter();
+        std::vector<int> enemyHP;
+        if (toughest) {
+            enemyHP.push_back(toughest->hp);
+        }
 
-            if (filteredCards.empty()) {
-                for (const auto& card : possibleCards) {
-                    Game::CardRarity cardRarity = Game::CardRarity::Common;
-                    std::string name = card.getName();
-                    if (name == "Lightning Strike" || name == "Ice Shard" || name == "Superb Shield") {
-                        cardRarity = Game::CardRarity::Rare;
-                    }
-                    else if (name == "Dragon's Breath") {
-                        cardRarity = Game::CardRarity::Epic;
-                    }
-                    if (cardRarity == Game::CardRarity::Common) {
-                        filteredCards.push_back(card);
+        std::vector<std::string>& lines = results->getWriteBuffer();
+        lines.assign(offer.size(), "");
+        DeckReport current;
+        if (DeckStatistics::analyze(CardLibrary::buildCombatDeck(cards), enemyHP, DeckStatistics::DEFAULT_TURNS, current)) {
+            for (size_t i = 0; i < offer.size(); ++i) {
+                cards.push_back(offer[i]);
+                DeckReport withCard;
+                if (DeckStatistics::analyze(CardLibrary::buildCombatDeck(cards), enemyHP, DeckStatistics::DEFAULT_TURNS, withCard)) {
+                    std::ostringstream line;
+                    line << std::showpos << std::fixed << std::setprecision(1)
+                        << withCard.getMeanDamagePerTurn() - current.getMeanDamagePerTurn() << " dmg "
+                        << withCard.getMeanArmorPerTurn() - current.getMeanArmorPerTurn() << " armor";
+                    if (toughest) {
+                        line << " " << withCard.getExpectedTurnsToKill(0) - current.getExpectedTurnsToKill(0) << " turns";
                     }
+                    lines[i] = line.str();
                 }
+                cards.pop_back();
             }
+        }
+        results->publish();
+    });
+}
+
+void RewardScene::update(Uint32 now) {
+    if (previewResults->update()) {
+        previewLines = previewResults->getReadBuffer();
+        createPreviewTextures();
+    }
+}
 
-            if (!filteredCards.empty()) {
-                Card card = filteredCards[0];
-                card.setPosition(Constants::REWARD_CARD_BASE_X + i * Constants::REWARD_CARD_SPACING, Constants::REWARD_CARD_Y);
-                rewardCards.push_back(card);
+void RewardScene::createPreviewTextures() {
+    destroyPreviewTextures();
+    SDL_Color textColor = { 0, 0, 0, 255 };
+    for (const std::string& line : previewLines) {
+        SDL_Texture* texture = nullptr;
+        SDL_Surface* surface = line.empty() ? nullptr : TTF_RenderText_Solid(font, line.c_str(), textColor);
+        if (surface) {
+            texture = MemoryStats::createTextureFromSurface(renderer, surface);
+            SDL_FreeSurface(surface);
+        }
+        previewTextures.push_back(texture);
+    }
+}
 
-                SDL_Rect cardRect = { Constants::REWARD_CARD_BASE_X + i * Constants::REWARD_CARD_SPACING, Constants::REWARD_CARD_Y, Constants::CARD_WIDTH, Constants::CARD_HEIGHT };
-                cardRects.push_back(cardRect);
-            }
+void RewardScene::destroyPreviewTextures() {
+    for (SDL_Texture* texture : previewTextures) {
+        if (texture) {
+            MemoryStats::destroyTexture(texture);
         }
     }
+    previewTextures.clear();
+}
+
+void RewardScene::refreshLayout() {
+    if (!layout.update(game->getWindowWidth(), game->getWindowHeight())) {
+        return;
+    }
+    for (size_t i = 0; i < rewardCards.size(); ++i) {
+        cardRects[i] = layout.getItemRect(cardRow, static_cast<int>(i));
+        rewardCards[i].setRect(cardRects[i]);
+    }
+    skipButtonRect = layout.placeContent(skipAnchor, skipButtonRect.w, skipButtonRect.h);
 }
 
 void RewardScene::createSkipButton() {
@@ -116,20 +155,19 @@ void RewardScene::createSkipButton() {
         return;
     }
 
-    skipButtonTexture = SDL_CreateTextureFromSurface(renderer, surface);
+    skipButtonTexture = MemoryStats::createTextureFromSurface(renderer, surface);
     if (!skipButtonTexture) {
         std::cerr << "Failed to create texture for Skip button: " << SDL_GetError() << std::endl;
     }
 
-    skipButtonRect.w = surface->w;
-    skipButtonRect.h = surface->h;
-    skipButtonRect.x = (game->getWindowWidth() - skipButtonRect.w) / 2;
-    skipButtonRect.y = game->getWindowHeight() - 150; // Adjust position dynamically
+    skipButtonRect = layout.placeContent(skipAnchor, surface->w, surface->h);
 
     SDL_FreeSurface(surface);
 }
 
 void RewardScene::render() {
+    refreshLayout();
+
     SDL_SetRenderDrawColor(renderer, 240, 240, 240, 255);
     SDL_RenderClear(renderer);
 
@@ -138,21 +176,27 @@ void RewardScene::render() {
         card.render(renderer, 999, game->getWindowWidth(), game->getWindowHeight());
 
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderDrawRect(renderer, &cardRects[i]);
+        RenderStats::drawRect(renderer, &cardRects[i]);
+
+        if (i < previewTextures.size() && previewTextures[i]) {
+            SDL_Rect textRect = { 0, cardRects[i].y + cardRects[i].h + 10, 0, 0 };
+            SDL_QueryTexture(previewTextures[i], nullptr, nullptr, &textRect.w, &textRect.h);
+            textRect.x = cardRects[i].x + (cardRects[i].w - textRect.w) / 2;
+            RenderStats::copy(renderer, previewTextures[i], nullptr, &textRect);
+        }
     }
 
     if (skipButtonTexture) {
         SDL_SetRenderDrawColor(renderer, 200, 200, 200, 255);
-        SDL_RenderFillRect(renderer, &skipButtonRect);
+        RenderStats::fillRect(renderer, &skipButtonRect);
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderDrawRect(renderer, &skipButtonRect);
-        SDL_RenderCopy(renderer, skipButtonTexture, nullptr, &skipButtonRect);
+        RenderStats::drawRect(renderer, &skipButtonRect);
+        RenderStats::copy(renderer, skipButtonTexture, nullptr, &skipButtonRect);
     }
-
-    SDL_RenderPresent(renderer);
 }
 
 void RewardScene::handleEvent(SDL_Event& e) {
+    refreshLayout();
     if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) {
         int x = e.button.x;
         int y = e.button.y;
@@ -173,4 +217,10 @@ void RewardScene::handleEvent(SDL_Event& e) {
             return;
         }
     }
+}
+
+void RewardScene::handleAction(InputAction action) {
+    if (action == InputAction::Back) { // Escape skips the reward
+        game->setState(Game::GameState::GAME);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,195 @@
+#include "../includes/scenes/StressTestScene.h"
+#include "../includes/common/Constants.h"
+#include "../includes/core/Game.h"
+#include "../includes/simulation/CombatState.h"
+#include "../includes/systems/RenderStats.h"
+#include "../includes/systems/FrameArena.h"
+#include "../includes/systems/MemoryStats.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+
+namespace {
+    constexpr int NODE_SIZE = 40;
+    constexpr int NODE_LABEL_SPACE = 30;
+    constexpr int STEP_COUNT = static_cast<int>(std::size(StressTestScene::STEPS));
+}
+
+StressTestScene::StressTestScene(SDL_Renderer* renderer, TTF_Font* font, Game* game)
+    : renderer(renderer), font(font), game(game), step(0), frames(0), lastFrameStart(0), totals{},
+    resultsText(nullptr), resultsRect{ 10, 0, 0, 0 } {
+    restart();
+}
+
+StressTestScene::~StressTestScene() {
+    if (resultsText) {
+        MemoryStats::destroyTexture(resultsText);
+    }
+}
+
+void StressTestScene::restart() {
+    results.clear();
+    step = 0;
+    spawn(STEPS[0]);
+    updateResultsText();
+}
+
+void StressTestScene::spawn(int elements) {
+    cards.clear();
+    nodes.clear();
+    frames = 0;
+    lastFrameStart = 0;
+    totals = StepResult{ elements, 0.0, 0.0, 0.0, 0.0 };
+
+    int width = game->getWindowWidth();
+    int height = game->getWindowHeight();
+    std::mt19937 rng(1); // the same layout on every run, so steps compare
+    std::uniform_int_distribution<int> cardX(0, std::max(0, width - Constants::CARD_WIDTH));
+    std::uniform_int_distribution<int> cardY(0, std::max(0, height - Constants::CARD_HEIGHT));
+    std::uniform_int_distribution<int> nodeX(0, std::max(0, width - NODE_SIZE));
+    std::uniform_int_distribution<int> nodeY(0, std::max(0, height - NODE_SIZE - NODE_LABEL_SPACE));
+
+    TTF_Font* magnifiedFont = game->getFont(static_cast<int>(Constants::FONT_SIZE * Constants::CARD_MAGNIFICATION_SCALE));
+    int poolSize = static_cast<int>(CardLibrary::getCardPool().size());
+    int cardCount = elements / 2;
+    cards.reserve(cardCount);
+    for (int i = 0; i < cardCount; ++i) {
+        Card card = game->getPoolCard(i % poolSize);
+        card.setMagnifiedFont(magnifiedFont);
+        card.placeAt(SDL_Rect{ cardX(rng), cardY(rng), Constants::CARD_WIDTH, Constants::CARD_HEIGHT });
+        card.setMagnified(i % 4 == 3);
+        cards.push_back(std::move(card));
+    }
+
+    int nodeCount = elements - cardCount;
+    nodes.reserve(nodeCount);
+    for (int i = 0; i < nodeCount; ++i) {
+        SDL_Color color = (i % 3 == 0) ? SDL_Color{ 255, 0, 0, 255 } : (i % 3 == 1) ? SDL_Color{ 0, 0, 255, 255 } : SDL_Color{ 128, 0, 128, 255 };
+        int x = nodeX(rng);
+        int y = nodeY(rng);
+        nodes.emplace_back(x, y, NODE_SIZE, "Node " + std::to_string(i), (i % 2) ? 0.5f : 1.0f, renderer, font,
+            nullptr, NodeType::Fight, color);
+    }
+}
+
+void StressTestScene::finishStep() {
+    StepResult result = totals;
+    result.frameMs /= SAMPLE_FRAMES;
+    result.renderMs /= SAMPLE_FRAMES;
+    result.drawCalls /= SAMPLE_FRAMES;
+    result.textureSwitches /= SAMPLE_FRAMES;
+    results.push_back(result);
+    std::cout << "Stress test " << result.elements << " widgets: " << std::fixed << std::setprecision(2)
+        << result.frameMs << " ms/frame, " << result.renderMs << " ms in render, " << std::setprecision(0)
+        << result.drawCalls << " draw calls, " << result.textureSwitches << " texture switches\n";
+
+    ++step;
+    if (step < STEP_COUNT) {
+        spawn(STEPS[step]);
+    }
+    updateResultsText();
+}
+
+void StressTestScene::updateResultsText() {
+    if (resultsText) {
+        MemoryStats::destroyTexture(resultsText);
+        resultsText = nullptr;
+    }
+    if (!renderer || !font) {
+        return;
+    }
+
+    FrameText text;
+    text << "Widgets  ms/frame  render ms  draw calls  switches";
+    for (const StepResult& result : results) {
+        text << "\n" << result.elements << "  ";
+        text.fixed(result.frameMs, 2) << "  ";
+        text.fixed(result.renderMs, 2) << "  ";
+        text.fixed(result.drawCalls, 0) << "  ";
+        text.fixed(result.textureSwitches, 0);
+    }
+    if (step < STEP_COUNT) {
+        text << "\nMeasuring " << STEPS[step] << " widgets...";
+    }
+    else {
+        text << "\nDone. Enter restarts, Esc returns to the menu.";
+    }
+
+    SDL_Color textColor = { 0, 0, 0, 255 };
+    SDL_Surface* surface = TTF_RenderText_Blended_Wrapped(font, text.c_str(), textColor, 700);
+    if (!surface) {
+        std::cerr << "Failed to create surface for stress test results: " << TTF_GetError() << std::endl;
+        return;
+    }
+    resultsText = MemoryStats::createTextureFromSurface(renderer, surface);
+    resultsRect.w = surface->w;
+    resultsRect.h = surface->h;
+    resultsRect.y = game->getWindowHeight() - surface->h - 10;
+    SDL_FreeSurface(surface);
+}
+
+void StressTestScene::update(Uint32 now) {
+    if (step < STEP_COUNT && frames >= WARMUP_FRAMES + SAMPLE_FRAMES) {
+        finishStep();
+    }
+}
+
+void StressTestScene::render() {
+    double ticksPerMs = SDL_GetPerformanceFrequency() / 1000.0;
+    Uint64 start = SDL_GetPerformanceCounter();
+    RenderStats::Frame before = RenderStats::current();
+
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    SDL_RenderClear(renderer);
+
+    int width = game->getWindowWidth();
+    int height = game->getWindowHeight();
+    for (const Node& node : nodes) {
+        node.render();
+    }
+    for (size_t i = 0; i < cards.size(); ++i) {
+        cards[i].render(renderer, (i % 2) ? 0 : CombatState::PLAYER_MAX_ENERGY, width, height);
+    }
+
+    Uint64 end = SDL_GetPerformanceCounter();
+    const RenderStats::Frame& after = RenderStats::current();
+    if (step < STEP_COUNT && frames >= WARMUP_FRAMES) {
+        totals.frameMs += (start - lastFrameStart) / ticksPerMs;
+        totals.renderMs += (end - start) / ticksPerMs;
+        totals.drawCalls += after.drawCalls - before.drawCalls;
+        totals.textureSwitches += after.textureSwitches - before.textureSwitches;
+    }
+    lastFrameStart = start;
+    ++frames;
+
+    if (resultsText) {
+        SDL_Rect background = { resultsRect.x - 4, resultsRect.y - 4, resultsRect.w + 8, resultsRect.h + 8 };
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 220);
+        RenderStats::fillRect(renderer, &background);
+        RenderStats::copy(renderer, resultsText, nullptr, &resultsRect);
+    }
+}
+
+void StressTestScene::handleAction(InputAction action) {
+    if (action == InputAction::Back) {
+        game->setState(Game::GameState::MENU);
+    }
+    else if (action == InputAction::Confirm) {
+        restart();
+    }
+}
+
+void StressTestScene::setRenderer(SDL_Renderer* newRenderer) {
+    renderer = newRenderer;
+    spawn(STEPS[std::min(step, STEP_COUNT - 1)]);
+    updateResultsText();
+}
+
+void StressTestScene::setFont(TTF_Font* newFont) {
+    font = newFont;
+    spawn(STEPS[std::min(step, STEP_COUNT - 1)]);
+    updateResultsText();
+}
\ No newline at end of file
@@ -0,0 +1,559 @@
+#include "../includes/simulation/BatchCombat.h"
+#include <algorithm>
+#include <chrono>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+#if defined(__AVX2__)
+    constexpr int LANES = BatchCombat::LANES;
+
+    // Lane-wise int32 arithmetic. Masks are all ones in a selected lane and zero
+    // elsewhere, so "x & mask" zeroes the unselected lanes and "x - mask" adds one
+    // to the selected ones.
+    struct Vec { __m256i v; };
+
+    inline Vec load(const std::int32_t* p) { return { _mm256_load_si256(reinterpret_cast<const __m256i*>(p)) }; }
+    inline void store(std::int32_t* p, Vec a) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), a.v); }
+    inline Vec splat(int x) { return { _mm256_set1_epi32(x) }; }
+    inline Vec operator+(Vec a, Vec b) { return { _mm256_add_epi32(a.v, b.v) }; }
+    inline Vec operator-(Vec a, Vec b) { return { _mm256_sub_epi32(a.v, b.v) }; }
+    inline Vec operator&(Vec a, Vec b) { return { _mm256_and_si256(a.v, b.v) }; }
+    inline Vec operator|(Vec a, Vec b) { return { _mm256_or_si256(a.v, b.v) }; }
+    inline Vec andNot(Vec mask, Vec a) { return { _mm256_andnot_si256(mask.v, a.v) }; }
+    inline Vec min(Vec a, Vec b) { return { _mm256_min_epi32(a.v, b.v) }; }
+    inline Vec max(Vec a, Vec b) { return { _mm256_max_epi32(a.v, b.v) }; }
+    inline Vec equal(Vec a, Vec b) { return { _mm256_cmpeq_epi32(a.v, b.v) }; }
+    inline Vec greater(Vec a, Vec b) { return { _mm256_cmpgt_epi32(a.v, b.v) }; }
+    inline Vec select(Vec mask, Vec a, Vec b) { return { _mm256_blendv_epi8(b.v, a.v, mask.v) }; }
+    // Scalar loads beat vpgatherdd on several common cores, and this is only used for pile slots.
+    inline Vec gather(const std::int32_t* table, Vec index) {
+        alignas(32) std::int32_t indices[LANES];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(indices), index.v);
+        return { _mm256_setr_epi32(table[indices[0]], table[indices[1]], table[indices[2]], table[indices[3]],
+            table[indices[4]], table[indices[5]], table[indices[6]], table[indices[7]]) };
+    }
+    // Table lookup held in registers: one permute per block of eight entries.
+    inline Vec lookup(const std::int32_t* table, int blocks, Vec index) {
+        Vec result = { _mm256_permutevar8x32_epi32(_mm256_load_si256(reinterpret_cast<const __m256i*>(table)), index.v) };
+        for (int block = 1; block < blocks; ++block) {
+            __m256i entries = _mm256_load_si256(reinterpret_cast<const __m256i*>(table + block * LANES));
+            Vec fromBlock = { _mm256_permutevar8x32_epi32(entries, index.v) };
+            result = select(greater(index, splat(block * LANES - 1)), fromBlock, result);
+        }
+        return result;
+    }
+    inline int bits(Vec mask) { return _mm256_movemask_ps(_mm256_castsi256_ps(mask.v)); }
+    // AVX2 has no scatter; eight plain stores without branches are the next best thing.
+    inline void scatter(std::int32_t* table, Vec index, Vec value) {
+        alignas(32) std::int32_t indices[LANES];
+        alignas(32) std::int32_t values[LANES];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(indices), index.v);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(values), value.v);
+        for (int i = 0; i < LANES; ++i) table[indices[i]] = values[i];
+    }
+
+    // Four lanes of CombatState::random: xorshift64*, keeping bits 32..63 of the
+    // 64-bit product, which AVX2 has to assemble from 32x32 multiplies.
+    inline __m256i randomQuad(__m256i& state, __m256i bound, __m256i advance) {
+        __m256i x = state;
+        x = _mm256_xor_si256(x, _mm256_srli_epi64(x, 12));
+        x = _mm256_xor_si256(x, _mm256_slli_epi64(x, 25));
+        x = _mm256_xor_si256(x, _mm256_srli_epi64(x, 27));
+        state = _mm256_blendv_epi8(state, x, advance);
+
+        const __m256i multiplierLow = _mm256_set1_epi64x(0x4F6CDD1D);
+        const __m256i multiplierHigh = _mm256_set1_epi64x(0x2545F491);
+        __m256i low = _mm256_srli_epi64(_mm256_mul_epu32(x, multiplierLow), 32);
+        __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(x, multiplierHigh),
+            _mm256_mul_epu32(_mm256_srli_epi64(x, 32), multiplierLow));
+        __m256i randomBits = _mm256_add_epi64(low, cross); // only the low 32 bits of each lane are meaningful
+        return _mm256_srli_epi64(_mm256_mul_epu32(randomBits, bound), 32);
+    }
+
+    // CombatState::random(bound) per lane; lanes outside `advance` keep their state.
+    inline Vec randomLanes(std::uint64_t* state, Vec bound, Vec advance) {
+        __m256i* words = reinterpret_cast<__m256i*>(state);
+        __m256i lowWords = _mm256_load_si256(words);
+        __m256i highWords = _mm256_load_si256(words + 1);
+        __m256i low = randomQuad(lowWords, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(bound.v)),
+            _mm256_cvtepi32_epi64(_mm256_castsi256_si128(advance.v)));
+        __m256i high = randomQuad(highWords, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(bound.v, 1)),
+            _mm256_cvtepi32_epi64(_mm256_extracti128_si256(advance.v, 1)));
+        _mm256_store_si256(words, lowWords);
+        _mm256_store_si256(words + 1, highWords);
+
+        const __m256i evenLanes = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+        low = _mm256_permutevar8x32_epi32(low, evenLanes);
+        high = _mm256_permutevar8x32_epi32(high, evenLanes);
+        return { _mm256_permute2x128_si256(low, high, 0x20) };
+    }
+
+    inline int firstLane(int mask) {
+        int lane = 0;
+        while (!((mask >> lane) & 1)) ++lane;
+        return lane;
+    }
+
+    // Card fields by spec id, one table per field. Lookups only read the first
+    // `blocks` groups of eight, so a typical deck's table fits in one register.
+    struct alignas(32) SpecTable {
+        std::int32_t damage[CombatDeck::MAX_SPECS];
+        std::int32_t cost[CombatDeck::MAX_SPECS];
+        std::int32_t effectType[CombatDeck::MAX_SPECS];
+        std::int32_t effectValue[CombatDeck::MAX_SPECS];
+        std::int32_t effectCount[CombatDeck::MAX_SPECS];
+        int blocks;
+    };
+    static_assert(CombatDeck::MAX_SPECS % BatchCombat::LANES == 0, "spec tables are read in whole vectors");
+
+    // One row per field, one column per lane; every row is a full aligned vector.
+    struct alignas(32) Lanes {
+        std::uint64_t rng[LANES];
+        std::int32_t playerHP[LANES];
+        std::int32_t playerArmor[LANES];
+        std::int32_t playerPoison[LANES];
+        std::int32_t playerPoisonTurns[LANES];
+        std::int32_t energy[LANES];
+        std::int32_t enemyHP[LANES];
+        std::int32_t enemyBlock[LANES];
+        std::int32_t enemyStrength[LANES];
+        std::int32_t intent[LANES];
+        std::int32_t damageReduction[LANES];
+        std::int32_t weakenTurns[LANES];
+        std::int32_t poisonDamage[LANES];
+        std::int32_t poisonTurns[LANES];
+        std::int32_t wetTurns[LANES];
+        std::int32_t frozen[LANES];         // mask
+        std::int32_t turn[LANES];
+        std::int32_t active[LANES];         // mask
+        std::int32_t hand[CombatState::MAX_HAND][LANES];
+        std::int32_t handCount[LANES];
+        std::int32_t drawPile[CombatState::MAX_PILE][LANES];
+        std::int32_t drawCount[LANES];
+        std::int32_t discard[CombatState::MAX_PILE][LANES];
+        std::int32_t discardCount[LANES];
+
+        // This step's move. `card` is zero in lanes that are not playing, so table lookups stay in range.
+        std::int32_t playing[LANES];        // mask
+        std::int32_t ending[LANES];         // mask
+        std::int32_t card[LANES];
+    };
+
+    // Offsets of each lane's column in a [slot][LANES] table.
+    alignas(32) const std::int32_t LANE_INDEX[LANES] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    static_assert(LANES == 8, "LANE_INDEX lists one entry per lane");
+
+    inline Vec column(Vec slot) {
+        Vec twice = slot + slot;
+        Vec fourTimes = twice + twice;
+        return fourTimes + fourTimes + load(LANE_INDEX);
+    }
+
+    inline Vec effectIs(Vec type, CardEffectType effect) {
+        return equal(type, splat(static_cast<int>(effect)));
+    }
+
+    // CombatState::hitEnemy. `damage` is zero in lanes that take no hit.
+    inline void hitEnemy(Vec& enemyHP, Vec& block, Vec damage) {
+        Vec absorbed = min(block, damage);
+        block = block - absorbed;
+        enemyHP = enemyHP - (damage - absorbed);
+    }
+
+    // The MCTS rollout policy for every active lane: a random affordable card,
+    // or end the turn when there is none. The chosen card leaves the hand with the
+    // same stable removal as CombatState::playCard, so later picks see the same order.
+    void chooseKernel(Lanes& lanes, const SpecTable& table) {
+        const Vec zero = splat(0);
+        Vec active = load(lanes.active);
+        Vec energy = load(lanes.energy);
+        Vec handCount = load(lanes.handCount);
+
+        Vec hand[CombatState::MAX_HAND];
+        Vec playable[CombatState::MAX_HAND];
+        Vec count = zero;
+        for (int slot = 0; slot < CombatState::MAX_HAND; ++slot) {
+            hand[slot] = load(lanes.hand[slot]);
+            Vec affordable = andNot(greater(lookup(table.cost, table.blocks, hand[slot]), energy), active);
+            playable[slot] = affordable & greater(handCount, splat(slot));
+            count = count - playable[slot];
+        }
+
+        // Like the scalar engine, a lane with nothing playable draws no random number.
+        Vec playing = greater(count, zero);
+        Vec pick = randomLanes(lanes.rng, count, playing);
+
+        Vec chosenSlot = splat(CombatState::MAX_HAND);
+        Vec card = zero;
+        Vec seen = zero;
+        for (int slot = 0; slot < CombatState::MAX_HAND; ++slot) {
+            Vec hit = playable[slot] & equal(seen, pick);
+            chosenSlot = select(hit, splat(slot), chosenSlot);
+            card = select(hit, hand[slot], card);
+            seen = seen - playable[slot];
+        }
+        for (int slot = 0; slot + 1 < CombatState::MAX_HAND; ++slot) {
+            Vec shift = greater(splat(slot + 1), chosenSlot);
+            store(lanes.hand[slot], select(shift, hand[slot + 1], hand[slot]));
+        }
+
+        // Onto the discard pile. Lanes that are not playing rewrite the slot's own
+        // value; the clamp keeps them inside the pile when it is full.
+        Vec discardCount = load(lanes.discardCount);
+        Vec top = column(min(discardCount, splat(CombatState::MAX_PILE - 1)));
+        std::int32_t* discard = &lanes.discard[0][0];
+        scatter(discard, top, select(playing, card, gather(discard, top)));
+        store(lanes.discardCount, discardCount - playing);
+
+        store(lanes.handCount, handCount + playing);
+        store(lanes.playing, playing);
+        store(lanes.ending, andNot(playing, active));
+        store(lanes.card, card);
+    }
+
+    // CombatState::playCard for every playing lane.
+    void playKernel(Lanes& lanes, const SpecTable& table, int maxStrikes) {
+        const Vec zero = splat(0);
+        Vec playing = load(lanes.playing);
+        Vec card = load(lanes.card);
+        Vec type = lookup(table.effectType, table.blocks, card);
+        Vec value = lookup(table.effectValue, table.blocks, card);
+        Vec count = lookup(table.effectCount, table.blocks, card);
+        Vec wetTurns = load(lanes.wetTurns);
+        Vec wet = greater(wetTurns, zero);
+
+        store(lanes.energy, load(lanes.energy) - (lookup(table.cost, table.blocks, card) & playing));
+        Vec enemyHP = load(lanes.enemyHP);
+        Vec block = load(lanes.enemyBlock);
+        hitEnemy(enemyHP, block, lookup(table.damage, table.blocks, card) & playing);
+
+        Vec armor = playing & effectIs(type, CardEffectType::Armor);
+        store(lanes.playerArmor, load(lanes.playerArmor) + (value & armor));
+
+        Vec heal = playing & effectIs(type, CardEffectType::Heal);
+        Vec playerHP = load(lanes.playerHP);
+        store(lanes.playerHP, select(heal, min(splat(CombatState::PLAYER_MAX_HP), playerHP + value), playerHP));
+
+        // Stops striking a lane once its enemy is dead, like the scalar loop.
+        Vec multiStrike = playing & effectIs(type, CardEffectType::MultiStrike);
+        for (int i = 0; i < maxStrikes; ++i) {
+            Vec strike = multiStrike & greater(count, splat(i)) & greater(enemyHP, zero);
+            hitEnemy(enemyHP, block, value & strike);
+        }
+
+        Vec weaken = playing & effectIs(type, CardEffectType::Weaken);
+        store(lanes.damageReduction, select(weaken, value, load(lanes.damageReduction)));
+        store(lanes.weakenTurns, select(weaken, count, load(lanes.weakenTurns)));
+
+        Vec poison = playing & effectIs(type, CardEffectType::Poison);
+        store(lanes.poisonDamage, select(poison, value, load(lanes.poisonDamage)));
+        store(lanes.poisonTurns, select(poison, count, load(lanes.poisonTurns)));
+
+        Vec thorns = playing & effectIs(type, CardEffectType::Thorns);
+        hitEnemy(enemyHP, block, splat(CombatState::THORNS_DAMAGE) & thorns);
+
+        // A lane plays one card per step, so a Wet card never meets a Lightning or Ice card here.
+        Vec soak = playing & effectIs(type, CardEffectType::Wet);
+        store(lanes.wetTurns, select(soak, count, wetTurns));
+
+        Vec lightning = playing & effectIs(type, CardEffectType::Lightning);
+        hitEnemy(enemyHP, block, (value + (value & wet)) & lightning);
+
+        Vec ice = playing & effectIs(type, CardEffectType::Ice);
+        hitEnemy(enemyHP, block, value & ice);
+        store(lanes.frozen, load(lanes.frozen) | (ice & wet));
+
+        store(lanes.enemyHP, enemyHP);
+        store(lanes.enemyBlock, block);
+    }
+
+    // The enemy's action table and intent weights, as the kernels read them.
+    struct EnemyActions {
+        const EnemyBehavior::Table* actions;
+        int maxHits;
+        int maxHP;
+        bool picks;         // false for a single intent: CombatState draws no random number then
+    };
+
+    // CombatState::enemyAct, updateEffects and pickIntent for every ending lane, then the energy reset.
+    void endTurnKernel(Lanes& lanes, const EnemyActions& enemy) {
+        const Vec zero = splat(0);
+        const EnemyBehavior::Table& actions = *enemy.actions;
+        Vec ending = load(lanes.ending);
+        Vec playerHP = load(lanes.playerHP);
+        Vec enemyHP = load(lanes.enemyHP);
+        Vec frozen = load(lanes.frozen);
+        Vec damageReduction = load(lanes.damageReduction);
+        Vec intent = load(lanes.intent);
+        Vec strength = load(lanes.enemyStrength);
+
+        // Every intent applies all of its table columns; unused ones are zero.
+        Vec attacking = ending & greater(enemyHP, zero) & greater(playerHP, zero);
+        Vec hit = andNot(frozen, attacking);
+        Vec perHit = max(zero, lookup(actions.damage, 1, intent) + strength - damageReduction);
+        Vec hits = lookup(actions.hits, 1, intent);
+        Vec damage = zero;
+        for (int i = 0; i < enemy.maxHits; ++i) {
+            damage = damage + (perHit & greater(hits, splat(i)));
+        }
+        Vec armor = load(lanes.playerArmor);
+        Vec afterArmor = max(zero, damage - armor);
+        store(lanes.playerArmor, select(hit, max(zero, armor - damage), armor));
+        playerHP = playerHP - (afterArmor & hit);
+        store(lanes.frozen, andNot(attacking, frozen)); // a frozen enemy skips this attack and thaws
+        store(lanes.enemyBlock, select(attacking, lookup(actions.block, 1, intent) & hit, load(lanes.enemyBlock)));
+        store(lanes.enemyStrength, strength + (lookup(actions.strength, 1, intent) & hit));
+        Vec poisons = hit & greater(lookup(actions.poisonTurns, 1, intent), zero);
+        Vec playerPoison = select(poisons, lookup(actions.poison, 1, intent), load(lanes.playerPoison));
+        Vec playerPoisonTurns = select(poisons, lookup(actions.poisonTurns, 1, intent), load(lanes.playerPoisonTurns));
+
+        Vec weakenTurns = load(lanes.weakenTurns);
+        Vec weakened = ending & greater(weakenTurns, zero);
+        weakenTurns = weakenTurns + weakened;
+        store(lanes.weakenTurns, weakenTurns);
+        store(lanes.damageReduction, andNot(weakened & equal(weakenTurns, zero), damageReduction));
+
+        Vec poisonTurns = load(lanes.poisonTurns);
+        Vec poisoned = ending & greater(poisonTurns, zero);
+        enemyHP = enemyHP - (load(lanes.poisonDamage) & poisoned);
+        store(lanes.enemyHP, enemyHP);
+        store(lanes.poisonTurns, poisonTurns + poisoned);
+
+        Vec wetTurns = load(lanes.wetTurns);
+        store(lanes.wetTurns, wetTurns + (ending & greater(wetTurns, zero)));
+
+        Vec playerPoisoned = ending & greater(playerPoisonTurns, zero);
+        playerHP = playerHP - (playerPoison & playerPoisoned);
+        store(lanes.playerHP, playerHP);
+        store(lanes.playerPoison, playerPoison);
+        store(lanes.playerPoisonTurns, playerPoisonTurns + playerPoisoned);
+
+        // Next intent: count the row's thresholds at or below a 16-bit roll.
+        if (enemy.picks) {
+            Vec picking = ending & greater(enemyHP, zero) & greater(playerHP, zero);
+            Vec roll = randomLanes(lanes.rng, splat(static_cast<int>(EnemyBehavior::WEIGHT_ONE)), picking);
+            Vec lowHP = greater(splat(enemy.maxHP + 1), enemyHP + enemyHP);
+            Vec row = (splat(EnemyBehavior::MAX_INTENTS + 1) & lowHP) + intent;
+            Vec twice = row + row;
+            Vec fourTimes = twice + twice;
+            Vec rowStart = fourTimes + fourTimes;
+            static_assert(EnemyBehavior::MAX_INTENTS == 8, "rows are addressed as row * 8");
+            Vec next = zero;
+            for (int i = 0; i < EnemyBehavior::MAX_INTENTS; ++i) {
+                Vec threshold = gather(&actions.thresholds[0][0] + i, rowStart);
+                next = next - andNot(greater(threshold, roll), splat(-1));
+            }
+            store(lanes.intent, select(picking, next, intent));
+        }
+
+        store(lanes.energy, select(ending, splat(CombatState::PLAYER_MAX_ENERGY), load(lanes.energy)));
+        store(lanes.turn, load(lanes.turn) - ending);
+    }
+
+    // Lanes whose fight is over or out of turns.
+    int finishedLanes(const Lanes& lanes, int maxTurns) {
+        const Vec zero = splat(0);
+        Vec running = greater(load(lanes.enemyHP), zero) & greater(load(lanes.playerHP), zero) &
+            greater(splat(maxTurns), load(lanes.turn));
+        return bits(andNot(running, load(lanes.active)));
+    }
+
+    // CombatState::drawCard on one lane. Only lanes that end their turn draw, a
+    // third of them in a typical step, so this stays scalar: a masked vector pass
+    // would do the work for all eight.
+    void drawCard(Lanes& lanes, int lane) {
+        int& drawCount = lanes.drawCount[lane];
+        int& discardCount = lanes.discardCount[lane];
+        if (drawCount == 0 && discardCount > 0) {
+            for (int i = 0; i < discardCount; ++i) {
+                lanes.drawPile[i][lane] = lanes.discard[i][lane];
+            }
+            drawCount = discardCount;
+            discardCount = 0;
+        }
+        int& handCount = lanes.handCount[lane];
+        if (drawCount > 0 && handCount < CombatState::MAX_HAND) {
+            std::uint32_t index = CombatState::random(lanes.rng[lane], static_cast<std::uint32_t>(drawCount));
+            lanes.hand[handCount++][lane] = lanes.drawPile[index][lane];
+            lanes.drawPile[index][lane] = lanes.drawPile[--drawCount][lane];
+        }
+    }
+#endif
+
+    void record(BatchCombat::Report& report, int playerHP, int enemyHP, int turn) {
+        ++report.fights;
+        report.totalTurns += turn;
+        if (enemyHP <= 0) {
+            ++report.wins;
+            report.totalHP += playerHP;
+        }
+        else if (playerHP > 0) {
+            ++report.stalls;
+        }
+    }
+}
+
+BatchCombat::BatchCombat(const CombatDeck& deck, int enemyHP, int enemyDamage, const Config& config,
+    const EnemyBehavior* behavior)
+    : deck(deck), enemyHP(enemyHP), enemyDamage(enemyDamage), config(config), behavior(behavior) {
+}
+
+const char* BatchCombat::getKernelName() {
+#if defined(__AVX2__)
+    return "AVX2";
+#else
+    return "scalar";
+#endif
+}
+
+bool BatchCombat::isLockstep() {
+#if defined(__AVX2__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+BatchCombat::Report BatchCombat::run(long long fights) const {
+#if defined(__AVX2__)
+    Clock::time_point start = Clock::now();
+    Report report{ 0, 0, 0, 0, 0, 0.0 };
+
+    SpecTable table = {};
+    int maxStrikes = 0;
+    for (int i = 0; i < deck.getSpecCount(); ++i) {
+        const CardSpec& spec = deck.getSpec(i);
+        table.damage[i] = spec.damage;
+        table.cost[i] = spec.energyCost;
+        table.effectType[i] = static_cast<std::int32_t>(spec.effect.type);
+        table.effectValue[i] = spec.effect.value;
+        table.effectCount[i] = spec.effect.count;
+        if (spec.effect.type == CardEffectType::MultiStrike) {
+            maxStrikes = std::max(maxStrikes, spec.effect.count);
+        }
+    }
+    table.blocks = std::max(1, (deck.getSpecCount() + LANES - 1) / LANES);
+
+    // Without a behavior the enemy is a single attack, which behaves the same.
+    EnemyBehavior attack = EnemyBehavior::attackOnly(enemyDamage);
+    const EnemyBehavior& enemyBehavior = behavior ? *behavior : attack;
+    EnemyActions enemy{ &enemyBehavior.getTable(), 0, enemyHP, enemyBehavior.getIntentCount() > 1 };
+    for (int i = 0; i < enemyBehavior.getIntentCount(); ++i) {
+        enemy.maxHits = std::max(enemy.maxHits, static_cast<int>(enemyBehavior.getTable().hits[i]));
+    }
+
+    Lanes lanes = {};
+    long long nextFight = 0;
+
+    for (;;) {
+        int idle = finishedLanes(lanes, config.maxTurns) | (~bits(load(lanes.active)) & ((1 << LANES) - 1));
+        for (; idle; idle &= idle - 1) {
+            int lane = firstLane(idle);
+            if (lanes.active[lane]) {
+                record(report, lanes.playerHP[lane], lanes.enemyHP[lane], lanes.turn[lane]);
+            }
+            // A fight that is over before its first move is recorded without playing it.
+            for (;;) {
+                if (nextFight >= fights) {
+                    lanes.active[lane] = 0;
+                    break;
+                }
+                CombatState state = CombatState::begin(deck, enemyHP, enemyDamage, config.seed + nextFight++);
+                state.setBehavior(behavior);
+                if (state.isOver() || state.turn >= config.maxTurns) {
+                    record(report, state.playerHP, state.enemyHP, state.turn);
+                    continue;
+                }
+                lanes.rng[lane] = state.rng;
+                lanes.playerHP[lane] = state.playerHP;
+                lanes.playerArmor[lane] = state.playerArmor;
+                lanes.playerPoison[lane] = state.playerPoison;
+                lanes.playerPoisonTurns[lane] = state.playerPoisonTurns;
+                lanes.energy[lane] = state.energy;
+                lanes.enemyHP[lane] = state.enemyHP;
+                lanes.enemyBlock[lane] = state.enemyBlock;
+                lanes.enemyStrength[lane] = state.enemyStrength;
+                lanes.intent[lane] = state.enemyIntent;
+                lanes.damageReduction[lane] = state.damageReduction;
+                lanes.weakenTurns[lane] = state.weakenTurns;
+                lanes.poisonDamage[lane] = state.poisonDamage;
+                lanes.poisonTurns[lane] = state.poisonTurns;
+                lanes.wetTurns[lane] = state.wetTurns;
+                lanes.frozen[lane] = state.frozen ? -1 : 0;
+                lanes.turn[lane] = state.turn;
+                lanes.active[lane] = -1;
+                for (int slot = 0; slot < CombatState::MAX_HAND; ++slot) {
+                    lanes.hand[slot][lane] = slot < state.handCount ? state.hand[slot] : 0;
+                }
+                lanes.handCount[lane] = state.handCount;
+                for (int i = 0; i < state.drawCount; ++i) {
+                    lanes.drawPile[i][lane] = state.drawPile[i];
+                }
+                for (int i = 0; i < state.discardCount; ++i) {
+                    lanes.discard[i][lane] = state.discard[i];
+                }
+                lanes.drawCount[lane] = state.drawCount;
+                lanes.discardCount[lane] = state.discardCount;
+                break;
+            }
+        }
+        if (bits(load(lanes.active)) == 0) {
+            break;
+        }
+
+        chooseKernel(lanes, table);
+        playKernel(lanes, table, maxStrikes);
+        endTurnKernel(lanes, enemy);
+
+        // Refill like CombatState::endTurn.
+        for (int ending = bits(load(lanes.ending)); ending; ending &= ending - 1) {
+            int lane = firstLane(ending);
+            int handCount = lanes.handCount[lane];
+            int cardsToDraw = handCount < CombatState::REFILL_HAND ? CombatState::REFILL_HAND - handCount : 1;
+            cardsToDraw = std::min(cardsToDraw, CombatState::MAX_HAND - handCount);
+            for (int i = 0; i < cardsToDraw; ++i) {
+                drawCard(lanes, lane);
+            }
+        }
+    }
+
+    report.elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return report;
+#else
+    return runScalar(fights);
+#endif
+}
+
+BatchCombat::Report BatchCombat::runScalar(long long fights) const {
+    Clock::time_point start = Clock::now();
+    Report report{ 0, 0, 0, 0, 0, 0.0 };
+
+    for (long long fight = 0; fight < fights; ++fight) {
+        CombatState state = CombatState::begin(deck, enemyHP, enemyDamage, config.seed + fight);
+        state.setBehavior(behavior);
+        while (!state.isOver() && state.turn < config.maxTurns) {
+            int playable[CombatState::MAX_HAND];
+            int count = 0;
+            for (int i = 0; i < state.handCount; ++i) {
+                if (deck.getSpec(state.hand[i]).energyCost <= state.energy) {
+                    playable[count++] = i;
+                }
+            }
+            if (count > 0) {
+                state.playCard(playable[state.random(static_cast<std::uint32_t>(count))], deck);
+            }
+            else {
+                state.endTurn();
+            }
+        }
+        record(report, state.playerHP, state.enemyHP, state.turn);
+    }
+
+    report.elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return report;
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "../includes/simulation/BattlePolicy.h"
+#include <algorithm>
+
+namespace {
+    bool handHas(const CombatState& state, const CombatDeck& deck, CardEffectType type) {
+        for (int i = 0; i < state.handCount; ++i) {
+            if (deck.getSpec(state.hand[i]).effect.type == type) return true;
+        }
+        return false;
+    }
+}
+
+float BattlePolicy::scoreCard(const CombatState& state, const CombatDeck& deck, int spec) {
+    const CardSpec& card = deck.getSpec(spec);
+    const CardEffect& effect = card.effect;
+    int incoming = state.incomingDamage();
+    bool wet = state.wetTurns > 0;
+
+    float damage = static_cast<float>(card.damage);
+    float utility = 0.0f;
+    switch (effect.type) {
+    case CardEffectType::Armor:
+        // Armor is only spent by hits, so what exceeds this turn's attack still has some value.
+        utility = std::min(effect.value, std::max(0, incoming - state.playerArmor)) + 0.1f * effect.value;
+        break;
+    case CardEffectType::Heal:
+        utility = static_cast<float>(std::min(effect.value, CombatState::PLAYER_MAX_HP - state.playerHP));
+        break;
+    case CardEffectType::MultiStrike:
+        damage += static_cast<float>(effect.value * effect.count);
+        break;
+    case CardEffectType::Weaken:
+        utility = 0.5f * std::min(effect.value, state.enemyDamage) * effect.count;
+        break;
+    case CardEffectType::Poison:
+        utility = state.poisonTurns > 0 ? 0.5f * effect.value : 0.8f * effect.value * effect.count;
+        break;
+    case CardEffectType::Thorns:
+        damage += CombatState::THORNS_DAMAGE;
+        break;
+    case CardEffectType::Wet:
+        if (!wet) {
+            utility = 0.5f;
+            if (handHas(state, deck, CardEffectType::Lightning)) utility += 6.0f;
+            if (handHas(state, deck, CardEffectType::Ice)) utility += 0.5f * incoming;
+        }
+        break;
+    case CardEffectType::Lightning:
+        damage += static_cast<float>(wet ? effect.value * 2 : effect.value);
+        break;
+    case CardEffectType::Ice:
+        damage += static_cast<float>(effect.value);
+        if (wet && !state.frozen) utility = static_cast<float>(incoming);
+        break;
+    default:
+        break;
+    }
+
+    if (damage >= state.enemyHP + state.enemyBlock) {
+        return 1000.0f + damage; // lethal beats everything
+    }
+    return damage + utility;
+}
+
+int BattlePolicy::greedy(const CombatState& state, const CombatDeck& deck) {
+    int best = CombatState::END_TURN;
+    float bestScore = 0.0f;
+    int bestCost = 0;
+    for (int i = 0; i < state.handCount; ++i) {
+        int spec = state.hand[i];
+        int cost = deck.getSpec(spec).energyCost;
+        if (cost > state.energy) continue;
+        float score = scoreCard(state, deck, spec);
+        if (score > bestScore || (score == bestScore && best != CombatState::END_TURN && cost < bestCost)) {
+            best = spec;
+            bestScore = score;
+            bestCost = cost;
+        }
+    }
+    return best;
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "../includes/simulation/CardLibrary.h"
+#include "../includes/simulation/RewardTable.h"
+
+const std::vector<CardSpec>& CardLibrary::getCardPool() {
+    static const std::vector<CardSpec> pool = {
+        CardSpec("Slash", 8, 2),
+        CardSpec("Strike", 5, 1),
+        CardSpec("Block", 0, 1, CardEffect(CardEffectType::Armor, 5)),
+        CardSpec("Water Gun", 1, 1, CardEffect(CardEffectType::Wet, 0, 2)),
+        CardSpec("Lightning Strike", 6, 3, CardEffect(CardEffectType::Lightning, 6)),
+        CardSpec("Ice Shard", 4, 2, CardEffect(CardEffectType::Ice, 4, 1)),
+        CardSpec("Heal", 0, 2, CardEffect(CardEffectType::Heal, 5)),
+        CardSpec("Superb Shield", 0, 2, CardEffect(CardEffectType::Armor, 10)),
+        CardSpec("Thorns", 0, 1, CardEffect(CardEffectType::Thorns)),
+        CardSpec("Dragon's Breath", 10, 3),
+    };
+    return pool;
+}
+
+std::vector<CardSpec> CardLibrary::getStarterDeck(StarterDeck deck) {
+    std::vector<CardSpec> cards;
+    if (deck == StarterDeck::DAMAGE) {
+        cards.emplace_back("Slash", 8, 2);
+        cards.emplace_back("Strike", 5, 1);
+        cards.emplace_back("Block", 0, 1, CardEffect(CardEffectType::Armor, 5));
+        cards.emplace_back("Block", 0, 1, CardEffect(CardEffectType::Armor, 5));
+    }
+    else if (deck == StarterDeck::BALANCED) {
+        cards.emplace_back("Strike", 5, 1);
+        cards.emplace_back("Block", 0, 1, CardEffect(CardEffectType::Armor, 5));
+        cards.emplace_back("Water Gun", 1, 1, CardEffect(CardEffectType::Wet, 0, 2));
+        cards.emplace_back("Lightning Strike", 6, 3, CardEffect(CardEffectType::Lightning, 6));
+        cards.emplace_back("Ice Shard", 4, 2, CardEffect(CardEffectType::Ice, 4, 1));
+    }
+    else if (deck == StarterDeck::ELEMENTAL) {
+        cards.emplace_back("Water Gun", 0, 1, CardEffect(CardEffectType::Wet, 0, 2));
+        cards.emplace_back("Lightning Strike", 6, 3, CardEffect(CardEffectType::Lightning, 6));
+        cards.emplace_back("Ice Shard", 4, 2, CardEffect(CardEffectType::Ice, 4, 1));
+        cards.emplace_back("Heal", 0, 2, CardEffect(CardEffectType::Heal, 5));
+        cards.emplace_back("Water Gun", 1, 1, CardEffect(CardEffectType::Wet, 0, 2));
+    }
+    else if (deck == StarterDeck::DEFENSE) {
+        cards.emplace_back("Block", 0, 1, CardEffect(CardEffectType::Armor, 5));
+        cards.emplace_back("Superb Shield", 0, 2, CardEffect(CardEffectType::Armor, 10));
+        cards.emplace_back("Heal", 0, 2, CardEffect(CardEffectType::Heal, 5));
+        cards.emplace_back("Thorns", 0, 1, CardEffect(CardEffectType::Thorns));
+        cards.emplace_back("Thorns", 0, 1, CardEffect(CardEffectType::Thorns));
+    }
+    return cards;
+}
+
+CardRarity CardLibrary::getRarity(const CardSpec& card) {
+    if (card.name == "Lightning Strike" || card.name == "Ice Shard" || card.name == "Superb Shield") {
+        return CardRarity::Rare;
+    }
+    if (card.name == "Dragon's Breath") {
+        return CardRarity::Epic;
+    }
+    return CardRarity::Common;
+}
+
+std::vector<int> CardLibrary::rollRewardOffer(RewardTier tier, std::mt19937& rng) {
+    static const RewardTable table;
+    std::vector<int> offer;
+    table.roll(tier, rng, offer);
+    return offer;
+}
+
+CombatDeck CardLibrary::buildCombatDeck(const std::vector<CardSpec>& cards) {
+    CombatDeck deck;
+    for (const auto& card : cards) {
+        deck.addCard(card);
+    }
+    return deck;
+}
+
+bool CardLibrary::parseStarterDeck(const std::string& name, StarterDeck& deck) {
+    if (name == "damage") deck = StarterDeck::DAMAGE;
+    else if (name == "balanced") deck = StarterDeck::BALANCED;
+    else if (name == "elemental") deck = StarterDeck::ELEMENTAL;
+    else if (name == "defense") deck = StarterDeck::DEFENSE;
+    else return false;
+    return true;
+}
\ No newline at end of file
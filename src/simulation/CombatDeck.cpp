@@ -0,0 +1,25 @@
+#include "../includes/simulation/CombatDeck.h"
+#include <iostream>
+
+int CombatDeck::addCard(const CardSpec& spec) {
+    int id = findSpec(spec);
+    if (id < 0) {
+        if (static_cast<int>(specs.size()) >= MAX_SPECS) {
+            std::cerr << "Combat deck has too many distinct cards, ignoring " << spec.name << "\n";
+            return -1;
+        }
+        id = static_cast<int>(specs.size());
+        specs.push_back(spec);
+    }
+    cards.push_back(static_cast<CardId>(id));
+    return id;
+}
+
+int CombatDeck::findSpec(const CardSpec& spec) const {
+    for (size_t i = 0; i < specs.size(); ++i) {
+        if (specs[i] == spec) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
\ No newline at end of file
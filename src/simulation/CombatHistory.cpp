@@ -0,0 +1,39 @@
+#include "../includes/simulation/CombatHistory.h"
+
+CombatHistory::CombatHistory() : start(0), count(0), cursor(-1) {
+}
+
+void CombatHistory::reset(const CombatState& state) {
+    start = 0;
+    count = 1;
+    cursor = 0;
+    entries[0] = state;
+}
+
+void CombatHistory::push(const CombatState& state) {
+    count = cursor + 1;
+    if (count == CAPACITY) {
+        start = (start + 1) % CAPACITY;
+        --count;
+    }
+    cursor = count++;
+    entries[(start + cursor) % CAPACITY] = state;
+}
+
+bool CombatHistory::undo(CombatState& state) {
+    if (!canUndo()) {
+        return false;
+    }
+    --cursor;
+    state = entries[(start + cursor) % CAPACITY];
+    return true;
+}
+
+bool CombatHistory::redo(CombatState& state) {
+    if (!canRedo()) {
+        return false;
+    }
+    ++cursor;
+    state = entries[(start + cursor) % CAPACITY];
+    return true;
+}
\ No newline at end of file
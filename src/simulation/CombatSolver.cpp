@@ -0,0 +1,483 @@
+#include "../includes/simulation/CombatSolver.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <thread>
+
+namespace {
+    enum Field {
+        PLAYER_HP, PLAYER_ARMOR, PLAYER_POISON, PLAYER_POISON_TURNS, ENERGY, ENEMY_HP, ENEMY_BLOCK,
+        ENEMY_STRENGTH, INTENT, DAMAGE_REDUCTION, WEAKEN_TURNS, POISON_DAMAGE, POISON_TURNS, WET_TURNS,
+        FROZEN, TURNS_LEFT
+    };
+
+    constexpr int END_TURN = CombatDeck::MAX_SPECS;
+
+    std::uint64_t splitmix(std::uint64_t& state) {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+}
+
+CombatSolver::CombatSolver(const Config& config)
+    : config(config), nodeCount(0), entryCount(0), aborted(false), deck(nullptr), maxEnergy(0), enemyDamage(0), enemyMaxHP(0),
+    resistances(0), behavior(nullptr), turnDamageBound(0) {
+    // Fixed seed: hashes are only compared within one solver, but a stable table keeps runs reproducible.
+    std::uint64_t seed = 0xC0FFEE;
+    for (auto& pile : pileKeys) {
+        for (auto& spec : pile) {
+            for (auto& key : spec) {
+                key = splitmix(seed);
+            }
+        }
+    }
+    for (auto& field : fieldKeys) {
+        for (auto& key : field) {
+            key = splitmix(seed);
+        }
+    }
+}
+
+std::uint64_t CombatSolver::fieldKey(int field, int value) const {
+    return fieldKeys[field][std::min(255, std::max(0, value))];
+}
+
+void CombatSolver::setField(Position& position, std::int16_t& field, int index, int value) const {
+    position.hash ^= fieldKey(index, field) ^ fieldKey(index, value);
+    field = static_cast<std::int16_t>(value);
+}
+
+void CombatSolver::moveCard(Position& position, Pile from, Pile to, int spec) const {
+    std::uint8_t& source = position.counts[from][spec];
+    std::uint8_t& target = position.counts[to][spec];
+    position.hash ^= pileKeys[from][spec][source] ^ pileKeys[from][spec][source - 1];
+    position.hash ^= pileKeys[to][spec][target] ^ pileKeys[to][spec][target + 1];
+    --source;
+    ++target;
+    --position.pileSizes[from];
+    ++position.pileSizes[to];
+}
+
+void CombatSolver::rehash(Position& position) const {
+    std::uint64_t hash = 0;
+    for (int pile = 0; pile < PILE_COUNT; ++pile) {
+        for (int spec = 0; spec < MAX_SPECS; ++spec) {
+            hash ^= pileKeys[pile][spec][position.counts[pile][spec]];
+        }
+    }
+    const std::int16_t fields[FIELD_COUNT] = {
+        position.playerHP, position.playerArmor, position.playerPoison, position.playerPoisonTurns, position.energy,
+        position.enemyHP, position.enemyBlock, position.enemyStrength, position.intent, position.damageReduction,
+        position.weakenTurns, position.poisonDamage, position.poisonTurns, position.wetTurns, position.frozen,
+        position.turnsLeft
+    };
+    for (int field = 0; field < FIELD_COUNT; ++field) {
+        hash ^= fieldKey(field, fields[field]);
+    }
+    position.hash = hash;
+}
+
+CombatSolver::Position CombatSolver::fromState(const CombatState& state) const {
+    Position position;
+    std::memset(&position, 0, sizeof(position));
+    for (int i = 0; i < state.handCount; ++i) ++position.counts[HAND][state.hand[i]];
+    for (int i = 0; i < state.drawCount; ++i) ++position.counts[DRAW][state.drawPile[i]];
+    for (int i = 0; i < state.discardCount; ++i) ++position.counts[DISCARD][state.discard[i]];
+    position.pileSizes[HAND] = state.handCount;
+    position.pileSizes[DRAW] = state.drawCount;
+    position.pileSizes[DISCARD] = state.discardCount;
+    position.playerHP = static_cast<std::int16_t>(state.playerHP);
+    position.playerArmor = static_cast<std::int16_t>(state.playerArmor);
+    position.playerPoison = static_cast<std::int16_t>(state.playerPoison);
+    position.playerPoisonTurns = static_cast<std::int16_t>(state.playerPoisonTurns);
+    position.energy = static_cast<std::int16_t>(state.energy);
+    position.enemyHP = static_cast<std::int16_t>(state.enemyHP);
+    position.enemyBlock = static_cast<std::int16_t>(state.enemyBlock);
+    position.enemyStrength = static_cast<std::int16_t>(state.enemyStrength);
+    position.intent = static_cast<std::int16_t>(state.enemyIntent);
+    position.damageReduction = static_cast<std::int16_t>(state.damageReduction);
+    position.weakenTurns = static_cast<std::int16_t>(state.weakenTurns);
+    position.poisonDamage = static_cast<std::int16_t>(state.poisonDamage);
+    position.poisonTurns = static_cast<std::int16_t>(state.poisonTurns);
+    position.wetTurns = static_cast<std::int16_t>(state.wetTurns);
+    position.frozen = state.frozen ? 1 : 0;
+    position.turnsLeft = static_cast<std::int16_t>(config.maxTurns);
+    position.playerArmor = static_cast<std::int16_t>(std::min<int>(position.playerArmor, armorCap(position)));
+    rehash(position);
+    return position;
+}
+
+int CombatSolver::incomingDamage(const Position& position) const {
+    if (!behavior) {
+        return std::max(0, enemyDamage + position.enemyStrength - position.damageReduction);
+    }
+    const EnemyBehavior::Table& table = behavior->getTable();
+    int intent = position.intent;
+    return table.hits[intent] * std::max(0, table.damage[intent] + position.enemyStrength - position.damageReduction);
+}
+
+int CombatSolver::armorCap(const Position& position) const {
+    if (!behavior) {
+        return std::max(0, enemyDamage + position.enemyStrength);
+    }
+    const EnemyBehavior::Table& table = behavior->getTable();
+    int worst = 0;
+    for (int intent = 0; intent < behavior->getIntentCount(); ++intent) {
+        worst = std::max(worst, table.hits[intent] * std::max(0, table.damage[intent] + position.enemyStrength));
+    }
+    return worst;
+}
+
+bool CombatSolver::lookup(const Position& position, double& value) {
+    Shard& shard = shards[position.hash % SHARD_COUNT];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.entries.find(position.hash);
+    if (it == shard.entries.end() || std::memcmp(&it->second.first, &position, sizeof(Position)) != 0) {
+        return false;
+    }
+    value = it->second.second;
+    return true;
+}
+
+void CombatSolver::store(const Position& position, double value) {
+    if (entryCount.load(std::memory_order_relaxed) >= config.maxEntries) {
+        return;
+    }
+    Shard& shard = shards[position.hash % SHARD_COUNT];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto result = shard.entries.emplace(position.hash, std::make_pair(position, value));
+    if (result.second) {
+        entryCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+double CombatSolver::decide(const Position& position, int order) {
+    if (position.enemyHP <= 0) return 1.0;
+    if (position.playerHP <= 0 || position.turnsLeft <= 0) return 0.0;
+    // Out of reach even if every remaining turn dealt the most damage the deck can.
+    if (position.enemyHP > turnDamageBound * position.turnsLeft) return 0.0;
+
+    double best = 0.0;
+    if (lookup(position, best)) {
+        return best;
+    }
+    if (nodeCount.fetch_add(1, std::memory_order_relaxed) >= config.maxNodes) {
+        aborted.store(true, std::memory_order_relaxed);
+    }
+    if (aborted.load(std::memory_order_relaxed)) {
+        return 0.0;
+    }
+
+    int moves[MAX_SPECS + 1];
+    int moveCount = 0;
+    for (int spec = 0; spec < deck->getSpecCount(); ++spec) {
+        if (position.counts[HAND][spec] > 0 && deck->getSpec(spec).energyCost <= position.energy) {
+            moves[moveCount++] = spec;
+        }
+    }
+    moves[moveCount++] = END_TURN;
+
+    for (int i = 0; i < moveCount && best < 1.0; ++i) {
+        int move = moves[(i + order) % moveCount];
+        double value = move == END_TURN ? endTurn(position, order) : playCard(position, move, order);
+        best = std::max(best, value);
+    }
+
+    // A subtree cut short by the budget has no exact value to keep.
+    if (!aborted.load(std::memory_order_relaxed)) {
+        store(position, best);
+    }
+    return best;
+}
+
+double CombatSolver::playCard(const Position& position, int spec, int order) {
+    const CardSpec& card = deck->getSpec(spec);
+    const CardEffect& effect = card.effect;
+    Position next = position;
+    int enemyHP = next.enemyHP;
+    int block = next.enemyBlock;
+    auto hit = [&enemyHP, &block](int damage) {
+        int absorbed = std::min(block, damage);
+        block -= absorbed;
+        enemyHP -= damage - absorbed;
+    };
+    hit(card.damage);
+    setField(next, next.energy, ENERGY, next.energy - card.energyCost);
+
+    switch (effect.type) {
+    case CardEffectType::Armor:
+        setField(next, next.playerArmor, PLAYER_ARMOR, std::min(armorCap(next), next.playerArmor + effect.value));
+        break;
+    case CardEffectType::Heal:
+        setField(next, next.playerHP, PLAYER_HP, std::min(CombatState::PLAYER_MAX_HP, next.playerHP + effect.value));
+        break;
+    case CardEffectType::MultiStrike:
+        for (int i = 0; i < effect.count && enemyHP > 0; ++i) {
+            hit(effect.value);
+        }
+        break;
+    case CardEffectType::Weaken:
+        if (!(resistances & CombatState::resistanceBit(CardEffectType::Weaken))) {
+            setField(next, next.damageReduction, DAMAGE_REDUCTION, effect.value);
+            setField(next, next.weakenTurns, WEAKEN_TURNS, effect.count);
+        }
+        break;
+    case CardEffectType::Poison:
+        if (!(resistances & CombatState::resistanceBit(CardEffectType::Poison))) {
+            setField(next, next.poisonDamage, POISON_DAMAGE, effect.value);
+            setField(next, next.poisonTurns, POISON_TURNS, effect.count);
+        }
+        break;
+    case CardEffectType::Thorns:
+        hit(CombatState::THORNS_DAMAGE);
+        break;
+    case CardEffectType::Wet:
+        if (!(resistances & CombatState::resistanceBit(CardEffectType::Wet))) {
+            setField(next, next.wetTurns, WET_TURNS, effect.count);
+        }
+        break;
+    case CardEffectType::Lightning:
+        hit(next.wetTurns > 0 ? effect.value * 2 : effect.value);
+        break;
+    case CardEffectType::Ice:
+        hit(effect.value);
+        if (next.wetTurns > 0 && !(resistances & CombatState::resistanceBit(CardEffectType::Ice))) {
+            setField(next, next.frozen, FROZEN, 1);
+        }
+        break;
+    default:
+        break;
+    }
+
+    setField(next, next.enemyHP, ENEMY_HP, enemyHP);
+    setField(next, next.enemyBlock, ENEMY_BLOCK, block);
+    moveCard(next, HAND, DISCARD, spec);
+    return decide(next, order);
+}
+
+double CombatSolver::endTurn(const Position& position, int order) {
+    Position next = position;
+    setField(next, next.enemyBlock, ENEMY_BLOCK, 0);
+    if (next.frozen) {
+        setField(next, next.frozen, FROZEN, 0);
+    }
+    else {
+        int damage = incomingDamage(next);
+        int damageAfterArmor = std::max(0, damage - next.playerArmor);
+        setField(next, next.playerArmor, PLAYER_ARMOR, std::max(0, next.playerArmor - damage));
+        setField(next, next.playerHP, PLAYER_HP, next.playerHP - damageAfterArmor);
+        if (behavior) {
+            const EnemyBehavior::Table& table = behavior->getTable();
+            int intent = next.intent;
+            setField(next, next.enemyBlock, ENEMY_BLOCK, table.block[intent]);
+            setField(next, next.enemyStrength, ENEMY_STRENGTH, next.enemyStrength + table.strength[intent]);
+            if (table.poisonTurns[intent] > 0) {
+                setField(next, next.playerPoison, PLAYER_POISON, table.poison[intent]);
+                setField(next, next.playerPoisonTurns, PLAYER_POISON_TURNS, table.poisonTurns[intent]);
+            }
+        }
+    }
+
+    if (next.weakenTurns > 0) {
+        setField(next, next.weakenTurns, WEAKEN_TURNS, next.weakenTurns - 1);
+        if (next.weakenTurns == 0) setField(next, next.damageReduction, DAMAGE_REDUCTION, 0);
+    }
+    if (next.poisonTurns > 0) {
+        setField(next, next.enemyHP, ENEMY_HP, next.enemyHP - next.poisonDamage);
+        setField(next, next.poisonTurns, POISON_TURNS, next.poisonTurns - 1);
+    }
+    if (next.wetTurns > 0) {
+        setField(next, next.wetTurns, WET_TURNS, next.wetTurns - 1);
+    }
+    if (next.playerPoisonTurns > 0) {
+        setField(next, next.playerHP, PLAYER_HP, next.playerHP - next.playerPoison);
+        setField(next, next.playerPoisonTurns, PLAYER_POISON_TURNS, next.playerPoisonTurns - 1);
+    }
+
+    // Same precedence as CombatState::hasWon: poison finishing the enemy wins even on a lethal hit.
+    if (next.enemyHP <= 0) return 1.0;
+    if (next.playerHP <= 0) return 0.0;
+
+    setField(next, next.turnsLeft, TURNS_LEFT, next.turnsLeft - 1);
+    if (next.playerArmor > armorCap(next)) {
+        setField(next, next.playerArmor, PLAYER_ARMOR, armorCap(next));
+    }
+    setField(next, next.energy, ENERGY, maxEnergy);
+    int handSize = next.pileSizes[HAND];
+    int cardsToDraw = handSize < CombatState::REFILL_HAND ? CombatState::REFILL_HAND - handSize : 1;
+    cardsToDraw = std::min(cardsToDraw, CombatState::MAX_HAND - handSize);
+    return pickIntentThen(next, cardsToDraw, order);
+}
+
+double CombatSolver::pickIntentThen(const Position& position, int cards, int order) {
+    if (!behavior) {
+        return drawThen(position, cards, order);
+    }
+    if (behavior->getIntentCount() == 1) {
+        Position next = position;
+        setField(next, next.intent, INTENT, 0);
+        return drawThen(next, cards, order);
+    }
+
+    int row = EnemyBehavior::row(position.enemyHP * 2 <= enemyMaxHP, position.intent);
+    double expected = 0.0;
+    for (int intent = 0; intent < behavior->getIntentCount(); ++intent) {
+        double probability = behavior->probability(row, intent);
+        if (probability <= 0.0) continue;
+        Position next = position;
+        setField(next, next.intent, INTENT, intent);
+        expected += probability * drawThen(next, cards, order);
+    }
+    return expected;
+}
+
+double CombatSolver::drawThen(const Position& position, int cards, int order) {
+    if (cards <= 0 || position.pileSizes[HAND] >= CombatState::MAX_HAND) {
+        return decide(position, order);
+    }
+
+    Position base = position;
+    if (base.pileSizes[DRAW] == 0) {
+        for (int spec = 0; spec < deck->getSpecCount(); ++spec) {
+            while (base.counts[DISCARD][spec] > 0) {
+                moveCard(base, DISCARD, DRAW, spec);
+            }
+        }
+        if (base.pileSizes[DRAW] == 0) {
+            return decide(base, order);
+        }
+    }
+
+    double expected = 0.0;
+    double total = base.pileSizes[DRAW];
+    for (int spec = 0; spec < deck->getSpecCount(); ++spec) {
+        int count = base.counts[DRAW][spec];
+        if (count == 0) continue;
+        Position next = base;
+        moveCard(next, DRAW, HAND, spec);
+        expected += (count / total) * drawThen(next, cards - 1, order);
+    }
+    return expected;
+}
+
+void CombatSolver::reset(const CombatDeck& combatDeck, int energy, int damage, int maxHP, std::uint16_t enemyResistances,
+    const EnemyBehavior* enemyBehavior) {
+    deck = &combatDeck;
+    maxEnergy = energy;
+    enemyDamage = damage;
+    enemyMaxHP = maxHP;
+    resistances = enemyResistances;
+    behavior = enemyBehavior;
+
+    // Per turn: the best MAX_HAND single plays in the deck (no card draws mid-turn)
+    // plus one poison tick.
+    std::vector<int> playDamage;
+    int poisonTick = 0;
+    for (CombatState::CardId card : combatDeck.getCards()) {
+        const CardSpec& spec = combatDeck.getSpec(card);
+        const CardEffect& effect = spec.effect;
+        int damage = spec.damage;
+        switch (effect.type) {
+        case CardEffectType::MultiStrike: damage += effect.value * effect.count; break;
+        case CardEffectType::Thorns: damage += CombatState::THORNS_DAMAGE; break;
+        case CardEffectType::Lightning: damage += effect.value * 2; break;
+        case CardEffectType::Ice: damage += effect.value; break;
+        case CardEffectType::Poison:
+            if (!(resistances & CombatState::resistanceBit(CardEffectType::Poison))) {
+                poisonTick = std::max(poisonTick, effect.value);
+            }
+            break;
+        default: break;
+        }
+        playDamage.push_back(std::max(0, damage));
+    }
+    std::sort(playDamage.begin(), playDamage.end(), std::greater<int>());
+    turnDamageBound = poisonTick;
+    for (size_t i = 0; i < playDamage.size() && i < static_cast<size_t>(CombatState::MAX_HAND); ++i) {
+        turnDamageBound += playDamage[i];
+    }
+
+    nodeCount = 0;
+    entryCount = 0;
+    aborted = false;
+    for (auto& shard : shards) {
+        shard.entries.clear();
+    }
+}
+
+CombatSolver::Result CombatSolver::run(const Position& root, bool opening, int cards) {
+    auto start = std::chrono::steady_clock::now();
+    Result result{ true, false, 0.0, {}, 0, 0, 0.0 };
+
+    int threadCount = config.threads > 0 ? config.threads : static_cast<int>(std::thread::hardware_concurrency());
+    threadCount = std::max(1, threadCount);
+    std::vector<double> values(threadCount, 0.0);
+    auto work = [&](int order) {
+        values[order] = opening ? pickIntentThen(root, cards, order) : decide(root, order);
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threadCount; ++i) {
+        workers.emplace_back(work, i);
+    }
+    work(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    result.winProbability = values[0];
+    result.solved = !aborted.load();
+
+    if (result.solved && !opening && root.enemyHP > 0 && root.playerHP > 0) {
+        // Every child is already in the table, so this pass is cheap.
+        for (int spec = 0; spec < deck->getSpecCount(); ++spec) {
+            if (root.counts[HAND][spec] > 0 && deck->getSpec(spec).energyCost <= root.energy) {
+                result.actions.push_back(ActionValue{ spec, playCard(root, spec, 0) });
+            }
+        }
+        result.actions.push_back(ActionValue{ END_TURN, endTurn(root, 0) });
+        std::stable_sort(result.actions.begin(), result.actions.end(), [](const ActionValue& a, const ActionValue& b) {
+            return a.winProbability > b.winProbability;
+        });
+    }
+
+    result.nodes = nodeCount.load();
+    result.entries = entryCount.load();
+    result.saturated = result.entries >= config.maxEntries;
+    result.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+CombatSolver::Result CombatSolver::solve(const CombatState& state, const CombatDeck& combatDeck) {
+    if (combatDeck.getSpecCount() > MAX_SPECS) {
+        std::cerr << "Combat solver supports at most " << MAX_SPECS << " distinct cards, deck has "
+            << combatDeck.getSpecCount() << "\n";
+        return Result{ false, false, 0.0, {}, 0, 0, 0.0 };
+    }
+    reset(combatDeck, state.maxEnergy, state.enemyDamage, state.enemyMaxHP, state.resistances, state.behavior);
+    return run(fromState(state), false, 0);
+}
+
+CombatSolver::Result CombatSolver::solveOpening(const CombatDeck& combatDeck, int enemyHP, int enemyDamage, std::uint16_t enemyResistances,
+    const EnemyBehavior* enemyBehavior) {
+    CombatState state;
+    state.enemyHP = enemyHP;
+    state.enemyMaxHP = enemyHP;
+    state.enemyDamage = enemyDamage;
+    state.resistances = enemyResistances;
+    state.behavior = enemyBehavior;
+    state.enemyIntent = enemyBehavior ? EnemyBehavior::NO_INTENT : 0; // picked at the root, like setBehavior
+    for (CombatState::CardId card : combatDeck.getCards()) {
+        state.addToDrawPile(card);
+    }
+    if (combatDeck.getSpecCount() > MAX_SPECS) {
+        std::cerr << "Combat solver supports at most " << MAX_SPECS << " distinct cards, deck has "
+            << combatDeck.getSpecCount() << "\n";
+        return Result{ false, false, 0.0, {}, 0, 0, 0.0 };
+    }
+    reset(combatDeck, state.maxEnergy, enemyDamage, enemyHP, enemyResistances, enemyBehavior);
+    return run(fromState(state), true, CombatState::REFILL_HAND);
+}
\ No newline at end of file
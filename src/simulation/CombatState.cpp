@@ -0,0 +1,255 @@
+#include "../includes/simulation/CombatState.h"
+#include <algorithm>
+
+CombatState::CombatState()
+    : playerHP(PLAYER_MAX_HP), playerArmor(0), playerPoison(0), playerPoisonTurns(0),
+    energy(PLAYER_MAX_ENERGY), maxEnergy(PLAYER_MAX_ENERGY),
+    enemyHP(0), enemyMaxHP(0), enemyDamage(0), damageReduction(0), weakenTurns(0),
+    poisonDamage(0), poisonTurns(0), wetTurns(0), frozen(false), resistances(0),
+    enemyBlock(0), enemyStrength(0), enemyIntent(0), behavior(nullptr),
+    turn(0), handCount(0), drawCount(0), discardCount(0), hand{}, drawPile{}, discard{}, rng(1) {
+}
+
+CombatState CombatState::begin(const CombatDeck& deck, int enemyHP, int enemyDamage, std::uint64_t seed) {
+    CombatState state;
+    state.seed(seed);
+    state.enemyHP = enemyHP;
+    state.enemyMaxHP = enemyHP;
+    state.enemyDamage = enemyDamage;
+    for (CardId card : deck.getCards()) {
+        state.addToDrawPile(card);
+    }
+    for (int i = 0; i < REFILL_HAND; ++i) {
+        state.drawCard();
+    }
+    return state;
+}
+
+void CombatState::setBehavior(const EnemyBehavior* enemyBehavior) {
+    behavior = enemyBehavior;
+    enemyIntent = behavior ? EnemyBehavior::NO_INTENT : 0;
+    pickIntent();
+}
+
+void CombatState::seed(std::uint64_t value) {
+    // splitmix64 spreads nearby seeds apart; xorshift must never be seeded with zero.
+    std::uint64_t z = value + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    rng = z ? z : 1;
+}
+
+std::uint32_t CombatState::random(std::uint32_t bound) {
+    return random(rng, bound);
+}
+
+std::uint32_t CombatState::random(std::uint64_t& state, std::uint32_t bound) {
+    // xorshift64*, then a multiply-shift into [0, bound) instead of a modulo.
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    std::uint32_t bits = static_cast<std::uint32_t>((state * 0x2545F4914F6CDD1Dull) >> 32);
+    return static_cast<std::uint32_t>((static_cast<std::uint64_t>(bits) * bound) >> 32);
+}
+
+int CombatState::incomingDamage() const {
+    if (frozen) {
+        return 0;
+    }
+    if (!behavior) {
+        return std::max(0, enemyDamage + enemyStrength - damageReduction);
+    }
+    const EnemyBehavior::Table& table = behavior->getTable();
+    return table.hits[enemyIntent] * std::max(0, table.damage[enemyIntent] + enemyStrength - damageReduction);
+}
+
+void CombatState::hitEnemy(int damage) {
+    int absorbed = std::min(enemyBlock, damage);
+    enemyBlock -= absorbed;
+    enemyHP -= damage - absorbed;
+}
+
+bool CombatState::canPlay(int handIndex, const CombatDeck& deck) const {
+    return !isOver() && handIndex >= 0 && handIndex < handCount &&
+        deck.getSpec(hand[handIndex]).energyCost <= energy;
+}
+
+void CombatState::playCard(int handIndex, const CombatDeck& deck) {
+    const CardSpec& card = deck.getSpec(hand[handIndex]);
+    energy -= card.energyCost;
+    hitEnemy(card.damage);
+
+    const CardEffect& effect = card.effect;
+    switch (effect.type) {
+    case CardEffectType::Armor:
+        playerArmor += effect.value;
+        break;
+    case CardEffectType::Heal:
+        playerHP = std::min(PLAYER_MAX_HP, playerHP + effect.value);
+        break;
+    case CardEffectType::MultiStrike:
+        for (int i = 0; i < effect.count && enemyHP > 0; ++i) {
+            hitEnemy(effect.value);
+        }
+        break;
+    case CardEffectType::Weaken:
+        if (!resists(CardEffectType::Weaken)) {
+            damageReduction = effect.value;
+            weakenTurns = effect.count;
+        }
+        break;
+    case CardEffectType::Poison:
+        if (!resists(CardEffectType::Poison)) {
+            poisonDamage = effect.value;
+            poisonTurns = effect.count;
+        }
+        break;
+    case CardEffectType::Thorns:
+        hitEnemy(THORNS_DAMAGE);
+        break;
+    case CardEffectType::Wet:
+        if (!resists(CardEffectType::Wet)) {
+            wetTurns = effect.count;
+        }
+        break;
+    case CardEffectType::Lightning:
+        hitEnemy(wetTurns > 0 ? effect.value * 2 : effect.value);
+        break;
+    case CardEffectType::Ice:
+        hitEnemy(effect.value);
+        if (wetTurns > 0 && !resists(CardEffectType::Ice)) {
+            frozen = true;
+        }
+        break;
+    default:
+        break;
+    }
+
+    // Keep the hand order stable so indices line up with the scene's hand row.
+    CardId played = hand[handIndex];
+    for (int i = handIndex + 1; i < handCount; ++i) {
+        hand[i - 1] = hand[i];
+    }
+    --handCount;
+    addToDiscard(played);
+}
+
+void CombatState::endTurn() {
+    if (!isOver()) {
+        enemyAct();
+    }
+    updateEffects();
+    if (!isOver()) {
+        pickIntent();
+    }
+
+    int cardsToDraw = handCount < REFILL_HAND ? REFILL_HAND - handCount : 1;
+    cardsToDraw = std::min(cardsToDraw, MAX_HAND - static_cast<int>(handCount));
+    for (int i = 0; i < cardsToDraw; ++i) {
+        drawCard();
+    }
+    energy = maxEnergy;
+    ++turn;
+}
+
+void CombatState::applyAction(int action, const CombatDeck& deck) {
+    if (action == END_TURN) {
+        endTurn();
+        return;
+    }
+    int handIndex = findInHand(static_cast<CardId>(action));
+    if (handIndex >= 0) {
+        playCard(handIndex, deck);
+    }
+}
+
+void CombatState::drawCard() {
+    if (drawCount == 0 && discardCount > 0) {
+        std::copy(discard, discard + discardCount, drawPile);
+        drawCount = discardCount;
+        discardCount = 0;
+    }
+    if (drawCount > 0 && handCount < MAX_HAND) {
+        std::uint32_t index = random(drawCount);
+        hand[handCount++] = drawPile[index];
+        drawPile[index] = drawPile[--drawCount];
+    }
+}
+
+bool CombatState::addToHand(CardId card) {
+    if (handCount >= MAX_HAND) return false;
+    hand[handCount++] = card;
+    return true;
+}
+
+bool CombatState::addToDrawPile(CardId card) {
+    if (drawCount >= MAX_PILE) return false;
+    drawPile[drawCount++] = card;
+    return true;
+}
+
+bool CombatState::addToDiscard(CardId card) {
+    if (discardCount >= MAX_PILE) return false;
+    discard[discardCount++] = card;
+    return true;
+}
+
+int CombatState::findInHand(CardId card) const {
+    for (int i = 0; i < handCount; ++i) {
+        if (hand[i] == card) return i;
+    }
+    return -1;
+}
+
+void CombatState::enemyAct() {
+    enemyBlock = 0;
+    if (frozen) {
+        frozen = false;
+        return;
+    }
+    // Every intent applies all of its table columns; the ones it does not use are zero.
+    int damage = incomingDamage();
+    int damageAfterArmor = std::max(0, damage - playerArmor);
+    playerArmor = std::max(0, playerArmor - damage);
+    playerHP -= damageAfterArmor;
+    if (!behavior) {
+        return;
+    }
+    const EnemyBehavior::Table& table = behavior->getTable();
+    enemyBlock = table.block[enemyIntent];
+    enemyStrength += table.strength[enemyIntent];
+    bool poisons = table.poisonTurns[enemyIntent] > 0;
+    playerPoison = poisons ? table.poison[enemyIntent] : playerPoison;
+    playerPoisonTurns = poisons ? table.poisonTurns[enemyIntent] : playerPoisonTurns;
+}
+
+void CombatState::pickIntent() {
+    if (!behavior) {
+        return;
+    }
+    if (behavior->getIntentCount() == 1) {
+        enemyIntent = 0; // nothing to pick, and no random number drawn
+        return;
+    }
+    bool lowHP = enemyHP * 2 <= enemyMaxHP;
+    enemyIntent = behavior->pick(EnemyBehavior::row(lowHP, enemyIntent), random(EnemyBehavior::WEIGHT_ONE));
+}
+
+void CombatState::updateEffects() {
+    if (weakenTurns > 0) {
+        --weakenTurns;
+        if (weakenTurns == 0) damageReduction = 0;
+    }
+    if (poisonTurns > 0) {
+        enemyHP -= poisonDamage;
+        --poisonTurns;
+    }
+    if (wetTurns > 0) {
+        --wetTurns;
+    }
+    if (playerPoisonTurns > 0) {
+        playerHP -= playerPoison;
+        --playerPoisonTurns;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,413 @@
+#include "../includes/simulation/DeckOptimizer.h"
+#include "../includes/simulation/BattlePolicy.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace {
+    constexpr int MAX_REWARD_WEIGHT = 9;
+    constexpr std::uint64_t EVALUATION_SEED = 0xDEC0DE;
+    const char* const CHECKPOINT_HEADER = "deck-optimizer 1";
+
+    std::string joinInts(const std::vector<int>& values) {
+        std::string text;
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (i > 0) text += ',';
+            text += std::to_string(values[i]);
+        }
+        return text;
+    }
+
+    bool splitInts(const std::string& text, std::vector<int>& values) {
+        values.clear();
+        std::stringstream stream(text);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            if (item.empty()) return false;
+            values.push_back(std::atoi(item.c_str()));
+        }
+        return true;
+    }
+}
+
+int DeckGenome::getDeckSize() const {
+    int size = 0;
+    for (int count : counts) size += count;
+    return size;
+}
+
+std::vector<CardSpec> DeckGenome::buildDeck() const {
+    const std::vector<CardSpec>& pool = CardLibrary::getCardPool();
+    std::vector<CardSpec> deck;
+    for (size_t i = 0; i < counts.size() && i < pool.size(); ++i) {
+        for (int copy = 0; copy < counts[i]; ++copy) {
+            deck.push_back(pool[i]);
+        }
+    }
+    return deck;
+}
+
+RunPolicy DeckGenome::buildPolicy() const {
+    RunPolicy policy = RunPolicy::defaults();
+    std::vector<int> weights = rewardWeights; // captured by value so the policy stays stateless
+    policy.chooseReward = [weights](const std::vector<CardSpec>&, const std::vector<int>& offer, std::mt19937&) {
+        int best = -1;
+        int bestWeight = 0;
+        for (size_t i = 0; i < offer.size(); ++i) {
+            int weight = offer[i] < static_cast<int>(weights.size()) ? weights[offer[i]] : 0;
+            if (weight > bestWeight) {
+                bestWeight = weight;
+                best = static_cast<int>(i);
+            }
+        }
+        return best;
+    };
+    return policy;
+}
+
+std::string DeckGenome::describe() const {
+    const std::vector<CardSpec>& pool = CardLibrary::getCardPool();
+    std::string text;
+    for (size_t i = 0; i < counts.size() && i < pool.size(); ++i) {
+        if (counts[i] == 0) continue;
+        if (!text.empty()) text += ", ";
+        text += std::to_string(counts[i]) + "x " + pool[i].name;
+    }
+
+    std::vector<int> order;
+    for (size_t i = 0; i < rewardWeights.size() && i < pool.size(); ++i) {
+        if (rewardWeights[i] > 0) order.push_back(static_cast<int>(i));
+    }
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b) { return rewardWeights[a] > rewardWeights[b]; });
+    text += " | rewards: ";
+    if (order.empty()) {
+        text += "skip all";
+    }
+    for (size_t i = 0; i < order.size() && i < 3; ++i) {
+        if (i > 0) text += " > ";
+        text += pool[order[i]].name;
+    }
+    return text;
+}
+
+std::string DeckGenome::toKey() const {
+    return joinInts(counts) + "/" + joinInts(rewardWeights);
+}
+
+bool DeckGenome::fromKey(const std::string& key, DeckGenome& genome) {
+    size_t slash = key.find('/');
+    if (slash == std::string::npos) {
+        return false;
+    }
+    size_t poolSize = CardLibrary::getCardPool().size();
+    return splitInts(key.substr(0, slash), genome.counts) && splitInts(key.substr(slash + 1), genome.rewardWeights) &&
+        genome.counts.size() == poolSize && genome.rewardWeights.size() == poolSize;
+}
+
+DeckOptimizer::DeckOptimizer(const MapGraph& graph, const Config& config)
+    : graph(graph), config(config), rng(static_cast<std::mt19937::result_type>(config.seed)), generation(0) {
+}
+
+DeckFitness DeckOptimizer::evaluate(const DeckGenome& genome) const {
+    std::vector<CardSpec> deck = genome.buildDeck();
+
+    RunSimulator simulator(graph, genome.buildPolicy());
+    RunSimulator::Config runConfig;
+    runConfig.startingCards = deck;
+    runConfig.runs = config.runsPerEvaluation;
+    runConfig.threads = 1; // the population is already spread over threads
+    runConfig.seed = EVALUATION_SEED;
+    RunSimulator::Report report = simulator.simulate(runConfig);
+    double clearRate = report.runs > 0 ? static_cast<double>(report.wins) / report.runs : 0.0;
+
+    CombatDeck combatDeck = CardLibrary::buildCombatDeck(deck);
+    double rosterTotal = 0.0;
+    int enemies = 0;
+    for (int i = 0; i < graph.getNodeCount(); ++i) {
+        const MapNode& node = graph.getNode(i);
+        if (node.type != NodeType::Fight) continue;
+        const EncounterDef& encounter = graph.getEncounter(i);
+        int wins = 0;
+        int hpLeft = 0;
+        for (int battle = 0; battle < config.battlesPerEnemy; ++battle) {
+            CombatState state = CombatState::begin(combatDeck, encounter.hp, encounter.damage, EVALUATION_SEED + battle);
+            state.resistances = encounter.resistances;
+            state.setBehavior(&encounter.behavior);
+            while (!state.isOver() && state.turn < runConfig.maxTurns) {
+                state.applyAction(BattlePolicy::greedy(state, combatDeck), combatDeck);
+            }
+            if (state.hasWon()) {
+                ++wins;
+                hpLeft += std::max(0, state.playerHP);
+            }
+        }
+        if (config.battlesPerEnemy > 0) {
+            double winRate = static_cast<double>(wins) / config.battlesPerEnemy;
+            double hpShare = wins > 0 ? static_cast<double>(hpLeft) / (wins * CombatState::PLAYER_MAX_HP) : 0.0;
+            rosterTotal += winRate * (0.5 + 0.5 * hpShare);
+        }
+        ++enemies;
+    }
+    double rosterScore = enemies > 0 ? rosterTotal / enemies : 0.0;
+
+    return DeckFitness{ 0.7 * clearRate + 0.3 * rosterScore, clearRate, rosterScore };
+}
+
+void DeckOptimizer::evaluatePopulation() {
+    std::vector<const DeckGenome*> pending;
+    std::vector<std::string> pendingKeys;
+    for (const DeckGenome& genome : population) {
+        std::string key = genome.toKey();
+        if (memo.count(key) == 0 && std::find(pendingKeys.begin(), pendingKeys.end(), key) == pendingKeys.end()) {
+            pending.push_back(&genome);
+            pendingKeys.push_back(key);
+        }
+    }
+    if (pending.empty()) {
+        return;
+    }
+
+    std::vector<DeckFitness> results(pending.size());
+    std::atomic<size_t> next(0);
+    auto work = [&]() {
+        for (size_t i = next++; i < pending.size(); i = next++) {
+            results[i] = evaluate(*pending[i]);
+        }
+    };
+
+    int threadCount = config.threads > 0 ? config.threads : static_cast<int>(std::thread::hardware_concurrency());
+    threadCount = std::max(1, std::min(threadCount, static_cast<int>(pending.size())));
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threadCount; ++i) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    for (size_t i = 0; i < pending.size(); ++i) {
+        memo.emplace(pendingKeys[i], Entry{ *pending[i], results[i] });
+    }
+}
+
+const DeckFitness& DeckOptimizer::fitnessOf(const DeckGenome& genome) const {
+    return memo.at(genome.toKey()).fitness;
+}
+
+DeckGenome DeckOptimizer::randomGenome() {
+    size_t poolSize = CardLibrary::getCardPool().size();
+    DeckGenome genome;
+    genome.counts.assign(poolSize, 0);
+    genome.rewardWeights.assign(poolSize, 0);
+    std::uniform_int_distribution<int> weight(0, MAX_REWARD_WEIGHT);
+    for (int& value : genome.rewardWeights) {
+        value = weight(rng);
+    }
+    std::uniform_int_distribution<int> size(config.minDeckSize, config.maxDeckSize);
+    int target = size(rng);
+    std::uniform_int_distribution<size_t> card(0, poolSize - 1);
+    for (int attempts = 0; genome.getDeckSize() < target && attempts < 1000; ++attempts) {
+        int& count = genome.counts[card(rng)];
+        if (count < config.maxCopies) ++count;
+    }
+    repair(genome);
+    return genome;
+}
+
+DeckGenome DeckOptimizer::crossover(const DeckGenome& a, const DeckGenome& b) {
+    DeckGenome child = a;
+    std::bernoulli_distribution coin(0.5);
+    for (size_t i = 0; i < child.counts.size(); ++i) {
+        if (coin(rng)) child.counts[i] = b.counts[i];
+        if (coin(rng)) child.rewardWeights[i] = b.rewardWeights[i];
+    }
+    repair(child);
+    return child;
+}
+
+void DeckOptimizer::mutate(DeckGenome& genome) {
+    std::bernoulli_distribution mutateGene(config.mutationRate);
+    std::bernoulli_distribution coin(0.5);
+    std::uniform_int_distribution<int> weight(0, MAX_REWARD_WEIGHT);
+    for (size_t i = 0; i < genome.counts.size(); ++i) {
+        if (mutateGene(rng)) genome.counts[i] += coin(rng) ? 1 : -1;
+        if (mutateGene(rng)) genome.rewardWeights[i] = weight(rng);
+    }
+    repair(genome);
+}
+
+void DeckOptimizer::repair(DeckGenome& genome) {
+    for (int& count : genome.counts) {
+        count = std::max(0, std::min(config.maxCopies, count));
+    }
+    std::uniform_int_distribution<size_t> card(0, genome.counts.size() - 1);
+    for (int attempts = 0; genome.getDeckSize() > config.maxDeckSize && attempts < 1000; ++attempts) {
+        int& count = genome.counts[card(rng)];
+        if (count > 0) --count;
+    }
+    for (int attempts = 0; genome.getDeckSize() < config.minDeckSize && attempts < 1000; ++attempts) {
+        int& count = genome.counts[card(rng)];
+        if (count < config.maxCopies) ++count;
+    }
+}
+
+const DeckGenome& DeckOptimizer::tournament() {
+    std::uniform_int_distribution<size_t> pick(0, population.size() - 1);
+    const DeckGenome* best = &population[pick(rng)];
+    for (int i = 1; i < config.tournamentSize; ++i) {
+        const DeckGenome* challenger = &population[pick(rng)];
+        if (fitnessOf(*challenger).score > fitnessOf(*best).score) {
+            best = challenger;
+        }
+    }
+    return *best;
+}
+
+void DeckOptimizer::run(const std::function<void(int generation, const Entry& best)>& onGeneration) {
+    if (population.empty()) {
+        for (int i = 0; i < config.population; ++i) {
+            population.push_back(randomGenome());
+        }
+    }
+    evaluatePopulation();
+
+    while (generation < config.generations) {
+        std::vector<DeckGenome> ranked = population;
+        std::stable_sort(ranked.begin(), ranked.end(), [this](const DeckGenome& a, const DeckGenome& b) {
+            return fitnessOf(a).score > fitnessOf(b).score;
+        });
+
+        std::vector<DeckGenome> next(ranked.begin(), ranked.begin() + std::min<size_t>(config.eliteCount, ranked.size()));
+        while (static_cast<int>(next.size()) < config.population) {
+            DeckGenome child = crossover(tournament(), tournament());
+            mutate(child);
+            next.push_back(std::move(child));
+        }
+        population = std::move(next);
+        ++generation;
+        evaluatePopulation();
+
+        if (onGeneration) {
+            const DeckGenome* best = &population.front();
+            for (const DeckGenome& genome : population) {
+                if (fitnessOf(genome).score > fitnessOf(*best).score) best = &genome;
+            }
+            onGeneration(generation, Entry{ *best, fitnessOf(*best) });
+        }
+        if (!config.checkpointPath.empty()) {
+            saveCheckpoint(config.checkpointPath);
+        }
+    }
+}
+
+bool DeckOptimizer::saveCheckpoint(const std::string& path) const {
+    // Written next to the target and renamed over it, so an interrupted save keeps the old checkpoint.
+    std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath);
+        if (!file) {
+            std::cerr << "Failed to write checkpoint " << temporaryPath << "\n";
+            return false;
+        }
+        file << CHECKPOINT_HEADER << "\n";
+        file << "generation " << generation << "\n";
+        file << "rng " << rng << "\n";
+        file << "population " << population.size() << "\n";
+        for (const DeckGenome& genome : population) {
+            file << genome.toKey() << "\n";
+        }
+        file << "memo " << memo.size() << "\n";
+        file.precision(17);
+        for (const auto& entry : memo) {
+            const DeckFitness& fitness = entry.second.fitness;
+            file << entry.first << " " << fitness.score << " " << fitness.runClearRate << " " << fitness.rosterScore << "\n";
+        }
+    }
+    std::remove(path.c_str());
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Failed to move checkpoint into place at " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool DeckOptimizer::loadCheckpoint(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    std::string line;
+    std::string label;
+    size_t count = 0;
+    int savedGeneration = 0;
+    std::mt19937 savedRng;
+    std::vector<DeckGenome> savedPopulation;
+    std::unordered_map<std::string, Entry> savedMemo;
+
+    if (!std::getline(file, line) || line != CHECKPOINT_HEADER ||
+        !(file >> label >> savedGeneration) || label != "generation" ||
+        !(file >> label >> savedRng) || label != "rng" ||
+        !(file >> label >> count) || label != "population") {
+        std::cerr << "Checkpoint " << path << " is not a deck optimizer checkpoint\n";
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        DeckGenome genome;
+        if (!(file >> line) || !DeckGenome::fromKey(line, genome)) {
+            std::cerr << "Checkpoint " << path << " has an invalid genome; was the card pool changed?\n";
+            return false;
+        }
+        savedPopulation.push_back(genome);
+    }
+    if (!(file >> label >> count) || label != "memo") {
+        std::cerr << "Checkpoint " << path << " is truncated\n";
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        Entry entry;
+        if (!(file >> line >> entry.fitness.score >> entry.fitness.runClearRate >> entry.fitness.rosterScore) ||
+            !DeckGenome::fromKey(line, entry.genome)) {
+            std::cerr << "Checkpoint " << path << " has an invalid memo entry\n";
+            return false;
+        }
+        savedMemo.emplace(line, entry);
+    }
+
+    generation = savedGeneration;
+    rng = savedRng;
+    population = std::move(savedPopulation);
+    memo = std::move(savedMemo);
+    return true;
+}
+
+std::vector<DeckOptimizer::Entry> DeckOptimizer::sortedEntries(bool strongestFirst, int count) const {
+    std::vector<Entry> entries;
+    entries.reserve(memo.size());
+    for (const auto& entry : memo) {
+        entries.push_back(entry.second);
+    }
+    std::sort(entries.begin(), entries.end(), [strongestFirst](const Entry& a, const Entry& b) {
+        if (a.fitness.score != b.fitness.score) {
+            return strongestFirst ? a.fitness.score > b.fitness.score : a.fitness.score < b.fitness.score;
+        }
+        return a.genome.toKey() < b.genome.toKey(); // stable report order across runs
+    });
+    if (static_cast<int>(entries.size()) > count) {
+        entries.resize(count);
+    }
+    return entries;
+}
+
+std::vector<DeckOptimizer::Entry> DeckOptimizer::getStrongest(int count) const {
+    return sortedEntries(true, count);
+}
+
+std::vector<DeckOptimizer::Entry> DeckOptimizer::getWeakest(int count) const {
+    return sortedEntries(false, count);
+}
\ No newline at end of file
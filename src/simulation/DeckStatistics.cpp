@@ -0,0 +1,425 @@
+#include "../includes/simulation/DeckStatistics.h"
+#include "../includes/simulation/CombatState.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    constexpr int MAX_SPECS = CombatDeck::MAX_SPECS;
+
+    struct Position {
+        std::uint8_t hand[MAX_SPECS];
+        std::uint8_t draw[MAX_SPECS];
+        std::uint8_t handCount;
+        std::uint8_t drawCount;
+        std::uint8_t wetTurns;
+        std::uint8_t poisonDamage;
+        std::uint8_t poisonTurns;
+        std::uint16_t damage;       // dealt so far, capped at the enemy's HP (kill passes only)
+    };
+
+    struct Key {
+        std::uint64_t piles;
+        std::uint64_t statuses;
+
+        bool operator==(const Key& other) const { return piles == other.piles && statuses == other.statuses; }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            std::uint64_t h = key.piles * 0x9E3779B97F4A7C15ull ^ key.statuses;
+            return static_cast<size_t>(h ^ (h >> 29));
+        }
+    };
+
+    struct Model {
+        const CombatDeck* deck;
+        int specCount;
+        int total;
+        int copies[MAX_SPECS];
+        // Each spec's (hand, draw) pair is one digit of a mixed-radix number; the
+        // digits only cover pairs with hand + draw <= copies.
+        std::uint64_t placeValue[MAX_SPECS];
+        int playOrder[MAX_SPECS];
+    };
+
+    int pairIndex(int hand, int draw, int copies) {
+        return hand * (copies + 1) - hand * (hand - 1) / 2 + draw;
+    }
+
+    Key makeKey(const Model& model, const Position& position) {
+        Key key{ 0, 0 };
+        for (int s = 0; s < model.specCount; ++s) {
+            key.piles += model.placeValue[s] * static_cast<std::uint64_t>(pairIndex(position.hand[s], position.draw[s], model.copies[s]));
+        }
+        key.statuses = position.wetTurns | (static_cast<std::uint64_t>(position.poisonDamage) << 8) |
+            (static_cast<std::uint64_t>(position.poisonTurns) << 16) | (static_cast<std::uint64_t>(position.damage) << 24);
+        return key;
+    }
+
+    // The probability mass of every distinct position reached at one point of
+    // the turn. Open addressing over flat arrays, since each layer is cleared and
+    // refilled every turn.
+    struct Layer {
+        std::vector<std::int32_t> slots;    // index into positions, or -1
+        std::vector<Key> keys;
+        std::vector<Position> positions;
+        std::vector<double> weights;
+
+        Layer() : slots(1024, -1) {}
+
+        void add(const Model& model, const Position& position, double weight) {
+            Key key = makeKey(model, position);
+            size_t mask = slots.size() - 1;
+            for (size_t slot = KeyHash()(key) & mask;; slot = (slot + 1) & mask) {
+                std::int32_t index = slots[slot];
+                if (index < 0) {
+                    slots[slot] = static_cast<std::int32_t>(positions.size());
+                    keys.push_back(key);
+                    positions.push_back(position);
+                    weights.push_back(weight);
+                    break;
+                }
+                if (keys[index] == key) {
+                    weights[index] += weight;
+                    return;
+                }
+            }
+            if (positions.size() * 2 > slots.size()) {
+                grow();
+            }
+        }
+
+        void grow() {
+            std::vector<std::int32_t>(slots.size() * 2, -1).swap(slots);
+            size_t mask = slots.size() - 1;
+            for (size_t index = 0; index < keys.size(); ++index) {
+                size_t slot = KeyHash()(keys[index]) & mask;
+                while (slots[slot] >= 0) slot = (slot + 1) & mask;
+                slots[slot] = static_cast<std::int32_t>(index);
+            }
+        }
+
+        void clear() {
+            std::fill(slots.begin(), slots.end(), -1);
+            keys.clear();
+            positions.clear();
+            weights.clear();
+        }
+    };
+
+    // Same value scale as a card's face: damage dealt plus armor gained, with heals at half.
+    double cardValue(const CardSpec& card) {
+        const CardEffect& effect = card.effect;
+        double value = card.damage;
+        switch (effect.type) {
+        case CardEffectType::Armor: value += effect.value; break;
+        case CardEffectType::Heal: value += 0.5 * effect.value; break;
+        case CardEffectType::MultiStrike: value += effect.value * effect.count; break;
+        case CardEffectType::Poison: value += effect.value * effect.count; break;
+        case CardEffectType::Thorns: value += CombatState::THORNS_DAMAGE; break;
+        case CardEffectType::Lightning: value += effect.value; break;
+        case CardEffectType::Ice: value += effect.value; break;
+        default: break;
+        }
+        return value;
+    }
+
+    bool buildModel(const CombatDeck& deck, Model& model) {
+        model.deck = &deck;
+        model.specCount = deck.getSpecCount();
+        model.total = static_cast<int>(deck.getCards().size());
+        std::fill(model.copies, model.copies + MAX_SPECS, 0);
+        for (CombatDeck::CardId card : deck.getCards()) {
+            ++model.copies[card];
+        }
+
+        std::uint64_t place = 1;
+        for (int s = 0; s < model.specCount; ++s) {
+            model.placeValue[s] = place;
+            std::uint64_t digits = static_cast<std::uint64_t>(model.copies[s] + 1) * (model.copies[s] + 2) / 2;
+            if (place > std::numeric_limits<std::uint64_t>::max() / digits) {
+                std::cerr << "Deck has too many distinct cards for exact statistics\n";
+                return false;
+            }
+            place *= digits;
+        }
+
+        bool exploitsWet = false;
+        for (int s = 0; s < model.specCount; ++s) {
+            CardEffectType type = deck.getSpec(s).effect.type;
+            exploitsWet = exploitsWet || type == CardEffectType::Lightning || type == CardEffectType::Ice;
+            model.playOrder[s] = s;
+        }
+        auto priority = [&deck, exploitsWet](int spec) {
+            const CardSpec& card = deck.getSpec(spec);
+            if (exploitsWet && card.effect.type == CardEffectType::Wet) {
+                return std::numeric_limits<double>::max();
+            }
+            return cardValue(card) / std::max(1, card.energyCost);
+        };
+        std::stable_sort(model.playOrder, model.playOrder + model.specCount, [&priority](int a, int b) {
+            return priority(a) > priority(b);
+        });
+        return true;
+    }
+
+    // Binomial coefficients up to a full pile, exact in a double.
+    struct Choose {
+        double table[CombatState::MAX_PILE + 1][CombatState::MAX_HAND + 1];
+
+        Choose() {
+            for (int n = 0; n <= CombatState::MAX_PILE; ++n) {
+                for (int k = 0; k <= CombatState::MAX_HAND; ++k) {
+                    table[n][k] = k == 0 ? 1.0 : (n == 0 ? 0.0 : table[n - 1][k - 1] + (k <= n - 1 ? table[n - 1][k] : 0.0));
+                }
+            }
+        }
+    };
+    const Choose choose;
+
+    // Every multiset of `remaining` cards from the draw pile, weighted by the
+    // number of ways to pick it.
+    void drawMultiset(const Model& model, Position& position, int spec, int remaining, double weight, Layer& out) {
+        if (remaining == 0) {
+            out.add(model, position, weight);
+            return;
+        }
+        if (spec == model.specCount) {
+            return;
+        }
+        int available = position.draw[spec];
+        for (int taken = 0; taken <= available && taken <= remaining; ++taken) {
+            position.draw[spec] = static_cast<std::uint8_t>(available - taken);
+            position.hand[spec] = static_cast<std::uint8_t>(position.hand[spec] + taken);
+            drawMultiset(model, position, spec + 1, remaining - taken, weight * choose.table[available][taken], out);
+            position.hand[spec] = static_cast<std::uint8_t>(position.hand[spec] - taken);
+        }
+        position.draw[spec] = static_cast<std::uint8_t>(available);
+    }
+
+    // Draws `cards` like repeated CombatState::drawCard calls. Order inside a draw
+    // does not matter, so each outcome is one multiset with its hypergeometric
+    // weight; a pile that cannot cover the draw is taken whole and the discard
+    // pile reshuffled for the rest, exactly when drawCard would do it.
+    void drawInto(const Model& model, Position position, int cards, double weight, Layer& out) {
+        while (cards > 0) {
+            if (position.drawCount == 0) {
+                if (model.total <= position.handCount) break;
+                for (int s = 0; s < model.specCount; ++s) {
+                    position.draw[s] = static_cast<std::uint8_t>(model.copies[s] - position.hand[s]);
+                }
+                position.drawCount = static_cast<std::uint8_t>(model.total - position.handCount);
+            }
+            if (position.drawCount > cards) break;
+            for (int s = 0; s < model.specCount; ++s) {
+                position.hand[s] = static_cast<std::uint8_t>(position.hand[s] + position.draw[s]);
+                position.draw[s] = 0;
+            }
+            position.handCount = static_cast<std::uint8_t>(position.handCount + position.drawCount);
+            cards -= position.drawCount;
+            position.drawCount = 0;
+        }
+        if (cards == 0 || position.drawCount == 0) {
+            out.add(model, position, weight);
+            return;
+        }
+
+        double perOutcome = weight / choose.table[position.drawCount][cards];
+        position.drawCount = static_cast<std::uint8_t>(position.drawCount - cards);
+        position.handCount = static_cast<std::uint8_t>(position.handCount + cards);
+        drawMultiset(model, position, 0, cards, perOutcome, out);
+    }
+
+    struct TurnResult {
+        int damage;
+        int armor;
+    };
+
+    // Plays the turn by the fixed rule and resolves the end-of-turn status ticks.
+    TurnResult playTurn(const Model& model, Position& position) {
+        TurnResult result{ 0, 0 };
+        int energy = CombatState::PLAYER_MAX_ENERGY;
+        for (int i = 0; i < model.specCount; ++i) {
+            int s = model.playOrder[i];
+            const CardSpec& card = model.deck->getSpec(s);
+            while (position.hand[s] > 0 && card.energyCost <= energy) {
+                energy -= card.energyCost;
+                --position.hand[s];
+                --position.handCount;
+                result.damage += card.damage;
+                const CardEffect& effect = card.effect;
+                switch (effect.type) {
+                case CardEffectType::Armor:
+                    result.armor += effect.value;
+                    break;
+                case CardEffectType::MultiStrike:
+                    result.damage += effect.value * effect.count;
+                    break;
+                case CardEffectType::Poison:
+                    position.poisonDamage = static_cast<std::uint8_t>(effect.value);
+                    position.poisonTurns = static_cast<std::uint8_t>(effect.count);
+                    break;
+                case CardEffectType::Thorns:
+                    result.damage += CombatState::THORNS_DAMAGE;
+                    break;
+                case CardEffectType::Wet:
+                    position.wetTurns = static_cast<std::uint8_t>(effect.count);
+                    break;
+                case CardEffectType::Lightning:
+                    result.damage += position.wetTurns > 0 ? effect.value * 2 : effect.value;
+                    break;
+                case CardEffectType::Ice:
+                    result.damage += effect.value;
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+
+        // CombatState::updateEnemyEffects
+        if (position.poisonTurns > 0) {
+            result.damage += position.poisonDamage;
+            --position.poisonTurns;
+        }
+        if (position.wetTurns > 0) {
+            --position.wetTurns;
+        }
+        return result;
+    }
+
+    int cardsToDraw(const Position& position) {
+        int cards = position.handCount < CombatState::REFILL_HAND ? CombatState::REFILL_HAND - position.handCount : 1;
+        return std::min(cards, CombatState::MAX_HAND - static_cast<int>(position.handCount));
+    }
+
+    Position openingPiles(const Model& model) {
+        Position position = {};
+        for (int s = 0; s < model.specCount; ++s) {
+            position.draw[s] = static_cast<std::uint8_t>(model.copies[s]);
+        }
+        position.drawCount = static_cast<std::uint8_t>(model.total);
+        return position;
+    }
+
+    // Chance each enemy is dead by the end of each turn. Damage only grows, so
+    // one pass capped at the toughest enemy answers every threshold; positions
+    // that reach the cap stop branching, which keeps the damage dimension from
+    // multiplying the table.
+    std::vector<std::vector<double>> killChances(const Model& model, const std::vector<int>& enemyHP, int turns, size_t& peakPositions) {
+        std::vector<std::vector<double>> killed(enemyHP.size(), std::vector<double>(turns, 0.0));
+        int cap = 1;
+        for (int hp : enemyHP) {
+            cap = std::max(cap, std::min(hp, static_cast<int>(std::numeric_limits<std::uint16_t>::max())));
+        }
+
+        Layer current;
+        Layer next;
+        drawInto(model, openingPiles(model), CombatState::REFILL_HAND, 1.0, current);
+        double dead = 0.0;
+        for (int turn = 0; turn < turns; ++turn) {
+            peakPositions = std::max(peakPositions, current.positions.size());
+            next.clear();
+            for (size_t enemy = 0; enemy < enemyHP.size(); ++enemy) {
+                killed[enemy][turn] = dead;
+            }
+            for (size_t i = 0; i < current.positions.size(); ++i) {
+                Position position = current.positions[i];
+                double weight = current.weights[i];
+                TurnResult result = playTurn(model, position);
+                position.damage = static_cast<std::uint16_t>(std::min(cap, position.damage + result.damage));
+                for (size_t enemy = 0; enemy < enemyHP.size(); ++enemy) {
+                    if (position.damage >= enemyHP[enemy]) killed[enemy][turn] += weight;
+                }
+                if (position.damage >= cap) {
+                    dead += weight;
+                    continue;
+                }
+                drawInto(model, position, cardsToDraw(position), weight, next);
+            }
+            std::swap(current, next);
+        }
+        return killed;
+    }
+}
+
+double DeckReport::getExpectedTurnsToKill(int enemy) const {
+    const std::vector<double>& killed = killedBy[enemy];
+    double expected = 0.0;
+    double previous = 0.0;
+    for (size_t turn = 0; turn < killed.size(); ++turn) {
+        expected += (turn + 1) * (killed[turn] - previous);
+        previous = killed[turn];
+    }
+    return expected + (killed.size() + 1) * (1.0 - previous);
+}
+
+double DeckReport::getMeanDamagePerTurn() const {
+    double total = 0.0;
+    for (const auto& turn : turns) total += turn.expectedDamage;
+    return turns.empty() ? 0.0 : total / turns.size();
+}
+
+double DeckReport::getMeanArmorPerTurn() const {
+    double total = 0.0;
+    for (const auto& turn : turns) total += turn.expectedArmor;
+    return turns.empty() ? 0.0 : total / turns.size();
+}
+
+bool DeckStatistics::analyze(const CombatDeck& deck, const std::vector<int>& enemyHP, int turns, DeckReport& report) {
+    Clock::time_point start = Clock::now();
+    report = DeckReport{ {}, {}, 0, 0.0 };
+    turns = std::max(1, std::min(turns, MAX_TURNS));
+
+    Model model;
+    if (!buildModel(deck, model)) {
+        return false;
+    }
+
+    // Per-turn odds do not depend on the enemy, so this pass ignores damage dealt so far.
+    Layer current;
+    Layer next;
+    drawInto(model, openingPiles(model), CombatState::REFILL_HAND, 1.0, current);
+    for (int turn = 0; turn < turns; ++turn) {
+        report.peakPositions = std::max(report.peakPositions, current.positions.size());
+        DeckTurnStats stats{ std::vector<double>(model.specCount, 0.0), 0.0, 0.0 };
+        next.clear();
+        for (size_t i = 0; i < current.positions.size(); ++i) {
+            Position position = current.positions[i];
+            double weight = current.weights[i];
+            for (int s = 0; s < model.specCount; ++s) {
+                if (position.hand[s] > 0) stats.inHand[s] += weight;
+            }
+            TurnResult result = playTurn(model, position);
+            stats.expectedDamage += weight * result.damage;
+            stats.expectedArmor += weight * result.armor;
+            drawInto(model, position, cardsToDraw(position), weight, next);
+        }
+        report.turns.push_back(std::move(stats));
+        std::swap(current, next);
+    }
+
+    if (!enemyHP.empty()) {
+        report.killedBy = killChances(model, enemyHP, turns, report.peakPositions);
+    }
+
+    report.elapsedUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    return true;
+}
+
+double DeckStatistics::atLeastOne(int population, int copies, int draws) {
+    if (copies <= 0 || draws <= 0 || population <= 0) {
+        return 0.0;
+    }
+    // 1 - C(population - copies, draws) / C(population, draws), as a running product.
+    double none = 1.0;
+    for (int i = 0; i < draws && i < population; ++i) {
+        none *= static_cast<double>(population - copies - i) / (population - i);
+        if (none <= 0.0) return 1.0;
+    }
+    return 1.0 - none;
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "../includes/simulation/EnemyBehavior.h"
+#include <algorithm>
+#include <charconv>
+#include <sstream>
+
+EnemyBehavior::EnemyBehavior() : table{}, count(0) {
+    for (auto& row : table.thresholds) {
+        std::fill(std::begin(row), std::end(row), static_cast<std::int32_t>(WEIGHT_ONE));
+    }
+}
+
+EnemyBehavior EnemyBehavior::attackOnly(int damage) {
+    EnemyBehavior behavior;
+    std::string error;
+    behavior.compile({ IntentDef{ IntentType::Attack, damage, 1, 0, 1, 1, true } }, 0, error);
+    return behavior;
+}
+
+bool EnemyBehavior::compile(const std::vector<IntentDef>& intents, int damageBonus, std::string& error) {
+    *this = EnemyBehavior();
+    if (intents.empty() || intents.size() > static_cast<size_t>(MAX_INTENTS)) {
+        error = "an enemy needs between 1 and " + std::to_string(MAX_INTENTS) + " intents";
+        return false;
+    }
+    count = static_cast<int>(intents.size());
+
+    for (int i = 0; i < count; ++i) {
+        const IntentDef& intent = intents[i];
+        table.type[i] = static_cast<std::int32_t>(intent.type);
+        switch (intent.type) {
+        case IntentType::Attack:
+            table.damage[i] = std::max(0, intent.value + damageBonus);
+            table.hits[i] = std::max(1, intent.hits);
+            break;
+        case IntentType::Block:
+            table.block[i] = intent.value;
+            break;
+        case IntentType::Buff:
+            table.strength[i] = intent.value;
+            break;
+        case IntentType::Poison:
+            table.poison[i] = intent.value;
+            table.poisonTurns[i] = std::max(1, intent.turns);
+            break;
+        }
+    }
+
+    for (int lowHP = 0; lowHP < 2; ++lowHP) {
+        for (int last = 0; last <= MAX_INTENTS; ++last) {
+            long long weights[MAX_INTENTS] = {};
+            long long total = 0;
+            for (int i = 0; i < count; ++i) {
+                bool blocked = !intents[i].repeat && i == last;
+                weights[i] = blocked ? 0 : std::max(0, lowHP ? intents[i].lowHPWeight : intents[i].weight);
+                total += weights[i];
+            }
+            bool reachable = last < count || last == NO_INTENT;
+            if (total == 0) {
+                if (reachable) {
+                    std::ostringstream message;
+                    message << "no intent can follow " << (last == NO_INTENT ? "the start of the fight" : "intent " + std::to_string(last + 1))
+                        << (lowHP ? " at low HP" : "");
+                    error = message.str();
+                    return false;
+                }
+                continue; // never used; keeps the WEIGHT_ONE fill
+            }
+            std::int32_t* thresholds = table.thresholds[row(lowHP != 0, last)];
+            long long prefix = 0;
+            for (int i = 0; i < count; ++i) {
+                prefix += weights[i];
+                thresholds[i] = static_cast<std::int32_t>(prefix * WEIGHT_ONE / total);
+            }
+        }
+    }
+    return true;
+}
+
+double EnemyBehavior::probability(int row, int intent) const {
+    const std::int32_t* thresholds = table.thresholds[row];
+    std::int32_t low = intent > 0 ? thresholds[intent - 1] : 0;
+    return static_cast<double>(thresholds[intent] - low) / WEIGHT_ONE;
+}
+
+namespace {
+    void appendNumber(std::pmr::string& text, int value) {
+        char digits[16];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        text.append(digits, result.ptr);
+    }
+}
+
+void EnemyBehavior::describe(int intent, int attackBonus, std::pmr::string& text) const {
+    switch (static_cast<IntentType>(table.type[intent])) {
+    case IntentType::Attack:
+        text += "Attack ";
+        appendNumber(text, std::max(0, table.damage[intent] + attackBonus));
+        if (table.hits[intent] > 1) {
+            text += "x";
+            appendNumber(text, table.hits[intent]);
+        }
+        break;
+    case IntentType::Block:
+        text += "Block ";
+        appendNumber(text, table.block[intent]);
+        break;
+    case IntentType::Buff:
+        text += "Buff +";
+        appendNumber(text, table.strength[intent]);
+        break;
+    case IntentType::Poison:
+        text += "Poison ";
+        appendNumber(text, table.poison[intent]);
+        text += " for ";
+        appendNumber(text, table.poisonTurns[intent]);
+        text += " turns";
+        break;
+    }
+}
+
+bool EnemyBehavior::parseType(const std::string& name, IntentType& type) {
+    if (name == "attack") type = IntentType::Attack;
+    else if (name == "block") type = IntentType::Block;
+    else if (name == "buff") type = IntentType::Buff;
+    else if (name == "poison") type = IntentType::Poison;
+    else return false;
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,264 @@
+#include "../includes/simulation/EnemyTable.h"
+#include "../includes/simulation/CombatState.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+namespace {
+    // Splits "key=value"; returns false for a bare word.
+    bool splitOption(const std::string& token, std::string& key, std::string& value) {
+        size_t equals = token.find('=');
+        if (equals == std::string::npos) {
+            return false;
+        }
+        key = token.substr(0, equals);
+        value = token.substr(equals + 1);
+        return true;
+    }
+
+    bool parseInt(const std::string& text, int& value) {
+        char* end = nullptr;
+        long parsed = std::strtol(text.c_str(), &end, 10);
+        if (text.empty() || *end != '\0') {
+            return false;
+        }
+        value = static_cast<int>(parsed);
+        return true;
+    }
+}
+
+namespace {
+    // Every table getDefault() has handed out; the last one is current.
+    struct DefaultTables {
+        std::vector<std::unique_ptr<EnemyTable>> versions;
+        std::atomic<const EnemyTable*> current;
+
+        DefaultTables() {
+            versions.push_back(std::make_unique<EnemyTable>());
+            versions.back()->loadFromFile(EnemyTable::DEFAULT_PATH);
+            current = versions.back().get();
+        }
+    };
+
+    DefaultTables& defaultTables() {
+        static DefaultTables tables;
+        return tables;
+    }
+}
+
+const EnemyTable& EnemyTable::getDefault() {
+    return *defaultTables().current.load(std::memory_order_acquire);
+}
+
+bool EnemyTable::reloadDefault() {
+    auto table = std::make_unique<EnemyTable>();
+    if (!table->loadFromFile(DEFAULT_PATH)) {
+        return false; // the error is reported; the current table stays
+    }
+    const EnemyTable& current = getDefault();
+    for (int i = 0; i < current.getEncounterCount(); ++i) {
+        if (i >= table->getEncounterCount() || table->encounters[i].id != current.encounters[i].id) {
+            std::cerr << DEFAULT_PATH << ": encounter " << current.encounters[i].id
+                << " was moved or removed; restart to apply\n";
+            return false;
+        }
+    }
+    DefaultTables& tables = defaultTables();
+    tables.current.store(table.get(), std::memory_order_release);
+    tables.versions.push_back(std::move(table));
+    std::cout << "Reloaded enemy table from " << DEFAULT_PATH << "\n";
+    return true;
+}
+
+bool EnemyTable::loadFromFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open enemy table " << path << "\n";
+        enemies.clear();
+        encounters.clear();
+        return false;
+    }
+    return load(file, path);
+}
+
+bool EnemyTable::load(std::istream& in, const std::string& source) {
+    enemies.clear();
+    encounters.clear();
+    auto fail = [&](int lineNumber, const std::string& message) {
+        std::cerr << source << ":" << lineNumber << ": " << message << "\n";
+        enemies.clear();
+        encounters.clear();
+        return false;
+    };
+
+    std::string line;
+    for (int lineNumber = 1; std::getline(in, line); ++lineNumber) {
+        std::istringstream tokens(line);
+        std::string kind;
+        if (!(tokens >> kind) || kind[0] == '#') {
+            continue;
+        }
+
+        if (kind == "enemy") {
+            EnemyDef enemy{ "", "", 0, 0, 0, 0, 0, {} };
+            if (!(tokens >> enemy.id >> enemy.name)) {
+                return fail(lineNumber, "expected an enemy id and name");
+            }
+            if (findEnemy(enemy.id) >= 0) {
+                return fail(lineNumber, "duplicate enemy " + enemy.id);
+            }
+            std::replace(enemy.name.begin(), enemy.name.end(), '_', ' ');
+            std::string token, key, value;
+            while (tokens >> token) {
+                if (!splitOption(token, key, value)) {
+                    return fail(lineNumber, "expected key=value, got " + token);
+                }
+                bool ok = true;
+                if (key == "hp") ok = parseInt(value, enemy.hp);
+                else if (key == "damage") ok = parseInt(value, enemy.damage);
+                else if (key == "hpPerAct") ok = parseInt(value, enemy.hpPerAct);
+                else if (key == "damagePerAct") ok = parseInt(value, enemy.damagePerAct);
+                else if (key == "resist") {
+                    std::istringstream statuses(value);
+                    std::string status;
+                    while (ok && std::getline(statuses, status, ',')) {
+                        std::uint16_t bit = parseResistance(status);
+                        ok = bit != 0;
+                        enemy.resistances |= bit;
+                    }
+                }
+                else {
+                    return fail(lineNumber, "unknown enemy field " + key);
+                }
+                if (!ok) {
+                    return fail(lineNumber, "bad value for " + key + ": " + value);
+                }
+            }
+            if (enemy.hp <= 0 || enemy.damage < 0) {
+                return fail(lineNumber, "enemy " + enemy.id + " needs hp > 0 and damage >= 0");
+            }
+            enemies.push_back(enemy);
+        }
+        else if (kind == "intent") {
+            std::string enemyId, typeName;
+            if (!(tokens >> enemyId >> typeName)) {
+                return fail(lineNumber, "expected an enemy id and intent type");
+            }
+            int index = findEnemy(enemyId);
+            if (index < 0) {
+                return fail(lineNumber, "unknown enemy " + enemyId);
+            }
+            for (const EncounterDef& encounter : encounters) {
+                if (encounter.enemy == index) {
+                    return fail(lineNumber, "intents for " + enemyId + " must come before its encounters");
+                }
+            }
+            IntentDef intent{ IntentType::Attack, 0, 1, 1, 1, -1, true };
+            if (!EnemyBehavior::parseType(typeName, intent.type)) {
+                return fail(lineNumber, "unknown intent type " + typeName);
+            }
+            std::string token, key, value;
+            while (tokens >> token) {
+                if (!splitOption(token, key, value)) {
+                    return fail(lineNumber, "expected key=value, got " + token);
+                }
+                bool ok = true;
+                if (key == "value") ok = parseInt(value, intent.value) && intent.value >= 0;
+                else if (key == "hits") ok = parseInt(value, intent.hits) && intent.hits >= 1;
+                else if (key == "turns") ok = parseInt(value, intent.turns) && intent.turns >= 1;
+                else if (key == "weight") ok = parseInt(value, intent.weight) && intent.weight >= 0;
+                else if (key == "lowHpWeight") ok = parseInt(value, intent.lowHPWeight) && intent.lowHPWeight >= 0;
+                else if (key == "repeat") {
+                    ok = value == "yes" || value == "no";
+                    intent.repeat = value == "yes";
+                }
+                else {
+                    return fail(lineNumber, "unknown intent field " + key);
+                }
+                if (!ok) {
+                    return fail(lineNumber, "bad value for " + key + ": " + value);
+                }
+            }
+            if (intent.lowHPWeight < 0) {
+                intent.lowHPWeight = intent.weight;
+            }
+            if (enemies[index].intents.size() >= static_cast<size_t>(EnemyBehavior::MAX_INTENTS)) {
+                return fail(lineNumber, "more than " + std::to_string(EnemyBehavior::MAX_INTENTS) + " intents for " + enemyId);
+            }
+            enemies[index].intents.push_back(intent);
+        }
+        else if (kind == "encounter") {
+            EncounterDef encounter{ "", -1, 1, "", 0, 0, 0, EnemyBehavior() };
+            std::string enemyId;
+            if (!(tokens >> encounter.id >> enemyId)) {
+                return fail(lineNumber, "expected an encounter id and enemy id");
+            }
+            if (findEncounter(encounter.id) >= 0) {
+                return fail(lineNumber, "duplicate encounter " + encounter.id);
+            }
+            encounter.enemy = findEnemy(enemyId);
+            if (encounter.enemy < 0) {
+                return fail(lineNumber, "unknown enemy " + enemyId);
+            }
+            std::string token, key, value;
+            while (tokens >> token) {
+                if (!splitOption(token, key, value) || key != "act") {
+                    return fail(lineNumber, "unknown encounter field " + token);
+                }
+                if (!parseInt(value, encounter.act) || encounter.act < 1) {
+                    return fail(lineNumber, "bad act " + value);
+                }
+            }
+            const EnemyDef& enemy = enemies[encounter.enemy];
+            encounter.name = enemy.name;
+            encounter.hp = enemy.hp + enemy.hpPerAct * (encounter.act - 1);
+            encounter.damage = enemy.damage + enemy.damagePerAct * (encounter.act - 1);
+            encounter.resistances = enemy.resistances;
+            int damageBonus = enemy.damagePerAct * (encounter.act - 1);
+            if (enemy.intents.empty()) {
+                encounter.behavior = EnemyBehavior::attackOnly(encounter.damage);
+            }
+            else {
+                std::string error;
+                if (!encounter.behavior.compile(enemy.intents, damageBonus, error)) {
+                    return fail(lineNumber, enemy.id + ": " + error);
+                }
+            }
+            encounters.push_back(encounter);
+        }
+        else {
+            return fail(lineNumber, "unknown entry " + kind);
+        }
+    }
+    return true;
+}
+
+int EnemyTable::findEnemy(const std::string& id) const {
+    for (size_t i = 0; i < enemies.size(); ++i) {
+        if (enemies[i].id == id) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+int EnemyTable::findEncounter(const std::string& id) const {
+    for (size_t i = 0; i < encounters.size(); ++i) {
+        if (encounters[i].id == id) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+std::uint16_t EnemyTable::parseResistance(const std::string& status) {
+    if (status == "weaken") return CombatState::resistanceBit(CardEffectType::Weaken);
+    if (status == "poison") return CombatState::resistanceBit(CardEffectType::Poison);
+    if (status == "wet") return CombatState::resistanceBit(CardEffectType::Wet);
+    if (status == "freeze") return CombatState::resistanceBit(CardEffectType::Ice);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,263 @@
+#include "../includes/simulation/EventLog.h"
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <random>
+
+namespace {
+    void putVarint(std::vector<unsigned char>& out, std::uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<unsigned char>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<unsigned char>(value));
+    }
+
+    void putU32(std::vector<unsigned char>& out, std::uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            out.push_back(static_cast<unsigned char>(value >> (8 * i)));
+        }
+    }
+
+    std::uint64_t zigzag(std::int64_t value) {
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+
+    std::int64_t unzigzag(std::uint64_t value) {
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+
+    void encodeColumn(const std::vector<std::int64_t>& values, std::vector<unsigned char>& out) {
+        std::int64_t previous = 0;
+        size_t i = 0;
+        while (i < values.size()) {
+            std::int64_t delta = values[i] - previous;
+            size_t run = 1;
+            while (i + run < values.size() && values[i + run] - values[i + run - 1] == delta) {
+                ++run;
+            }
+            putVarint(out, run);
+            putVarint(out, zigzag(delta));
+            previous = values[i + run - 1];
+            i += run;
+        }
+    }
+
+    struct Reader {
+        const unsigned char* at;
+        const unsigned char* end;
+
+        bool varint(std::uint64_t& value) {
+            value = 0;
+            for (int shift = 0; shift < 64 && at < end; shift += 7) {
+                unsigned char byte = *at++;
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool u32(std::uint32_t& value) {
+            if (end - at < 4) {
+                return false;
+            }
+            value = 0;
+            for (int i = 0; i < 4; ++i) {
+                value |= static_cast<std::uint32_t>(*at++) << (8 * i);
+            }
+            return true;
+        }
+    };
+
+    bool decodeColumn(Reader& reader, std::uint64_t size, int rows, std::vector<std::int64_t>& values) {
+        if (size > static_cast<std::uint64_t>(reader.end - reader.at)) {
+            return false;
+        }
+        Reader column{ reader.at, reader.at + size };
+        reader.at += size;
+        values.clear();
+        values.reserve(rows);
+        std::int64_t value = 0;
+        while (column.at < column.end) {
+            std::uint64_t run = 0;
+            std::uint64_t delta = 0;
+            if (!column.varint(run) || !column.varint(delta) || run > static_cast<std::uint64_t>(rows) - values.size()) {
+                return false;
+            }
+            for (std::uint64_t i = 0; i < run; ++i) {
+                value += unzigzag(delta);
+                values.push_back(value);
+            }
+        }
+        return static_cast<int>(values.size()) == rows;
+    }
+
+    // The effect a play actually put on the board.
+    CardEffectType appliedEffect(const CardSpec& card, const CombatState& before) {
+        CardEffectType type = card.effect.type;
+        switch (type) {
+        case CardEffectType::Weaken:
+        case CardEffectType::Poison:
+        case CardEffectType::Wet:
+            return before.resists(type) ? CardEffectType::None : type;
+        case CardEffectType::Ice:
+            return before.wetTurns > 0 && !before.resists(type) ? type : CardEffectType::None;
+        default:
+            return type;
+        }
+    }
+}
+
+bool EventLog::open(const std::string& path) {
+    file.open(path, std::ios::binary | std::ios::app);
+    if (!file) {
+        std::cerr << "Failed to open event log " << path << "\n";
+        return false;
+    }
+    std::random_device device;
+    session = static_cast<std::int64_t>((static_cast<std::uint64_t>(device()) << 31) ^ device());
+    return true;
+}
+
+void EventLog::write(const std::vector<unsigned char>& chunk) {
+    std::lock_guard<std::mutex> lock(mutex);
+    file.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+    file.flush();
+}
+
+bool EventLog::read(const std::string& path, const std::function<void(const Chunk&)>& visit) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Failed to open event log " << path << "\n";
+        return false;
+    }
+    std::vector<unsigned char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    Reader reader{ data.data(), data.data() + data.size() };
+    Chunk chunk;
+    while (reader.at < reader.end) {
+        std::uint32_t version = 0;
+        std::uint32_t rows = 0;
+        std::uint32_t wordCount = 0;
+        bool ok = reader.end - reader.at >= 4 && std::memcmp(reader.at, MAGIC, sizeof(MAGIC)) == 0;
+        if (ok) {
+            reader.at += sizeof(MAGIC);
+            ok = reader.u32(version) && version == VERSION && reader.u32(rows) && reader.u32(wordCount);
+        }
+        chunk.rows = static_cast<int>(rows);
+        chunk.words.clear();
+        for (std::uint32_t i = 0; ok && i < wordCount; ++i) {
+            std::uint64_t length = 0;
+            ok = reader.varint(length) && length <= static_cast<std::uint64_t>(reader.end - reader.at);
+            if (ok) {
+                chunk.words.emplace_back(reinterpret_cast<const char*>(reader.at), static_cast<size_t>(length));
+                reader.at += length;
+            }
+        }
+        for (int column = 0; ok && column < COLUMN_COUNT; ++column) {
+            std::uint64_t size = 0;
+            ok = reader.varint(size) && decodeColumn(reader, size, chunk.rows, chunk.columns[column]);
+        }
+        if (!ok) {
+            std::cerr << path << ": bad chunk at byte " << (reader.at - data.data()) << "\n";
+            return false;
+        }
+        visit(chunk);
+    }
+    return true;
+}
+
+EventLog::Buffer::Buffer(EventLog& log) : log(log), battle(-1), encounter(-1) {
+    for (auto& column : columns) {
+        column.reserve(CHUNK_ROWS);
+    }
+}
+
+EventLog::Buffer::~Buffer() {
+    flush();
+}
+
+int EventLog::Buffer::intern(std::string_view word) {
+    auto it = dictionary.find(word);
+    if (it == dictionary.end()) {
+        it = dictionary.emplace(std::string(word), static_cast<int>(words.size())).first;
+        words.push_back(it->first);
+    }
+    return it->second;
+}
+
+void EventLog::Buffer::push(Kind kind, const CombatState& before, const CombatState& after, int card, CardEffectType effect, Result result) {
+    columns[SESSION].push_back(log.session);
+    columns[KIND].push_back(static_cast<std::int64_t>(kind));
+    columns[BATTLE].push_back(battle);
+    columns[TURN].push_back(after.turn);
+    columns[ENCOUNTER].push_back(encounter);
+    columns[CARD].push_back(card);
+    columns[EFFECT].push_back(static_cast<std::int64_t>(effect));
+    columns[ENEMY_DAMAGE].push_back(before.enemyHP - after.enemyHP);
+    columns[PLAYER_DAMAGE].push_back(before.playerHP - after.playerHP);
+    columns[PLAYER_HP].push_back(after.playerHP);
+    columns[ENEMY_HP].push_back(after.enemyHP);
+    columns[RESULT].push_back(static_cast<std::int64_t>(result));
+    if (columns[KIND].size() >= static_cast<size_t>(CHUNK_ROWS)) {
+        flush();
+    }
+}
+
+void EventLog::Buffer::battleStarted(std::string_view name, const CombatState& state) {
+    battle = log.nextBattle.fetch_add(1, std::memory_order_relaxed);
+    encounter = intern(name);
+    push(Kind::BattleStarted, state, state, -1, CardEffectType::None, Result::None);
+}
+
+void EventLog::Buffer::cardPlayed(const CardSpec& card, const CombatState& before, const CombatState& after) {
+    push(Kind::CardPlayed, before, after, intern(card.name), appliedEffect(card, before), Result::None);
+}
+
+void EventLog::Buffer::turnEnded(const CombatState& before, const CombatState& after) {
+    push(Kind::TurnEnded, before, after, -1, CardEffectType::None, Result::None);
+}
+
+void EventLog::Buffer::battleEnded(const CombatState& state, Result result) {
+    push(Kind::BattleEnded, state, state, -1, CardEffectType::None, result);
+}
+
+void EventLog::Buffer::historyMoved(Kind kind, const CombatState& before, const CombatState& after) {
+    push(kind, before, after, -1, CardEffectType::None, Result::None);
+}
+
+void EventLog::Buffer::flush() {
+    size_t rows = columns[KIND].size();
+    if (rows == 0) {
+        return;
+    }
+    bytes.clear();
+    for (char c : MAGIC) {
+        bytes.push_back(static_cast<unsigned char>(c));
+    }
+    putU32(bytes, VERSION);
+    putU32(bytes, static_cast<std::uint32_t>(rows));
+    putU32(bytes, static_cast<std::uint32_t>(words.size()));
+    for (std::string_view word : words) {
+        putVarint(bytes, word.size());
+        bytes.insert(bytes.end(), word.begin(), word.end());
+    }
+    std::vector<unsigned char> encoded;
+    for (auto& column : columns) {
+        encoded.clear();
+        encodeColumn(column, encoded);
+        putVarint(bytes, encoded.size());
+        bytes.insert(bytes.end(), encoded.begin(), encoded.end());
+        column.clear();
+    }
+    log.write(bytes);
+
+    // Words are per chunk; the battle in progress keeps its encounter in the next one.
+    std::string current = encounter >= 0 ? std::string(words[encounter]) : std::string();
+    dictionary.clear();
+    words.clear();
+    if (encounter >= 0) {
+        encounter = intern(current);
+    }
+}
\ No newline at end of file
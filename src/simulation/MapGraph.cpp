@@ -0,0 +1,82 @@
+#include "../includes/simulation/MapGraph.h"
+#include <algorithm>
+#include <iostream>
+
+MapGraph MapGraph::createDefault() {
+    const EnemyTable& enemies = EnemyTable::getDefault();
+    auto encounter = [&enemies](const std::string& id) {
+        int index = enemies.findEncounter(id);
+        if (index < 0) {
+            std::cerr << "Map references unknown encounter " << id << "\n";
+        }
+        return index;
+    };
+
+    MapGraph graph;
+    graph.addFight("Goblin", 0xC8C8C8, encounter("goblin"), { 1, 2 });
+    graph.addReward("Green Reward", 0x00FF00, RewardTier::Green, { 4 }, { 2 });
+    graph.addFight("Troll", 0xFF0000, encounter("troll"), { 3 }, { 1 });
+    graph.addReward("Purple Reward", 0x800080, RewardTier::Purple, { 5 });
+    graph.addFight("Ogre", 0xFFA500, encounter("ogre"), {});
+    graph.addFight("Dragon", 0xFF0000, encounter("dragon"), {});
+    return graph;
+}
+
+bool MapGraph::isValid() const {
+    for (const MapNode& node : nodes) {
+        if (node.type == NodeType::Fight && (node.encounter < 0 || node.encounter >= EnemyTable::getDefault().getEncounterCount())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const EncounterDef* MapGraph::getToughestEncounter() const {
+    const EncounterDef* toughest = nullptr;
+    for (int i = 0; i < getNodeCount(); ++i) {
+        if (nodes[i].type != NodeType::Fight) continue;
+        const EncounterDef& encounter = getEncounter(i);
+        if (!toughest || encounter.hp > toughest->hp) {
+            toughest = &encounter;
+        }
+    }
+    return toughest;
+}
+
+int MapGraph::addFight(const std::string& label, std::uint32_t color, int encounter,
+    std::vector<int> nextNodes, std::vector<int> locks) {
+    nodes.push_back(MapNode{ label, NodeType::Fight, color, encounter, RewardTier::Green,
+        std::move(nextNodes), std::move(locks) });
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+int MapGraph::addReward(const std::string& label, std::uint32_t color, RewardTier tier,
+    std::vector<int> nextNodes, std::vector<int> locks) {
+    nodes.push_back(MapNode{ label, NodeType::Reward, color, -1, tier, std::move(nextNodes), std::move(locks) });
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+std::vector<int> MapGraph::getAvailableNodes(const std::vector<bool>& completed, const std::vector<int>& locked) const {
+    std::vector<int> available;
+    bool anyCompleted = std::find(completed.begin(), completed.end(), true) != completed.end();
+    if (!anyCompleted) {
+        if (!nodes.empty()) {
+            available.push_back(0);
+        }
+        return available;
+    }
+
+    for (int i = 0; i < getNodeCount(); ++i) {
+        bool isCompleted = i < static_cast<int>(completed.size()) && completed[i];
+        if (isCompleted || std::find(locked.begin(), locked.end(), i) != locked.end()) {
+            continue;
+        }
+        for (int j = 0; j < getNodeCount() && j < static_cast<int>(completed.size()); ++j) {
+            if (completed[j] && std::find(nodes[j].nextNodes.begin(), nodes[j].nextNodes.end(), i) != nodes[j].nextNodes.end()) {
+                available.push_back(i);
+                break;
+            }
+        }
+    }
+    return available;
+}
\ No newline at end of file
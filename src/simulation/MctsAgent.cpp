@@ -0,0 +1,211 @@
+#include "../includes/simulation/MctsAgent.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Node {
+        int firstChild;
+        int nextSibling;
+        int action;
+        std::uint32_t visits;
+        std::uint32_t availability; // iterations in which this action was legal
+        float totalValue;
+    };
+
+    struct WorkerResult {
+        long long visits[MctsAgent::ACTION_COUNT];
+        double totalValue[MctsAgent::ACTION_COUNT];
+        long long rollouts;
+    };
+
+    // Bit per spec id that can be played right now, plus END_TURN.
+    std::uint64_t legalActions(const CombatState& state, const CombatDeck& deck) {
+        std::uint64_t mask = 1ull << MctsAgent::END_TURN;
+        for (int i = 0; i < state.handCount; ++i) {
+            if (deck.getSpec(state.hand[i]).energyCost <= state.energy) {
+                mask |= 1ull << state.hand[i];
+            }
+        }
+        return mask;
+    }
+
+    int pickBit(std::uint64_t mask, CombatState& state) {
+        int count = 0;
+        for (std::uint64_t m = mask; m; m &= m - 1) ++count;
+        int skip = static_cast<int>(state.random(static_cast<std::uint32_t>(count)));
+        for (int bit = 0; bit < MctsAgent::ACTION_COUNT; ++bit) {
+            if ((mask >> bit) & 1ull) {
+                if (skip-- == 0) return bit;
+            }
+        }
+        return MctsAgent::END_TURN;
+    }
+
+    // Default policy: play affordable cards in random order, end the turn when none are left.
+    void rollout(CombatState& state, const CombatDeck& deck, int maxTurns) {
+        while (!state.isOver() && state.turn < maxTurns) {
+            int playable[CombatState::MAX_HAND];
+            int count = 0;
+            for (int i = 0; i < state.handCount; ++i) {
+                if (deck.getSpec(state.hand[i]).energyCost <= state.energy) {
+                    playable[count++] = i;
+                }
+            }
+            if (count > 0) {
+                state.playCard(playable[state.random(static_cast<std::uint32_t>(count))], deck);
+            }
+            else {
+                state.endTurn();
+            }
+        }
+    }
+
+    void runWorker(const CombatState& root, const CombatDeck& deck, const MctsAgent::Config& config,
+        Clock::time_point deadline, std::uint64_t seed, WorkerResult& result) {
+        std::vector<Node> nodes;
+        nodes.reserve(std::min(config.maxNodes, 1 << 16));
+        nodes.push_back(Node{ -1, -1, -1, 0, 0, 0.0f });
+        std::vector<int> path;
+        path.reserve(64);
+
+        long long iteration = 0;
+        for (;; ++iteration) {
+            if (config.maxIterations > 0 ? iteration >= config.maxIterations
+                : ((iteration & 63) == 0 && Clock::now() >= deadline)) {
+                break;
+            }
+
+            CombatState state = root;
+            state.seed(seed + static_cast<std::uint64_t>(iteration) * 0x9E3779B97F4A7C15ull);
+            path.clear();
+            path.push_back(0);
+
+            int current = 0;
+            while (!state.isOver() && state.turn < config.maxTurns) {
+                std::uint64_t legal = legalActions(state, deck);
+                std::uint64_t untried = legal;
+                int best = -1;
+                float bestScore = -1.0f;
+                for (int child = nodes[current].firstChild; child >= 0; child = nodes[child].nextSibling) {
+                    Node& node = nodes[child];
+                    std::uint64_t bit = 1ull << node.action;
+                    if (!(legal & bit)) continue;
+                    untried &= ~bit;
+                    ++node.availability;
+                    float mean = node.totalValue / node.visits;
+                    float score = mean + config.exploration *
+                        std::sqrt(std::log(static_cast<float>(node.availability)) / node.visits);
+                    if (score > bestScore) {
+                        bestScore = score;
+                        best = child;
+                    }
+                }
+
+                if (untried && static_cast<int>(nodes.size()) < config.maxNodes) {
+                    int action = pickBit(untried, state);
+                    int child = static_cast<int>(nodes.size());
+                    nodes.push_back(Node{ -1, nodes[current].firstChild, action, 0, 1, 0.0f });
+                    nodes[current].firstChild = child;
+                    MctsAgent::applyAction(state, deck, action);
+                    path.push_back(child);
+                    break;
+                }
+                if (best < 0) {
+                    break;
+                }
+                MctsAgent::applyAction(state, deck, nodes[best].action);
+                path.push_back(best);
+                current = best;
+            }
+
+            rollout(state, deck, config.maxTurns);
+            float value = MctsAgent::evaluate(state);
+            for (int index : path) {
+                ++nodes[index].visits;
+                nodes[index].totalValue += value;
+            }
+        }
+
+        std::fill(std::begin(result.visits), std::end(result.visits), 0);
+        std::fill(std::begin(result.totalValue), std::end(result.totalValue), 0.0);
+        for (int child = nodes[0].firstChild; child >= 0; child = nodes[child].nextSibling) {
+            result.visits[nodes[child].action] += nodes[child].visits;
+            result.totalValue[nodes[child].action] += nodes[child].totalValue;
+        }
+        result.rollouts = iteration;
+    }
+}
+
+MctsAgent::Result MctsAgent::chooseAction(const CombatState& root, const CombatDeck& deck) const {
+    Clock::time_point start = Clock::now();
+    Result result{ -1, -1, 0, 0.0, {} };
+    if (root.isOver()) {
+        return result;
+    }
+
+    // Nothing to decide when no card is affordable.
+    std::uint64_t legal = legalActions(root, deck);
+    if (legal == (1ull << END_TURN)) {
+        result.action = END_TURN;
+        result.actions.push_back(ActionStats{ END_TURN, 0, 0.0 });
+        return result;
+    }
+
+    int threadCount = config.threads > 0 ? config.threads : static_cast<int>(std::thread::hardware_concurrency());
+    threadCount = std::max(1, threadCount);
+    Clock::time_point deadline = start + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double, std::milli>(config.budgetMs));
+
+    std::vector<WorkerResult> workerResults(threadCount);
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+    for (int i = 1; i < threadCount; ++i) {
+        workers.emplace_back(runWorker, std::cref(root), std::cref(deck), std::cref(config), deadline,
+            config.seed + static_cast<std::uint64_t>(i) * 0xD1B54A32D192ED03ull, std::ref(workerResults[i]));
+    }
+    runWorker(root, deck, config, deadline, config.seed, workerResults[0]);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    long long visits[ACTION_COUNT] = {};
+    double totalValue[ACTION_COUNT] = {};
+    for (const auto& worker : workerResults) {
+        result.rollouts += worker.rollouts;
+        for (int action = 0; action < ACTION_COUNT; ++action) {
+            visits[action] += worker.visits[action];
+            totalValue[action] += worker.totalValue[action];
+        }
+    }
+
+    for (int action = 0; action < ACTION_COUNT; ++action) {
+        if (visits[action] > 0) {
+            result.actions.push_back(ActionStats{ action, visits[action], totalValue[action] / visits[action] });
+        }
+    }
+    std::sort(result.actions.begin(), result.actions.end(), [](const ActionStats& a, const ActionStats& b) {
+        return a.visits > b.visits;
+    });
+
+    result.action = result.actions.empty() ? END_TURN : result.actions.front().action;
+    result.handIndex = result.action == END_TURN ? -1 : root.findInHand(static_cast<CombatState::CardId>(result.action));
+    result.elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return result;
+}
+
+float MctsAgent::evaluate(const CombatState& state) {
+    float hp = static_cast<float>(std::max(0, state.playerHP)) / CombatState::PLAYER_MAX_HP;
+    if (state.hasWon()) {
+        return 0.6f + 0.4f * hp;
+    }
+    float progress = state.enemyMaxHP > 0
+        ? 1.0f - static_cast<float>(std::max(0, state.enemyHP)) / state.enemyMaxHP : 0.0f;
+    if (state.playerHP <= 0) {
+        return 0.3f * progress;
+    }
+    return 0.3f * progress + 0.2f * hp; // ran out of turns
+}
\ No newline at end of file
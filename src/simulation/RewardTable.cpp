@@ -0,0 +1,92 @@
+#include "../includes/simulation/RewardTable.h"
+#include <algorithm>
+
+AliasTable::AliasTable(const std::vector<double>& weights) {
+    double total = 0.0;
+    for (double weight : weights) {
+        total += std::max(0.0, weight);
+    }
+    if (total <= 0.0) {
+        return;
+    }
+
+    int n = static_cast<int>(weights.size());
+    std::vector<double> scaled(n);
+    std::vector<int> small;
+    std::vector<int> large;
+    for (int i = 0; i < n; ++i) {
+        scaled[i] = std::max(0.0, weights[i]) * n / total;
+        (scaled[i] < 1.0 ? small : large).push_back(i);
+    }
+
+    const double one = 4294967296.0;
+    threshold.assign(n, static_cast<std::uint64_t>(one));
+    alias.resize(n);
+    for (int i = 0; i < n; ++i) {
+        alias[i] = i;
+    }
+    while (!small.empty() && !large.empty()) {
+        int less = small.back();
+        small.pop_back();
+        int more = large.back();
+        threshold[less] = static_cast<std::uint64_t>(scaled[less] * one);
+        alias[less] = more;
+        scaled[more] -= 1.0 - scaled[less];
+        if (scaled[more] < 1.0) {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+    // Whatever is left is 1 up to rounding and keeps its own column.
+}
+
+int AliasTable::sample(std::mt19937& rng) const {
+    int column = static_cast<int>((static_cast<std::uint64_t>(rng()) * threshold.size()) >> 32);
+    return static_cast<std::uint64_t>(rng()) < threshold[column] ? column : alias[column];
+}
+
+RewardTable::RewardTable(const Config& config) : offerSize(std::max(0, config.offerSize)) {
+    const std::vector<CardSpec>& pool = CardLibrary::getCardPool();
+    for (int tier = 0; tier < TIER_COUNT; ++tier) {
+        std::vector<double> weights[RARITY_COUNT];
+        for (size_t i = 0; i < pool.size(); ++i) {
+            double weight = i < config.cardWeights[tier].size() ? config.cardWeights[tier][i] : 1.0;
+            if (weight > 0.0) {
+                int rarity = static_cast<int>(CardLibrary::getRarity(pool[i]));
+                members[tier][rarity].push_back(static_cast<int>(i));
+                weights[rarity].push_back(weight);
+            }
+        }
+
+        // A rarity with no cards behind it cannot be rolled.
+        std::vector<double> rarityWeights(RARITY_COUNT);
+        drawable[tier] = 0;
+        for (int rarity = 0; rarity < RARITY_COUNT; ++rarity) {
+            cards[tier][rarity] = AliasTable(weights[rarity]);
+            if (!members[tier][rarity].empty() && config.rarityWeights[tier][rarity] > 0.0) {
+                rarityWeights[rarity] = config.rarityWeights[tier][rarity];
+                drawable[tier] += static_cast<int>(members[tier][rarity].size());
+            }
+        }
+        rarities[tier] = AliasTable(rarityWeights);
+    }
+}
+
+void RewardTable::roll(RewardTier tier, std::mt19937& rng, std::vector<int>& offer) const {
+    offer.clear();
+    int t = static_cast<int>(tier);
+    if (rarities[t].isEmpty()) {
+        return;
+    }
+    int slots = std::min(offerSize, drawable[t]);
+    for (int slot = 0; slot < slots; ++slot) {
+        for (int attempt = 0; attempt < MAX_REROLLS; ++attempt) {
+            int rarity = rarities[t].sample(rng);
+            int card = members[t][rarity][cards[t][rarity].sample(rng)];
+            if (std::find(offer.begin(), offer.end(), card) == offer.end()) {
+                offer.push_back(card);
+                break;
+            }
+        }
+    }
+}
\ No newline at end of file
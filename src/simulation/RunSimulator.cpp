@@ -0,0 +1,191 @@
+#include "../includes/simulation/RunSimulator.h"
+#include "../includes/simulation/BattlePolicy.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+RunPolicy RunPolicy::defaults() {
+    RunPolicy policy;
+    policy.chooseNode = &RunPolicy::randomNode;
+    policy.chooseReward = &RunPolicy::randomReward;
+    policy.chooseAction = &BattlePolicy::greedy;
+    return policy;
+}
+
+int RunPolicy::randomNode(const MapGraph&, const std::vector<int>& available, const std::vector<CardSpec>&, std::mt19937& rng) {
+    std::uniform_int_distribution<size_t> pick(0, available.size() - 1);
+    return available[pick(rng)];
+}
+
+int RunPolicy::randomReward(const std::vector<CardSpec>&, const std::vector<int>& offer, std::mt19937& rng) {
+    if (offer.empty()) return -1;
+    std::uniform_int_distribution<int> pick(0, static_cast<int>(offer.size()) - 1);
+    return pick(rng);
+}
+
+int RunPolicy::skipReward(const std::vector<CardSpec>&, const std::vector<int>&, std::mt19937&) {
+    return -1;
+}
+
+int RunPolicy::bestValueReward(const std::vector<CardSpec>&, const std::vector<int>& offer, std::mt19937&) {
+    const std::vector<CardSpec>& pool = CardLibrary::getCardPool();
+    int best = -1;
+    float bestValue = 0.0f;
+    for (size_t i = 0; i < offer.size(); ++i) {
+        const CardSpec& card = pool[offer[i]];
+        const CardEffect& effect = card.effect;
+        float value = static_cast<float>(card.damage + effect.value * std::max(1, effect.count));
+        if (effect.type == CardEffectType::Thorns) value += CombatState::THORNS_DAMAGE;
+        value /= std::max(1, card.energyCost);
+        if (value > bestValue) {
+            bestValue = value;
+            best = static_cast<int>(i);
+        }
+    }
+    return best;
+}
+
+RunSimulator::RunSimulator(const MapGraph& graph, const RunPolicy& policy) : graph(graph), policy(policy) {
+}
+
+bool RunSimulator::fight(const MapNode& node, const std::vector<CardSpec>& deck, int maxTurns, std::uint64_t seed, bool& stalled,
+    EventLog::Buffer* events) const {
+    CombatDeck combatDeck = CardLibrary::buildCombatDeck(deck);
+    const EncounterDef& encounter = EnemyTable::getDefault().getEncounter(node.encounter);
+    CombatState state = CombatState::begin(combatDeck, encounter.hp, encounter.damage, seed);
+    state.resistances = encounter.resistances;
+    state.setBehavior(&encounter.behavior);
+    if (events) {
+        events->battleStarted(encounter.id, state);
+    }
+    while (!state.isOver() && state.turn < maxTurns) {
+        int action = policy.chooseAction(state, combatDeck);
+        if (!events) {
+            state.applyAction(action, combatDeck);
+            continue;
+        }
+        CombatState before = state;
+        state.applyAction(action, combatDeck);
+        if (action == CombatState::END_TURN) {
+            events->turnEnded(before, state);
+        }
+        else {
+            events->cardPlayed(combatDeck.getSpec(action), before, state);
+        }
+    }
+    stalled = !state.isOver();
+    if (events) {
+        events->battleEnded(state, stalled ? EventLog::Result::Stalled
+            : state.hasWon() ? EventLog::Result::Won : EventLog::Result::Lost);
+    }
+    return state.hasWon();
+}
+
+RunSimulator::Outcome RunSimulator::playRun(const std::vector<CardSpec>& startingDeck, const RewardTable& rewards, int maxTurns,
+    std::uint64_t seed, std::vector<NodeStats>& stats, size_t& deckSize, EventLog::Buffer* events) const {
+    std::mt19937 rng(static_cast<std::mt19937::result_type>(seed ^ (seed >> 32)));
+    std::vector<CardSpec> deck = startingDeck;
+    std::vector<bool> completed(graph.getNodeCount(), false);
+    std::vector<int> locked;
+    std::vector<int> offer;
+    Outcome outcome = Outcome::Won;
+
+    for (;;) {
+        std::vector<int> available = graph.getAvailableNodes(completed, locked);
+        if (available.empty()) {
+            break;
+        }
+        int index = policy.chooseNode(graph, available, deck, rng);
+        const MapNode& node = graph.getNode(index);
+        ++stats[index].entered;
+
+        if (node.type == NodeType::Fight) {
+            bool stalled = false;
+            if (!fight(node, deck, maxTurns, rng(), stalled, events)) {
+                ++stats[index].deaths;
+                outcome = stalled ? Outcome::Stalled : Outcome::Died;
+                break;
+            }
+        }
+        else {
+            rewards.roll(node.rewardTier, rng, offer);
+            int pick = policy.chooseReward(deck, offer, rng);
+            if (pick >= 0 && pick < static_cast<int>(offer.size())) {
+                deck.push_back(CardLibrary::getCardPool()[offer[pick]]);
+            }
+        }
+
+        completed[index] = true;
+        for (int sibling : node.locks) {
+            if (std::find(locked.begin(), locked.end(), sibling) == locked.end()) {
+                locked.push_back(sibling);
+            }
+        }
+    }
+
+    deckSize = deck.size();
+    return outcome;
+}
+
+RunSimulator::Report RunSimulator::simulate(const Config& config) const {
+    auto start = std::chrono::steady_clock::now();
+    int threadCount = config.threads > 0 ? config.threads : static_cast<int>(std::thread::hardware_concurrency());
+    threadCount = static_cast<int>(std::max<long long>(1, std::min<long long>(std::max(1, threadCount), config.runs)));
+
+    struct Partial {
+        long long wins = 0;
+        long long deaths = 0;
+        long long stalls = 0;
+        long long deckCards = 0;
+        std::vector<NodeStats> nodes;
+    };
+    std::vector<Partial> partials(threadCount);
+    std::vector<CardSpec> startingDeck = config.startingCards.empty()
+        ? CardLibrary::getStarterDeck(config.deck) : config.startingCards;
+    RewardTable rewards(config.rewards);
+
+    auto work = [&](int worker) {
+        Partial& partial = partials[worker];
+        partial.nodes.assign(graph.getNodeCount(), NodeStats{ 0, 0 });
+        std::unique_ptr<EventLog::Buffer> events;
+        if (config.events) {
+            events = std::make_unique<EventLog::Buffer>(*config.events);
+        }
+        // Interleaved so every worker gets a similar mix of run seeds.
+        for (long long run = worker; run < config.runs; run += threadCount) {
+            size_t deckSize = 0;
+            Outcome outcome = playRun(startingDeck, rewards, config.maxTurns,
+                config.seed * 0x9E3779B97F4A7C15ull + static_cast<std::uint64_t>(run), partial.nodes, deckSize, events.get());
+            partial.deckCards += static_cast<long long>(deckSize);
+            if (outcome == Outcome::Won) ++partial.wins;
+            else if (outcome == Outcome::Died) ++partial.deaths;
+            else ++partial.stalls;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threadCount; ++i) {
+        workers.emplace_back(work, i);
+    }
+    work(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    Report report{ config.runs, 0, 0, 0, std::vector<NodeStats>(graph.getNodeCount(), NodeStats{ 0, 0 }), 0.0, 0.0 };
+    long long deckCards = 0;
+    for (const auto& partial : partials) {
+        report.wins += partial.wins;
+        report.deaths += partial.deaths;
+        report.stalls += partial.stalls;
+        deckCards += partial.deckCards;
+        for (size_t i = 0; i < partial.nodes.size(); ++i) {
+            report.nodes[i].entered += partial.nodes[i].entered;
+            report.nodes[i].deaths += partial.nodes[i].deaths;
+        }
+    }
+    report.meanFinalDeckSize = config.runs > 0 ? static_cast<double>(deckCards) / config.runs : 0.0;
+    report.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include "../includes/systems/AssetPack.h"
+#include "../includes/common/Constants.h"
+#include "../includes/systems/AssetWatcher.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const AssetPack& AssetPack::getDefault() {
+    static AssetPack pack;
+    static const bool mapped = []() {
+        // Hot reload edits the loose files, which a pack baked before them would shadow.
+        if (AssetWatcher::ENABLED || !pack.open(Constants::ASSET_PACK_PATH)) {
+            return false;
+        }
+        std::cout << "Mapped " << pack.entryCount << " assets from " << Constants::ASSET_PACK_PATH << "\n";
+        return true;
+    }();
+    (void)mapped;
+    return pack;
+}
+
+AssetPack::AssetPack() : data(nullptr), size(0), entries(nullptr), entryCount(0)
+#ifdef _WIN32
+, fileHandle(nullptr), mappingHandle(nullptr)
+#endif
+{
+}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+bool AssetPack::normalizeName(std::string_view path, char (&name)[NAME_SIZE]) {
+    if (path.size() >= NAME_SIZE) {
+        return false;
+    }
+    std::memset(name, 0, NAME_SIZE);
+    for (size_t i = 0; i < path.size(); ++i) {
+        char c = path[i] == '\\' ? '/' : path[i];
+        name[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return true;
+}
+
+bool AssetPack::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = nullptr;
+    const void* view = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        }
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    if (!view) {
+        std::cerr << "Failed to map asset pack " << path << "\n";
+        close();
+        return false;
+    }
+    data = static_cast<const unsigned char*>(view);
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        return false;
+    }
+    struct stat info;
+    void* view = MAP_FAILED;
+    if (fstat(file, &info) == 0 && info.st_size > 0) {
+        view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    }
+    ::close(file); // the mapping keeps its own reference
+    if (view == MAP_FAILED) {
+        std::cerr << "Failed to map asset pack " << path << "\n";
+        return false;
+    }
+    data = static_cast<const unsigned char*>(view);
+    size = static_cast<size_t>(info.st_size);
+#endif
+
+    Header header;
+    if (size < sizeof(Header)) {
+        std::cerr << "Asset pack " << path << " is truncated\n";
+        close();
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(Header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+        std::cerr << "Asset pack " << path << " has the wrong format; rebuild it with RoguelikeAssetPacker\n";
+        close();
+        return false;
+    }
+    if (sizeof(Header) + static_cast<size_t>(header.entryCount) * sizeof(Entry) > size) {
+        std::cerr << "Asset pack " << path << " is truncated\n";
+        close();
+        return false;
+    }
+    const Entry* table = reinterpret_cast<const Entry*>(data + sizeof(Header));
+    for (std::uint32_t i = 0; i < header.entryCount; ++i) {
+        const Entry& entry = table[i];
+        bool badBlob = entry.offset > size || entry.size > size - entry.offset || entry.name[NAME_SIZE - 1] != '\0';
+        // createSurface wraps the blob as `height` rows of `pitch` bytes, so they must fit in it.
+        bool badTexture = entry.kind == Kind::Texture && (entry.pitch < static_cast<std::uint64_t>(entry.width) * 4 ||
+            static_cast<std::uint64_t>(entry.pitch) * entry.height > entry.size);
+        if (badBlob || badTexture) {
+            std::cerr << "Asset pack " << path << " has a bad entry " << i << "\n";
+            close();
+            return false;
+        }
+    }
+    entries = table;
+    entryCount = header.entryCount;
+    return true;
+}
+
+void AssetPack::close() {
+#ifdef _WIN32
+    if (data) {
+        UnmapViewOfFile(data);
+    }
+    if (mappingHandle) {
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+    }
+    if (fileHandle) {
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+    }
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+#else
+    if (data) {
+        munmap(const_cast<unsigned char*>(data), size);
+    }
+#endif
+    data = nullptr;
+    size = 0;
+    entries = nullptr;
+    entryCount = 0;
+}
+
+const AssetPack::Entry* AssetPack::find(std::string_view name) const {
+    char key[NAME_SIZE];
+    if (!entries || !normalizeName(name, key)) {
+        return nullptr;
+    }
+    const Entry* end = entries + entryCount;
+    const Entry* entry = std::lower_bound(entries, end, key, [](const Entry& candidate, const char* wanted) {
+        return std::strcmp(candidate.name, wanted) < 0;
+    });
+    return (entry != end && std::strcmp(entry->name, key) == 0) ? entry : nullptr;
+}
+
+SDL_Surface* AssetPack::createSurface(std::string_view name) const {
+    const Entry* entry = find(name);
+    if (!entry || entry->kind != Kind::Texture) {
+        return nullptr;
+    }
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormatFrom(const_cast<unsigned char*>(data + entry->offset),
+        static_cast<int>(entry->width), static_cast<int>(entry->height), 32, static_cast<int>(entry->pitch), SDL_PIXELFORMAT_RGBA32);
+    if (!surface) {
+        std::cerr << "Failed to wrap " << entry->name << " - SDL_Error: " << SDL_GetError() << std::endl;
+    }
+    return surface;
+}
+
+SDL_RWops* AssetPack::openFile(std::string_view name) const {
+    const Entry* entry = find(name);
+    if (!entry || entry->kind != Kind::File) {
+        return nullptr;
+    }
+    return SDL_RWFromConstMem(data + entry->offset, static_cast<int>(entry->size));
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "../includes/systems/AssetWatcher.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+AssetWatcher::AssetWatcher() : fd(-1) {
+}
+
+AssetWatcher::~AssetWatcher() {
+#ifdef __linux__
+    if (fd >= 0) {
+        close(fd);
+    }
+#endif
+}
+
+bool AssetWatcher::watch(const std::string& directory) {
+#ifdef __linux__
+    if (fd < 0) {
+        fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd < 0) {
+            std::cerr << "Hot reload unavailable: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+    }
+    int descriptor = inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (descriptor < 0) {
+        std::cerr << "Cannot watch " << directory << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    directories.emplace_back(descriptor, directory);
+    std::cout << "Watching " << directory << " for changes" << std::endl;
+    return true;
+#else
+    std::cerr << "Hot reload is only implemented on Linux; not watching " << directory << std::endl;
+    return false;
+#endif
+}
+
+void AssetWatcher::poll(std::vector<std::string>& changed) {
+#ifdef __linux__
+    if (fd < 0) {
+        return;
+    }
+    alignas(inotify_event) char buffer[4096];
+    for (;;) {
+        ssize_t length = read(fd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            return; // EAGAIN: nothing more pending
+        }
+        for (const char* next = buffer; next < buffer + length;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(next);
+            next += sizeof(inotify_event) + event->len;
+            if (event->len == 0) {
+                continue; // about the directory itself, or a queue overflow
+            }
+            for (const auto& directory : directories) {
+                if (directory.first != event->wd) {
+                    continue;
+                }
+                std::string path = directory.second + event->name;
+                if (std::find(changed.begin(), changed.end(), path) == changed.end()) {
+                    changed.push_back(std::move(path));
+                }
+            }
+        }
+    }
+#else
+    (void)changed;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#include "../includes/systems/FrameArena.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+
+FrameArena& FrameArena::get() {
+    static FrameArena arena;
+    return arena;
+}
+
+FrameArena::FrameArena()
+    : buffer(new std::byte[CAPACITY]), used(0), peak(0), spills(0), overflow(std::pmr::new_delete_resource()) {
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    size_t start = (used + alignment - 1) & ~(alignment - 1);
+    if (start + bytes <= CAPACITY) {
+        used = start + bytes;
+        peak = std::max(peak, used);
+        return buffer.get() + start;
+    }
+    ++spills;
+    return overflow.allocate(bytes, alignment);
+}
+
+void FrameArena::reset() {
+    used = 0;
+    overflow.release();
+}
+
+FrameText::FrameText() : text(&FrameArena::get()) {
+    text.reserve(64);
+}
+
+FrameText& FrameText::operator<<(long long value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    text.append(digits, result.ptr);
+    return *this;
+}
+
+FrameText& FrameText::fixed(double value, int precision) {
+    char digits[64];
+    int length = std::snprintf(digits, sizeof(digits), "%.*f", precision, value);
+    if (length > 0) {
+        text.append(digits, std::min(static_cast<size_t>(length), sizeof(digits) - 1));
+    }
+    return *this;
+}
\ No newline at end of file
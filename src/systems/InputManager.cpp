@@ -1,10 +1,44 @@
 #include "../includes/systems/InputManager.h"
 
-void InputManager::processInput(bool& isRunning) {
+InputManager::InputManager() : quit(false) {
+	bindKey(SDLK_ESCAPE, InputAction::Back);
+	bindKey(SDLK_RETURN, InputAction::Confirm);
+	bindKey(SDLK_SPACE, InputAction::EndTurn);
+	bindKey(SDLK_z, InputAction::Undo);
+	bindKey(SDLK_y, InputAction::Redo);
+	bindKey(SDLK_F3, InputAction::ToggleOverlay);
+	bindKey(SDLK_F9, InputAction::StressTest);
+	events.reserve(16);
+}
+
+void InputManager::pollEvents() {
+	events.clear();
+
 	SDL_Event event;
 	while (SDL_PollEvent(&event)) {
 		if (event.type == SDL_QUIT) {
-			isRunning = false;
+			quit = true;
+			continue;
+		}
+
+		if (event.type == SDL_MOUSEMOTION && !events.empty() && events.back().event.type == SDL_MOUSEMOTION) {
+			SDL_MouseMotionEvent& previous = events.back().event.motion;
+			int xrel = previous.xrel + event.motion.xrel;
+			int yrel = previous.yrel + event.motion.yrel;
+			previous = event.motion;
+			previous.xrel = xrel;
+			previous.yrel = yrel;
+			continue;
 		}
+
+		if (event.type == SDL_KEYDOWN) {
+			auto it = keyBindings.find(event.key.keysym.sym);
+			if (it != keyBindings.end() && !event.key.repeat) {
+				events.push_back(InputEvent{ event, it->second });
+			}
+			continue;
+		}
+
+		events.push_back(InputEvent{ event, InputAction::None });
 	}
 }
\ No newline at end of file
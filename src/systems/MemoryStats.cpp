@@ -0,0 +1,175 @@
+#include "../includes/systems/MemoryStats.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+namespace {
+    // Constant-initialised, so they are usable by allocations made before main().
+    std::atomic<long long> heapAllocations{ 0 };
+    std::atomic<long long> heapBytes{ 0 };
+    std::atomic<long long> heapLiveBytes{ 0 };
+    std::atomic<long long> sdlAllocations{ 0 };
+    std::atomic<long long> sdlBytes{ 0 };
+    std::atomic<long long> sdlLiveBytes{ 0 };
+    std::atomic<long long> texturesCreated{ 0 };
+    std::atomic<long long> liveTextures{ 0 };
+
+#ifdef ROGUECARDS_MEMORY_STATS
+    // Every counted block carries its size in a header, so frees can update the
+    // live totals without a side table. The header keeps malloc's alignment.
+    constexpr size_t HEADER = alignof(std::max_align_t);
+
+    void* countedAlloc(size_t size, std::atomic<long long>& count, std::atomic<long long>& bytes,
+        std::atomic<long long>& live) {
+        void* block = std::malloc(size + HEADER);
+        if (!block) {
+            return nullptr;
+        }
+        *static_cast<size_t*>(block) = size;
+        count.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+        live.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+        return static_cast<char*>(block) + HEADER;
+    }
+
+    void countedFree(void* pointer, std::atomic<long long>& live) {
+        if (!pointer) {
+            return;
+        }
+        void* block = static_cast<char*>(pointer) - HEADER;
+        live.fetch_sub(static_cast<long long>(*static_cast<size_t*>(block)), std::memory_order_relaxed);
+        std::free(block);
+    }
+
+    void* sdlMalloc(size_t size) {
+        return countedAlloc(size, sdlAllocations, sdlBytes, sdlLiveBytes);
+    }
+
+    void* sdlCalloc(size_t count, size_t size) {
+        void* pointer = countedAlloc(count * size, sdlAllocations, sdlBytes, sdlLiveBytes);
+        if (pointer) {
+            std::memset(pointer, 0, count * size);
+        }
+        return pointer;
+    }
+
+    void* sdlRealloc(void* pointer, size_t size) {
+        if (!pointer) {
+            return sdlMalloc(size);
+        }
+        void* block = static_cast<char*>(pointer) - HEADER;
+        size_t oldSize = *static_cast<size_t*>(block);
+        void* grown = std::realloc(block, size + HEADER);
+        if (!grown) {
+            return nullptr;
+        }
+        *static_cast<size_t*>(grown) = size;
+        if (size > oldSize) {
+            sdlAllocations.fetch_add(1, std::memory_order_relaxed);
+            sdlBytes.fetch_add(static_cast<long long>(size - oldSize), std::memory_order_relaxed);
+        }
+        sdlLiveBytes.fetch_add(static_cast<long long>(size) - static_cast<long long>(oldSize), std::memory_order_relaxed);
+        return static_cast<char*>(grown) + HEADER;
+    }
+
+    void sdlFree(void* pointer) {
+        countedFree(pointer, sdlLiveBytes);
+    }
+#endif
+}
+
+#ifdef ROGUECARDS_MEMORY_STATS
+// Over-aligned new (alignas above max_align_t) keeps the library implementation
+// and is not counted; nothing on the per-frame paths uses it.
+void* operator new(size_t size) {
+    void* pointer = countedAlloc(size, heapAllocations, heapBytes, heapLiveBytes);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size, heapAllocations, heapBytes, heapLiveBytes);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size, heapAllocations, heapBytes, heapLiveBytes);
+}
+
+void operator delete(void* pointer) noexcept {
+    countedFree(pointer, heapLiveBytes);
+}
+
+void operator delete[](void* pointer) noexcept {
+    countedFree(pointer, heapLiveBytes);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    countedFree(pointer, heapLiveBytes);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    countedFree(pointer, heapLiveBytes);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    countedFree(pointer, heapLiveBytes);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    countedFree(pointer, heapLiveBytes);
+}
+#endif
+
+MemoryStats::Counters MemoryStats::snapshot() {
+    return Counters{
+        heapAllocations.load(std::memory_order_relaxed),
+        heapBytes.load(std::memory_order_relaxed),
+        heapLiveBytes.load(std::memory_order_relaxed),
+        sdlAllocations.load(std::memory_order_relaxed),
+        sdlBytes.load(std::memory_order_relaxed),
+        sdlLiveBytes.load(std::memory_order_relaxed),
+        texturesCreated.load(std::memory_order_relaxed),
+        liveTextures.load(std::memory_order_relaxed)
+    };
+}
+
+void MemoryStats::installSDLHooks() {
+#ifdef ROGUECARDS_MEMORY_STATS
+    if (SDL_SetMemoryFunctions(sdlMalloc, sdlCalloc, sdlRealloc, sdlFree) != 0) {
+        std::cerr << "Could not install SDL memory hooks! SDL_Error: " << SDL_GetError() << std::endl;
+    }
+#endif
+}
+
+SDL_Texture* MemoryStats::createTexture(SDL_Renderer* renderer, Uint32 format, int access, int width, int height) {
+    SDL_Texture* texture = SDL_CreateTexture(renderer, format, access, width, height);
+    if (texture) {
+        texturesCreated.fetch_add(1, std::memory_order_relaxed);
+        liveTextures.fetch_add(1, std::memory_order_relaxed);
+    }
+    return texture;
+}
+
+SDL_Texture* MemoryStats::createTextureFromSurface(SDL_Renderer* renderer, SDL_Surface* surface) {
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (texture) {
+        texturesCreated.fetch_add(1, std::memory_order_relaxed);
+        liveTextures.fetch_add(1, std::memory_order_relaxed);
+    }
+    return texture;
+}
+
+void MemoryStats::destroyTexture(SDL_Texture* texture) {
+    if (texture) {
+        liveTextures.fetch_sub(1, std::memory_order_relaxed);
+        SDL_DestroyTexture(texture);
+    }
+}
\ No newline at end of file
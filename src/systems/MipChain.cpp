@@ -0,0 +1,91 @@
+#include "../includes/systems/MipChain.h"
+#include "../includes/systems/MemoryStats.h"
+#include <iostream>
+
+std::shared_ptr<MipChain> MipChain::create(SDL_Renderer* renderer, SDL_Surface* image) {
+    auto chain = std::make_shared<MipChain>();
+    int width = image->w;
+    int height = image->h;
+    for (;;) {
+        SDL_Texture* texture = MemoryStats::createTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, width, height);
+        if (!texture) {
+            std::cerr << "Failed to create a " << width << "x" << height << " mip level - SDL_Error: " << SDL_GetError() << std::endl;
+            return nullptr;
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureScaleMode(texture, SDL_ScaleModeLinear);
+        chain->levels.push_back(Level{ texture, width, height });
+        if (width / 2 < MIN_SIZE || height / 2 < MIN_SIZE) {
+            break;
+        }
+        width /= 2;
+        height /= 2;
+    }
+    if (!chain->update(image)) {
+        return nullptr;
+    }
+    return chain;
+}
+
+MipChain::~MipChain() {
+    for (const Level& level : levels) {
+        MemoryStats::destroyTexture(level.texture);
+    }
+}
+
+bool MipChain::update(SDL_Surface* image) {
+    if (levels.empty() || image->w != levels[0].width || image->h != levels[0].height) {
+        return false;
+    }
+    SDL_LockSurface(image);
+    bool ok = SDL_UpdateTexture(levels[0].texture, nullptr, image->pixels, image->pitch) == 0;
+
+    // Each level is filtered from the one above it, not from the source.
+    std::vector<Uint8> above;
+    std::vector<Uint8> current;
+    const Uint8* source = static_cast<const Uint8*>(image->pixels);
+    int sourcePitch = image->pitch;
+    for (size_t i = 1; ok && i < levels.size(); ++i) {
+        const Level& parent = levels[i - 1];
+        const Level& level = levels[i];
+        current.resize(static_cast<size_t>(level.width) * level.height * 4);
+        downsample(source, parent.width, parent.height, sourcePitch, current.data());
+        ok = SDL_UpdateTexture(level.texture, nullptr, current.data(), level.width * 4) == 0;
+        above.swap(current);
+        source = above.data();
+        sourcePitch = level.width * 4;
+    }
+    SDL_UnlockSurface(image);
+    if (!ok) {
+        std::cerr << "Failed to upload mip levels - SDL_Error: " << SDL_GetError() << std::endl;
+    }
+    return ok;
+}
+
+SDL_Texture* MipChain::select(int width, int height) const {
+    for (size_t i = levels.size(); i-- > 1;) {
+        if (levels[i].width >= width && levels[i].height >= height) {
+            return levels[i].texture;
+        }
+    }
+    return getBase();
+}
+
+void MipChain::downsample(const Uint8* source, int sourceWidth, int sourceHeight, int sourcePitch, Uint8* destination) {
+    int width = sourceWidth / 2;
+    int height = sourceHeight / 2;
+    for (int y = 0; y < height; ++y) {
+        const Uint8* top = source + static_cast<size_t>(sourcePitch) * (2 * y);
+        const Uint8* bottom = top + sourcePitch;
+        Uint8* out = destination + static_cast<size_t>(width) * 4 * y;
+        for (int x = 0; x < width; ++x, top += 8, bottom += 8, out += 4) {
+            unsigned alpha[4] = { top[3], top[7], bottom[3], bottom[7] };
+            unsigned totalAlpha = alpha[0] + alpha[1] + alpha[2] + alpha[3];
+            for (int c = 0; c < 3; ++c) {
+                unsigned weighted = top[c] * alpha[0] + top[4 + c] * alpha[1] + bottom[c] * alpha[2] + bottom[4 + c] * alpha[3];
+                out[c] = static_cast<Uint8>(totalAlpha ? (weighted + totalAlpha / 2) / totalAlpha : 0);
+            }
+            out[3] = static_cast<Uint8>((totalAlpha + 2) / 4);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#include "../includes/systems/RenderStats.h"
+
+RenderStats::Frame RenderStats::frame = { 0, 0 };
+SDL_Texture* RenderStats::lastTexture = nullptr;
+
+void RenderStats::beginFrame() {
+    frame = { 0, 0 };
+    lastTexture = nullptr;
+}
+
+void RenderStats::count(SDL_Texture* texture) {
+    ++frame.drawCalls;
+    if (texture != lastTexture && frame.drawCalls > 1) {
+        ++frame.textureSwitches;
+    }
+    lastTexture = texture;
+}
+
+int RenderStats::copy(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect* destination) {
+    count(texture);
+    return SDL_RenderCopy(renderer, texture, source, destination);
+}
+
+int RenderStats::fillRect(SDL_Renderer* renderer, const SDL_Rect* rect) {
+    count(nullptr);
+    return SDL_RenderFillRect(renderer, rect);
+}
+
+int RenderStats::drawRect(SDL_Renderer* renderer, const SDL_Rect* rect) {
+    count(nullptr);
+    return SDL_RenderDrawRect(renderer, rect);
+}
+
+int RenderStats::drawLine(SDL_Renderer* renderer, int x1, int y1, int x2, int y2) {
+    count(nullptr);
+    return SDL_RenderDrawLine(renderer, x1, y1, x2, y2);
+}
\ No newline at end of file
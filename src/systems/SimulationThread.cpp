@@ -0,0 +1,51 @@
+#include "../includes/systems/SimulationThread.h"
+
+SimulationThread::SimulationThread() : busy(false), stopping(false) {
+    worker = std::thread(&SimulationThread::run, this);
+}
+
+SimulationThread::~SimulationThread() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        jobs.clear();
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+void SimulationThread::post(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    wake.notify_one();
+}
+
+void SimulationThread::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]() { return !busy && jobs.empty(); });
+}
+
+void SimulationThread::run() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (busy) {
+                busy = false;
+                if (jobs.empty()) {
+                    idle.notify_all();
+                }
+            }
+            wake.wait(lock, [this]() { return stopping || !jobs.empty(); });
+            if (stopping) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+            busy = true;
+        }
+        job();
+    }
+}
\ No newline at end of file
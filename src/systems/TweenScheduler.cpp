@@ -0,0 +1,95 @@
+#include "../includes/systems/TweenScheduler.h"
+
+TweenScheduler::TweenScheduler() : currentTime(0) {
+}
+
+TweenScheduler::Handle TweenScheduler::start(float from, float to, Uint32 durationMs, Easing easing) {
+    Uint32 slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else {
+        slot = static_cast<Uint32>(slotIndex.size());
+        slotIndex.push_back(NO_INDEX);
+        slotGeneration.push_back(0);
+    }
+
+    // Generation 0 is never handed out so a zeroed Handle is always invalid.
+    if (++slotGeneration[slot] == 0) {
+        slotGeneration[slot] = 1;
+    }
+    Handle handle = (static_cast<Uint32>(slotGeneration[slot]) << 16) | slot;
+
+    slotIndex[slot] = static_cast<Uint32>(tweens.size());
+    tweens.push_back(Tween{ handle, from, to, from, currentTime, durationMs > 0 ? durationMs : 1, easing });
+    return handle;
+}
+
+void TweenScheduler::cancel(Handle handle) {
+    if (find(handle)) {
+        remove(slotIndex[handle & 0xFFFF]);
+    }
+}
+
+bool TweenScheduler::isActive(Handle handle) const {
+    return find(handle) != nullptr;
+}
+
+float TweenScheduler::getValue(Handle handle, float fallback) const {
+    const Tween* tween = find(handle);
+    return tween ? tween->value : fallback;
+}
+
+void TweenScheduler::update(Uint32 now) {
+    currentTime = now;
+    if (tweens.empty()) {
+        return;
+    }
+
+    Uint32 i = 0;
+    while (i < tweens.size()) {
+        Tween& tween = tweens[i];
+        float t = static_cast<float>(now - tween.startTime) / tween.duration;
+        if (t >= 1.0f) {
+            remove(i); // the last tween moves into slot i, so don't advance
+            continue;
+        }
+        tween.value = tween.from + (tween.to - tween.from) * ease(tween.easing, t);
+        ++i;
+    }
+}
+
+float TweenScheduler::ease(Easing easing, float t) {
+    switch (easing) {
+    case Easing::EaseOutCubic: {
+        float inv = 1.0f - t;
+        return 1.0f - inv * inv * inv;
+    }
+    case Easing::EaseInOutQuad:
+        return t < 0.5f ? 2.0f * t * t : 1.0f - 2.0f * (1.0f - t) * (1.0f - t);
+    default:
+        return t;
+    }
+}
+
+const TweenScheduler::Tween* TweenScheduler::find(Handle handle) const {
+    Uint32 slot = handle & 0xFFFF;
+    if (handle == INVALID_HANDLE || slot >= slotIndex.size() || slotGeneration[slot] != (handle >> 16)) {
+        return nullptr;
+    }
+    Uint32 index = slotIndex[slot];
+    return index == NO_INDEX ? nullptr : &tweens[index];
+}
+
+void TweenScheduler::remove(Uint32 index) {
+    Uint32 slot = tweens[index].handle & 0xFFFF;
+    slotIndex[slot] = NO_INDEX;
+    freeSlots.push_back(slot);
+
+    if (index + 1 != tweens.size()) {
+        tweens[index] = tweens.back();
+        slotIndex[tweens[index].handle & 0xFFFF] = index;
+    }
+    tweens.pop_back();
+}
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include "../includes/systems/AssetPack.h"
+#include <SDL.h>
+#include <SDL_image.h>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Bakes the assets folder into assets.pack (see AssetPack.h). Runs as a post-build
+// step of the game:
+//
+//   RoguelikeAssetPacker <assets dir> <output pack>
+//
+// PNGs are decoded here, once, into tightly packed RGBA32 rows; every other file
+// except the data tables is stored as-is.
+
+namespace fs = std::filesystem;
+
+namespace {
+    struct Item {
+        AssetPack::Entry entry;
+        std::vector<unsigned char> bytes;
+    };
+
+    std::string lowerExtension(const fs::path& path) {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension;
+    }
+
+    bool decodeImage(const fs::path& path, Item& item) {
+        SDL_Surface* loaded = IMG_Load(path.string().c_str());
+        if (!loaded) {
+            std::cerr << "Failed to load image from " << path.string() << " - IMG_Error: " << IMG_GetError() << "\n";
+            return false;
+        }
+        SDL_Surface* surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(loaded);
+        if (!surface) {
+            std::cerr << "Failed to convert " << path.string() << " - SDL_Error: " << SDL_GetError() << "\n";
+            return false;
+        }
+
+        size_t rowBytes = static_cast<size_t>(surface->w) * 4;
+        item.entry.kind = AssetPack::Kind::Texture;
+        item.entry.width = static_cast<std::uint32_t>(surface->w);
+        item.entry.height = static_cast<std::uint32_t>(surface->h);
+        item.entry.pitch = static_cast<std::uint32_t>(rowBytes);
+        item.bytes.resize(rowBytes * surface->h);
+        SDL_LockSurface(surface);
+        for (int y = 0; y < surface->h; ++y) {
+            std::memcpy(item.bytes.data() + rowBytes * y, static_cast<const unsigned char*>(surface->pixels) + static_cast<size_t>(surface->pitch) * y, rowBytes);
+        }
+        SDL_UnlockSurface(surface);
+        SDL_FreeSurface(surface);
+        return true;
+    }
+
+    bool readFile(const fs::path& path, Item& item) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            std::cerr << "Failed to open " << path.string() << "\n";
+            return false;
+        }
+        item.entry.kind = AssetPack::Kind::File;
+        item.bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    // Names match the paths the game asks for, which start at the assets folder.
+    bool collect(const fs::path& root, std::vector<Item>& items) {
+        for (const fs::directory_entry& file : fs::recursive_directory_iterator(root)) {
+            if (!file.is_regular_file()) {
+                continue;
+            }
+            fs::path relative = fs::relative(file.path(), root);
+            if (*relative.begin() == "data") {
+                continue; // read as text by the simulator too; stays loose
+            }
+
+            Item item{};
+            std::string name = (fs::path("assets") / relative).generic_string();
+            if (!AssetPack::normalizeName(name, item.entry.name)) {
+                std::cerr << "Asset name too long for the pack: " << name << "\n";
+                return false;
+            }
+            bool ok = lowerExtension(file.path()) == ".png" ? decodeImage(file.path(), item) : readFile(file.path(), item);
+            if (!ok) {
+                return false;
+            }
+            item.entry.size = item.bytes.size();
+            items.push_back(std::move(item));
+        }
+        std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+            return std::strcmp(a.entry.name, b.entry.name) < 0;
+        });
+        for (size_t i = 1; i < items.size(); ++i) {
+            if (std::strcmp(items[i - 1].entry.name, items[i].entry.name) == 0) {
+                std::cerr << "Two assets differ only in case: " << items[i].entry.name << "\n";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::uint64_t alignUp(std::uint64_t offset) {
+        return (offset + AssetPack::DATA_ALIGNMENT - 1) / AssetPack::DATA_ALIGNMENT * AssetPack::DATA_ALIGNMENT;
+    }
+
+    bool writePack(const fs::path& path, std::vector<Item>& items) {
+        AssetPack::Header header{};
+        std::memcpy(header.magic, AssetPack::MAGIC, sizeof(header.magic));
+        header.version = AssetPack::VERSION;
+        header.entryCount = static_cast<std::uint32_t>(items.size());
+
+        std::uint64_t offset = sizeof(AssetPack::Header) + items.size() * sizeof(AssetPack::Entry);
+        for (Item& item : items) {
+            offset = alignUp(offset);
+            item.entry.offset = offset;
+            offset += item.entry.size;
+        }
+
+        // Written beside the target and renamed, so a running game never maps half a pack.
+        fs::path temporary = path;
+        temporary += ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                std::cerr << "Failed to create " << temporary.string() << "\n";
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            for (const Item& item : items) {
+                file.write(reinterpret_cast<const char*>(&item.entry), sizeof(item.entry));
+            }
+            const char padding[AssetPack::DATA_ALIGNMENT] = {};
+            for (const Item& item : items) {
+                std::uint64_t position = static_cast<std::uint64_t>(file.tellp());
+                file.write(padding, static_cast<std::streamsize>(item.entry.offset - position));
+                file.write(reinterpret_cast<const char*>(item.bytes.data()), static_cast<std::streamsize>(item.bytes.size()));
+            }
+            if (!file) {
+                std::cerr << "Failed to write " << temporary.string() << "\n";
+                return false;
+            }
+        }
+        std::error_code error;
+        fs::rename(temporary, path, error);
+        if (error) {
+            std::cerr << "Failed to replace " << path.string() << ": " << error.message() << "\n";
+            return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: RoguelikeAssetPacker <assets dir> <output pack>\n";
+        return 1;
+    }
+    fs::path root = argv[1];
+    fs::path output = argv[2];
+    if (!fs::is_directory(root)) {
+        std::cerr << "No assets folder at " << root.string() << "\n";
+        return 1;
+    }
+
+    // Only decodes surfaces; no video subsystem needed.
+    if (SDL_Init(0) < 0 || !(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
+        std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << "\n";
+        return 1;
+    }
+
+    std::vector<Item> items;
+    bool ok = collect(root, items) && writePack(output, items);
+    IMG_Quit();
+    SDL_Quit();
+    if (!ok) {
+        return 1;
+    }
+
+    AssetPack pack;
+    if (!pack.open(output.string())) {
+        return 1;
+    }
+    std::uintmax_t bytes = fs::file_size(output);
+    std::cout << "Packed " << items.size() << " assets into " << output.string() << " (" << bytes / 1024 << " KiB)\n";
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,247 @@
+#include "../includes/core/Game.h"
+#include "../includes/common/Constants.h"
+#include "../includes/scenes/RewardScene.h"
+#include "../includes/systems/FrameArena.h"
+#include "../includes/systems/MemoryStats.h"
+#include <SDL.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Renders every scene offscreen at each resolution the options menu offers,
+// hashes one settled frame per scene against a golden file and times a run of
+// frames. Uses SDL's dummy video driver and the software renderer, so it needs
+// no display or GPU and gives the same pixels on any machine with the same SDL
+// and SDL_ttf versions; goldens are kept per build machine, not in the repo.
+//
+//   RoguelikeRenderHarness check [options]    compare frame hashes with the golden file
+//   RoguelikeRenderHarness update [options]   rewrite the golden file from this build
+//
+// Options: --golden FILE (default render_golden.txt), --frames N timed per scene,
+//          --seed N for battle shuffles and reward rolls
+
+namespace {
+    constexpr Uint32 FRAME_MS = 16;
+    constexpr int SETTLE_FRAMES = 120; // long enough for card moves and damage numbers to finish
+
+    struct Options {
+        std::string mode;
+        std::string golden = "render_golden.txt";
+        int frames = 200;
+        unsigned long long seed = 1;
+    };
+
+    struct SceneCase {
+        const char* name;
+        std::function<void(Game&)> enter;
+    };
+
+    bool parseOptions(int argc, char* argv[], Options& options) {
+        if (argc < 2) {
+            return false;
+        }
+        options.mode = argv[1];
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << "\n";
+                return false;
+            }
+            std::string value = argv[++i];
+            if (arg == "--golden") options.golden = value;
+            else if (arg == "--frames") options.frames = std::atoi(value.c_str());
+            else if (arg == "--seed") options.seed = std::strtoull(value.c_str(), nullptr, 10);
+            else {
+                std::cerr << "Unknown option " << arg << "\n";
+                return false;
+            }
+        }
+        return options.mode == "check" || options.mode == "update";
+    }
+
+    void printUsage() {
+        std::cerr << "Usage: RoguelikeRenderHarness check|update [--golden FILE] [--frames N] [--seed N]\n";
+    }
+
+    std::vector<SceneCase> sceneCases() {
+        return {
+            { "menu", [](Game& game) { game.setState(Game::GameState::MENU); } },
+            { "deck_selection", [](Game& game) { game.setState(Game::GameState::DECK_SELECTION); } },
+            { "map", [](Game& game) {
+                game.selectDeck(StarterDeck::BALANCED);
+                game.setState(Game::GameState::GAME);
+            } },
+            { "battle", [](Game& game) {
+                game.selectDeck(StarterDeck::BALANCED);
+                game.startBattle(0);
+            } },
+            { "reward", [](Game& game) {
+                game.setRewardScene(std::make_unique<RewardScene>(game.renderer, game.font, &game, RewardTier::Green));
+                game.setState(Game::GameState::REWARD);
+            } },
+            { "options", [](Game& game) { game.setState(Game::GameState::OPTIONS); } },
+        };
+    }
+
+    // FNV-1a over the frame's bytes.
+    std::uint64_t hashFrame(const std::vector<Uint32>& pixels) {
+        std::uint64_t hash = 14695981039346656037ull;
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(pixels.data());
+        for (size_t i = 0; i < pixels.size() * sizeof(Uint32); ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    bool loadGolden(const std::string& path, std::map<std::string, std::uint64_t>& golden) {
+        std::ifstream file(path);
+        if (!file) {
+            return false;
+        }
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream fields(line);
+            std::string key;
+            std::string hash;
+            if (line.empty() || line[0] == '#' || !(fields >> key >> hash)) {
+                continue;
+            }
+            golden[key] = std::strtoull(hash.c_str(), nullptr, 16);
+        }
+        return true;
+    }
+
+    bool saveGolden(const std::string& path, const std::map<std::string, std::uint64_t>& hashes) {
+        std::ofstream file(path);
+        if (!file) {
+            return false;
+        }
+        file << "# scene@WIDTHxHEIGHT FNV-1a of the ARGB8888 frame, written by RoguelikeRenderHarness update\n";
+        for (const auto& entry : hashes) {
+            file << entry.first << " " << std::hex << std::setw(16) << std::setfill('0') << entry.second << std::dec << "\n";
+        }
+        return static_cast<bool>(file);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    std::map<std::string, std::uint64_t> golden;
+    if (options.mode == "check" && !loadGolden(options.golden, golden)) {
+        std::cerr << "No golden file at " << options.golden << "; run update first\n";
+        return 1;
+    }
+
+    // Before any SDL call, since the hints below already allocate.
+    MemoryStats::installSDLHooks();
+
+    // An explicit driver in the environment wins, e.g. to watch the harness run.
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+
+    Game game;
+    if (!game.init("Render Harness", Constants::DEFAULT_WINDOW_WIDTH, Constants::DEFAULT_WINDOW_HEIGHT)) {
+        return 1;
+    }
+
+    std::map<std::string, std::uint64_t> hashes;
+    int mismatches = 0;
+    Uint32 clock = 0;
+
+    for (const Constants::Resolution& resolution : Constants::RESOLUTIONS) {
+        game.setState(Game::GameState::MENU);
+        game.setResolution(resolution.width, resolution.height);
+        if (!game.renderer) {
+            return 1;
+        }
+        SDL_Texture* target = MemoryStats::createTexture(game.renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+            resolution.width, resolution.height);
+        if (!target) {
+            std::cerr << "Could not create render target! SDL_Error: " << SDL_GetError() << "\n";
+            return 1;
+        }
+        SDL_SetRenderTarget(game.renderer, target);
+        std::vector<Uint32> pixels(static_cast<size_t>(resolution.width) * resolution.height);
+        std::string size = std::to_string(resolution.width) + "x" + std::to_string(resolution.height);
+
+        for (const SceneCase& scene : sceneCases()) {
+            game.setSeed(options.seed);
+            scene.enter(game);
+
+            // Settle on a synthetic clock, letting background jobs land between frames.
+            for (int frame = 0; frame < SETTLE_FRAMES; ++frame) {
+                game.getSimulation().waitIdle();
+                clock += FRAME_MS;
+                game.update(clock);
+                FrameArena::get().reset();
+            }
+            game.currentScene->render();
+            if (SDL_RenderReadPixels(game.renderer, nullptr, SDL_PIXELFORMAT_ARGB8888, pixels.data(),
+                resolution.width * static_cast<int>(sizeof(Uint32))) != 0) {
+                std::cerr << "Could not read back " << scene.name << "! SDL_Error: " << SDL_GetError() << "\n";
+                return 1;
+            }
+            std::string key = std::string(scene.name) + "@" + size;
+            std::uint64_t hash = hashFrame(pixels);
+            hashes[key] = hash;
+
+            auto start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < options.frames; ++frame) {
+                clock += FRAME_MS;
+                game.update(clock);
+                game.currentScene->render();
+                SDL_RenderFlush(game.renderer);
+                FrameArena::get().reset();
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            const char* verdict = "";
+            if (options.mode == "check") {
+                auto expected = golden.find(key);
+                if (expected == golden.end()) {
+                    verdict = "  MISSING";
+                    ++mismatches;
+                }
+                else if (expected->second != hash) {
+                    verdict = "  MISMATCH";
+                    ++mismatches;
+                }
+            }
+            std::cout << std::left << std::setw(26) << key << std::right << std::hex << std::setw(16) << std::setfill('0')
+                << hash << std::dec << std::setfill(' ') << "  " << std::fixed << std::setprecision(1) << std::setw(8)
+                << (seconds > 0.0 ? options.frames / seconds : 0.0) << " fps" << verdict << "\n";
+        }
+
+        SDL_SetRenderTarget(game.renderer, nullptr);
+        MemoryStats::destroyTexture(target);
+    }
+
+    if (options.mode == "update") {
+        if (!saveGolden(options.golden, hashes)) {
+            std::cerr << "Could not write " << options.golden << "\n";
+            return 1;
+        }
+        std::cout << "Wrote " << hashes.size() << " frame hashes to " << options.golden << "\n";
+        return 0;
+    }
+    if (mismatches > 0) {
+        std::cout << mismatches << " of " << hashes.size() << " frames differ from " << options.golden << "\n";
+        return 1;
+    }
+    std::cout << "All " << hashes.size() << " frames match " << options.golden << "\n";
+    return 0;
+}
\ No newline at end of file
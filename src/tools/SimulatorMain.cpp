@@ -0,0 +1,490 @@
+#include "../includes/simulation/CardLibrary.h"
+#include "../includes/simulation/CombatState.h"
+#include "../includes/simulation/MctsAgent.h"
+#include "../includes/simulation/CombatSolver.h"
+#include "../includes/simulation/RunSimulator.h"
+#include "../includes/simulation/DeckOptimizer.h"
+#include "../includes/simulation/BatchCombat.h"
+#include "../includes/simulation/DeckStatistics.h"
+#include "../includes/simulation/EnemyTable.h"
+#include "../includes/simulation/EventLog.h"
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <chrono>
+#include <map>
+#include <memory>
+
+// Headless front end for the combat simulation. Builds without SDL.
+//
+//   RoguelikeSimulator battle [options]   auto-play battles with the MCTS agent
+//   RoguelikeSimulator bench [options]    measure search throughput from the opening hand
+//   RoguelikeSimulator solve [options]    exact optimal win probability over all shuffles
+//   RoguelikeSimulator run [options]      whole runs over the map with per-node death rates
+//   RoguelikeSimulator optimize [options] evolve starting decks and reward preferences
+//   RoguelikeSimulator batch [options]    random-policy fights in SIMD lockstep against the scalar engine
+//   RoguelikeSimulator stats [options]    exact per-turn draw odds, damage and turns to kill for a deck
+//   RoguelikeSimulator events --log FILE  win rates per encounter and damage per card from an event log
+//
+// Options: --deck damage|balanced|elemental|defense, --enemy ENCOUNTER|HP:DAMAGE (encounters from assets/data/enemies.txt),
+//          --games N, --budget MS, --threads N, --seed N, --turns N, --runs N, --reward random|skip|best,
+//          --population N, --generations N, --checkpoint FILE (optimize resumes from it when present),
+//          --log FILE (battle and run append every play and outcome to it; see EventLog.h)
+
+namespace {
+    struct Options {
+        std::string mode;
+        StarterDeck deck = StarterDeck::BALANCED;
+        int enemyHP = 30;
+        int enemyDamage = 4;
+        std::uint16_t enemyResistances = 0;
+        const EnemyBehavior* enemyBehavior = nullptr;
+        int games = 100;
+        double budgetMs = 20.0;
+        int threads = 0;
+        unsigned long long seed = 1;
+        int turns = 20;
+        long long runs = 10000;
+        std::string reward = "random";
+        int population = 32;
+        int generations = 20;
+        std::string checkpoint;
+        std::string log;
+        std::string enemy = "30:4";
+        bool runsSet = false;
+    };
+
+    // An encounter id from the enemy table, or a bare HP:DAMAGE enemy that attacks every turn.
+    bool parseEnemy(const std::string& value, Options& options) {
+        const EnemyTable& enemies = EnemyTable::getDefault();
+        int encounter = enemies.findEncounter(value);
+        if (encounter >= 0) {
+            const EncounterDef& enemy = enemies.getEncounter(encounter);
+            options.enemyHP = enemy.hp;
+            options.enemyDamage = enemy.damage;
+            options.enemyResistances = enemy.resistances;
+            options.enemyBehavior = &enemy.behavior;
+            return true;
+        }
+        size_t colon = value.find(':');
+        if (colon == std::string::npos) {
+            return false;
+        }
+        options.enemyHP = std::atoi(value.substr(0, colon).c_str());
+        options.enemyDamage = std::atoi(value.substr(colon + 1).c_str());
+        options.enemyResistances = 0;
+        options.enemyBehavior = nullptr;
+        return options.enemyHP > 0 && options.enemyDamage >= 0;
+    }
+
+    bool parseOptions(int argc, char* argv[], Options& options) {
+        if (argc < 2) {
+            return false;
+        }
+        options.mode = argv[1];
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << "\n";
+                return false;
+            }
+            std::string value = argv[++i];
+            if (arg == "--deck") {
+                if (!CardLibrary::parseStarterDeck(value, options.deck)) {
+                    std::cerr << "Unknown deck " << value << "\n";
+                    return false;
+                }
+            }
+            else if (arg == "--enemy") {
+                if (!parseEnemy(value, options)) {
+                    std::cerr << "Unknown enemy " << value << "\n";
+                    return false;
+                }
+                options.enemy = value;
+            }
+            else if (arg == "--games") options.games = std::atoi(value.c_str());
+            else if (arg == "--budget") options.budgetMs = std::atof(value.c_str());
+            else if (arg == "--threads") options.threads = std::atoi(value.c_str());
+            else if (arg == "--seed") options.seed = std::strtoull(value.c_str(), nullptr, 10);
+            else if (arg == "--turns") options.turns = std::atoi(value.c_str());
+            else if (arg == "--runs") {
+                options.runs = std::atoll(value.c_str());
+                options.runsSet = true;
+            }
+            else if (arg == "--reward") options.reward = value;
+            else if (arg == "--population") options.population = std::atoi(value.c_str());
+            else if (arg == "--generations") options.generations = std::atoi(value.c_str());
+            else if (arg == "--checkpoint") options.checkpoint = value;
+            else if (arg == "--log") options.log = value;
+            else {
+                std::cerr << "Unknown option " << arg << "\n";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void printUsage() {
+        std::cerr << "Usage: RoguelikeSimulator battle|bench|solve|run|optimize|batch|stats|events [--deck NAME] [--enemy ENCOUNTER|HP:DAMAGE]"
+            << " [--games N] [--budget MS] [--threads N] [--seed N] [--turns N] [--runs N] [--reward random|skip|best]"
+            << " [--population N] [--generations N] [--checkpoint FILE] [--log FILE]\n";
+    }
+
+    MctsAgent makeAgent(const Options& options) {
+        MctsAgent::Config config;
+        config.budgetMs = options.budgetMs;
+        config.threads = options.threads;
+        config.seed = options.seed;
+        config.maxTurns = options.turns;
+        return MctsAgent(config);
+    }
+
+    int runBattles(const Options& options) {
+        CombatDeck deck = CardLibrary::buildCombatDeck(CardLibrary::getStarterDeck(options.deck));
+        MctsAgent agent = makeAgent(options);
+        EventLog log;
+        std::unique_ptr<EventLog::Buffer> events;
+        if (!options.log.empty()) {
+            if (!log.open(options.log)) {
+                return 1;
+            }
+            events = std::make_unique<EventLog::Buffer>(log);
+        }
+
+        int wins = 0;
+        long long totalTurns = 0;
+        long long totalHP = 0;
+        long long rollouts = 0;
+        double searchMs = 0.0;
+        for (int game = 0; game < options.games; ++game) {
+            CombatState state = CombatState::begin(deck, options.enemyHP, options.enemyDamage, options.seed + game);
+            state.resistances = options.enemyResistances;
+            state.setBehavior(options.enemyBehavior);
+            if (events) {
+                events->battleStarted(options.enemy, state);
+            }
+            while (!state.isOver() && state.turn < agent.getConfig().maxTurns) {
+                MctsAgent::Result result = agent.chooseAction(state, deck);
+                rollouts += result.rollouts;
+                searchMs += result.elapsedMs;
+                CombatState before = state;
+                MctsAgent::applyAction(state, deck, result.action);
+                if (!events) continue;
+                if (result.action == MctsAgent::END_TURN) events->turnEnded(before, state);
+                else events->cardPlayed(deck.getSpec(result.action), before, state);
+            }
+            if (events) {
+                events->battleEnded(state, !state.isOver() ? EventLog::Result::Stalled
+                    : state.hasWon() ? EventLog::Result::Won : EventLog::Result::Lost);
+            }
+            if (state.hasWon()) {
+                ++wins;
+                totalHP += state.playerHP;
+            }
+            totalTurns += state.turn;
+        }
+
+        std::cout << "games " << options.games << ", wins " << wins
+            << " (" << (options.games > 0 ? 100.0 * wins / options.games : 0.0) << "%)\n";
+        std::cout << "mean turns " << (options.games > 0 ? static_cast<double>(totalTurns) / options.games : 0.0)
+            << ", mean HP left on a win " << (wins > 0 ? static_cast<double>(totalHP) / wins : 0.0) << "\n";
+        std::cout << "rollouts " << rollouts << " in " << searchMs << " ms ("
+            << (searchMs > 0.0 ? rollouts / searchMs : 0.0) << " per ms)\n";
+        return 0;
+    }
+
+    int runBench(const Options& options) {
+        CombatDeck deck = CardLibrary::buildCombatDeck(CardLibrary::getStarterDeck(options.deck));
+        CombatState state = CombatState::begin(deck, options.enemyHP, options.enemyDamage, options.seed);
+        state.resistances = options.enemyResistances;
+        state.setBehavior(options.enemyBehavior);
+        MctsAgent agent = makeAgent(options);
+
+        MctsAgent::Result result = agent.chooseAction(state, deck);
+        std::cout << "rollouts " << result.rollouts << " in " << result.elapsedMs << " ms ("
+            << (result.elapsedMs > 0.0 ? result.rollouts / result.elapsedMs : 0.0) << " per ms)\n";
+        for (const auto& action : result.actions) {
+            std::string name = action.action == MctsAgent::END_TURN ? "End Turn" : deck.getSpec(action.action).name;
+            std::cout << "  " << name << ": " << action.visits << " visits, mean " << action.meanValue << "\n";
+        }
+        return 0;
+    }
+
+    int runSolve(const Options& options) {
+        CombatDeck deck = CardLibrary::buildCombatDeck(CardLibrary::getStarterDeck(options.deck));
+        CombatSolver::Config config;
+        config.maxTurns = options.turns;
+        config.threads = options.threads;
+        CombatSolver solver(config);
+
+        CombatSolver::Result result = solver.solveOpening(deck, options.enemyHP, options.enemyDamage, options.enemyResistances, options.enemyBehavior);
+        if (!result.solved && result.nodes == 0) {
+            return 1; // too many distinct cards; the solver already said so
+        }
+        if (!result.solved) {
+            std::cout << "gave up after " << result.nodes << " positions in " << result.elapsedMs << " ms";
+        }
+        else {
+            std::cout << "optimal win probability " << result.winProbability << " within " << options.turns << " turns\n";
+            std::cout << result.nodes << " positions expanded, " << result.entries << " stored, " << result.elapsedMs << " ms";
+        }
+        if (result.saturated) {
+            std::cout << "; the table filled up at " << result.entries << " entries, so later positions were searched again";
+        }
+        std::cout << "\n";
+        return result.solved ? 0 : 1;
+    }
+
+    int runRuns(const Options& options) {
+        RunPolicy policy = RunPolicy::defaults();
+        if (options.reward == "skip") policy.chooseReward = &RunPolicy::skipReward;
+        else if (options.reward == "best") policy.chooseReward = &RunPolicy::bestValueReward;
+        else if (options.reward != "random") {
+            std::cerr << "Unknown reward policy " << options.reward << "\n";
+            return 1;
+        }
+
+        MapGraph graph = MapGraph::createDefault();
+        RunSimulator simulator(graph, policy);
+        RunSimulator::Config config;
+        config.deck = options.deck;
+        config.runs = options.runs;
+        config.threads = options.threads;
+        config.seed = options.seed;
+        EventLog log;
+        if (!options.log.empty()) {
+            if (!log.open(options.log)) {
+                return 1;
+            }
+            config.events = &log;
+        }
+        RunSimulator::Report report = simulator.simulate(config);
+
+        std::cout << "runs " << report.runs << ", cleared " << report.wins << ", died " << report.deaths
+            << ", stalled " << report.stalls << ", mean final deck " << report.meanFinalDeckSize << " cards\n";
+        std::cout << report.elapsedMs << " ms (" << (report.elapsedMs > 0.0 ? report.runs * 1000.0 / report.elapsedMs : 0.0)
+            << " runs per second)\n";
+        for (int i = 0; i < graph.getNodeCount(); ++i) {
+            const RunSimulator::NodeStats& node = report.nodes[i];
+            std::cout << "  " << graph.getNode(i).label << ": entered " << node.entered << ", deaths " << node.deaths;
+            if (node.entered > 0) {
+                std::cout << " (" << 100.0 * node.deaths / node.entered << "% of entries)";
+            }
+            std::cout << "\n";
+        }
+        return 0;
+    }
+
+    // An example query over the columns: outcomes per encounter, plays and damage per card.
+    int runEvents(const Options& options) {
+        if (options.log.empty()) {
+            std::cerr << "events needs --log FILE\n";
+            return 1;
+        }
+        struct EncounterTotals {
+            long long battles = 0;
+            long long wins = 0;
+            long long turns = 0;
+        };
+        struct CardTotals {
+            long long plays = 0;
+            long long damage = 0;
+        };
+        std::map<std::string, EncounterTotals> encounters;
+        std::map<std::string, CardTotals> cards;
+        long long rows = 0;
+        long long chunks = 0;
+        auto start = std::chrono::steady_clock::now();
+        bool ok = EventLog::read(options.log, [&](const EventLog::Chunk& chunk) {
+            ++chunks;
+            rows += chunk.rows;
+            const auto& kind = chunk.columns[EventLog::KIND];
+            for (int row = 0; row < chunk.rows; ++row) {
+                auto type = static_cast<EventLog::Kind>(kind[row]);
+                if (type == EventLog::Kind::BattleEnded) {
+                    EncounterTotals& totals = encounters[chunk.words[chunk.columns[EventLog::ENCOUNTER][row]]];
+                    ++totals.battles;
+                    totals.wins += chunk.columns[EventLog::RESULT][row] == static_cast<std::int64_t>(EventLog::Result::Won);
+                    totals.turns += chunk.columns[EventLog::TURN][row];
+                }
+                else if (type == EventLog::Kind::CardPlayed) {
+                    CardTotals& totals = cards[chunk.words[chunk.columns[EventLog::CARD][row]]];
+                    ++totals.plays;
+                    totals.damage += chunk.columns[EventLog::ENEMY_DAMAGE][row];
+                }
+            }
+        });
+        double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (!ok) {
+            return 1;
+        }
+
+        std::cout << rows << " events in " << chunks << " chunks, read in " << elapsedMs << " ms\n";
+        for (const auto& entry : encounters) {
+            const EncounterTotals& totals = entry.second;
+            std::cout << "  " << entry.first << ": " << totals.battles << " battles, "
+                << 100.0 * totals.wins / totals.battles << "% won, mean " << static_cast<double>(totals.turns) / totals.battles << " turns\n";
+        }
+        for (const auto& entry : cards) {
+            const CardTotals& totals = entry.second;
+            std::cout << "  " << entry.first << ": " << totals.plays << " plays, mean "
+                << static_cast<double>(totals.damage) / totals.plays << " damage\n";
+        }
+        return 0;
+    }
+
+    void printBatchReport(const char* label, const BatchCombat::Report& report) {
+        std::cout << label << ": " << report.fights << " fights, " << report.wins << " wins, " << report.stalls
+            << " stalls, " << report.elapsedMs << " ms ("
+            << (report.elapsedMs > 0.0 ? report.fights / report.elapsedMs : 0.0) << " fights per ms)\n";
+    }
+
+    int runBatch(const Options& options) {
+        CombatDeck deck = CardLibrary::buildCombatDeck(CardLibrary::getStarterDeck(options.deck));
+        // The lockstep kernel plays the enemy's intents but not its resistances.
+        BatchCombat::Config config;
+        config.maxTurns = options.turns;
+        config.seed = options.seed;
+        BatchCombat batch(deck, options.enemyHP, options.enemyDamage, config, options.enemyBehavior);
+        if (!BatchCombat::isLockstep()) {
+            std::cout << "No lockstep kernels in this build (configure with -DROGUECARDS_AVX2=ON)\n";
+            printBatchReport("scalar", batch.runScalar(options.games));
+            return 0;
+        }
+
+        BatchCombat::Report scalar = batch.runScalar(options.games);
+        BatchCombat::Report lockstep = batch.run(options.games);
+        printBatchReport("scalar", scalar);
+        printBatchReport(BatchCombat::getKernelName(), lockstep);
+        if (lockstep.elapsedMs > 0.0) {
+            std::cout << "speedup " << scalar.elapsedMs / lockstep.elapsedMs << "x\n";
+        }
+
+        // Both engines play the same fights with the same draws, so any difference is a kernel bug.
+        if (scalar.wins != lockstep.wins || scalar.stalls != lockstep.stalls ||
+            scalar.totalTurns != lockstep.totalTurns || scalar.totalHP != lockstep.totalHP) {
+            std::cerr << "Batch results differ from the scalar engine\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    int runStats(const Options& options) {
+        CombatDeck deck = CardLibrary::buildCombatDeck(CardLibrary::getStarterDeck(options.deck));
+        MapGraph graph = MapGraph::createDefault();
+        std::vector<int> enemyHP;
+        std::vector<std::string> enemyNames;
+        for (int i = 0; i < graph.getNodeCount(); ++i) {
+            if (graph.getNode(i).type == NodeType::Fight) {
+                enemyHP.push_back(graph.getEncounter(i).hp);
+                enemyNames.push_back(graph.getEncounter(i).name);
+            }
+        }
+        int turns = std::min(options.turns, DeckStatistics::MAX_TURNS);
+
+        DeckReport report;
+        if (!DeckStatistics::analyze(deck, enemyHP, turns, report)) {
+            return 1;
+        }
+        std::cout << report.elapsedUs << " us, " << report.peakPositions << " positions at most\n";
+        for (size_t turn = 0; turn < report.turns.size(); ++turn) {
+            const DeckTurnStats& stats = report.turns[turn];
+            std::cout << "turn " << turn + 1 << ": damage " << stats.expectedDamage << ", armor " << stats.expectedArmor << ", in hand:";
+            for (int s = 0; s < deck.getSpecCount(); ++s) {
+                std::cout << " " << deck.getSpec(s).name << " " << stats.inHand[s];
+            }
+            std::cout << "\n";
+        }
+        for (size_t enemy = 0; enemy < enemyHP.size(); ++enemy) {
+            std::cout << enemyNames[enemy] << " (" << enemyHP[enemy] << " HP): expected " << report.getExpectedTurnsToKill(static_cast<int>(enemy))
+                << " turns, dead by turn";
+            for (size_t turn = 0; turn < report.killedBy[enemy].size(); ++turn) {
+                std::cout << " " << turn + 1 << ":" << report.killedBy[enemy][turn];
+            }
+            std::cout << "\n";
+        }
+        return 0;
+    }
+
+    void printArchetype(const DeckOptimizer::Entry& entry) {
+        std::cout << "  " << entry.fitness.score << " (clear " << 100.0 * entry.fitness.runClearRate
+            << "%, roster " << entry.fitness.rosterScore << "): " << entry.genome.describe() << "\n";
+    }
+
+    int runOptimize(const Options& options) {
+        DeckOptimizer::Config config;
+        config.population = options.population;
+        config.generations = options.generations;
+        config.threads = options.threads;
+        config.seed = options.seed;
+        config.checkpointPath = options.checkpoint;
+        if (options.runsSet) {
+            config.runsPerEvaluation = options.runs;
+        }
+
+        DeckOptimizer optimizer(MapGraph::createDefault(), config);
+        if (!options.checkpoint.empty() && optimizer.loadCheckpoint(options.checkpoint)) {
+            std::cout << "resuming from generation " << optimizer.getGeneration() << " with "
+                << optimizer.getEvaluatedCount() << " archetypes evaluated\n";
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        optimizer.run([](int generation, const DeckOptimizer::Entry& best) {
+            std::cout << "generation " << generation << ": best " << best.fitness.score
+                << " (clear " << 100.0 * best.fitness.runClearRate << "%) " << best.genome.describe() << "\n";
+        });
+        double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << optimizer.getEvaluatedCount() << " archetypes evaluated, " << elapsedMs << " ms\n";
+        std::cout << "strongest:\n";
+        for (const auto& entry : optimizer.getStrongest(5)) {
+            printArchetype(entry);
+        }
+        std::cout << "weakest:\n";
+        for (const auto& entry : optimizer.getWeakest(5)) {
+            printArchetype(entry);
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (!MapGraph::createDefault().isValid()) {
+        std::cerr << "Failed to load enemy data from " << EnemyTable::DEFAULT_PATH << "\n";
+        return 1;
+    }
+
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    if (options.mode == "battle") {
+        return runBattles(options);
+    }
+    if (options.mode == "bench") {
+        return runBench(options);
+    }
+    if (options.mode == "solve") {
+        return runSolve(options);
+    }
+    if (options.mode == "run") {
+        return runRuns(options);
+    }
+    if (options.mode == "optimize") {
+        return runOptimize(options);
+    }
+    if (options.mode == "batch") {
+        return runBatch(options);
+    }
+    if (options.mode == "stats") {
+        return runStats(options);
+    }
+    if (options.mode == "events") {
+        return runEvents(options);
+    }
+    printUsage();
+    return 1;
+}
\ No newline at end of file
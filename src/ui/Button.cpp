@@ -1,4 +1,6 @@
 #include "../includes/ui/Button.h"
+#include "../includes/systems/RenderStats.h"
+#include "../includes/systems/MemoryStats.h"
 #include <iostream>
 
 Button::Button(int x, int y, int w, int h, const std::string& label, TTF_Font* font, SDL_Renderer* renderer,
@@ -10,7 +12,7 @@ Button::Button(int x, int y, int w, int h, const std::string& label, TTF_Font* f
 
 Button::~Button() {
     if (texture) {
-        SDL_DestroyTexture(texture);
+        MemoryStats::destroyTexture(texture);
         texture = nullptr;
     }
 }
@@ -27,7 +29,7 @@ Button::Button(Button&& other) noexcept
 Button& Button::operator=(Button&& other) noexcept {
     if (this != &other) {
         if (texture) {
-            SDL_DestroyTexture(texture);
+            MemoryStats::destroyTexture(texture);
         }
         rect = other.rect;
         originalRect = other.originalRect;
@@ -48,7 +50,7 @@ Button& Button::operator=(Button&& other) noexcept {
 void Button::setRenderer(SDL_Renderer* newRenderer) {
     renderer = newRenderer;
     if (texture) {
-        SDL_DestroyTexture(texture);
+        MemoryStats::destroyTexture(texture);
         texture = nullptr;
     }
     needsTextureUpdate = true; // Defer texture creation to render()
@@ -56,7 +58,7 @@ void Button::setRenderer(SDL_Renderer* newRenderer) {
 
 void Button::createTexture() {
     if (texture) {
-        SDL_DestroyTexture(texture);
+        MemoryStats::destroyTexture(texture);
         texture = nullptr;
     }
 
@@ -77,7 +79,7 @@ void Button::createTexture() {
         return;
     }
 
-    texture = SDL_CreateTextureFromSurface(renderer, surface);
+    texture = MemoryStats::createTextureFromSurface(renderer, surface);
     if (!texture) {
         std::cerr << "Failed to create texture for button label: " << SDL_GetError() << std::endl;
     }
@@ -91,7 +93,7 @@ void Button::updateText(const std::string& newLabel, TTF_Font* font, SDL_Rendere
     this->font = font;
     this->renderer = renderer;
     if (texture) {
-        SDL_DestroyTexture(texture);
+        MemoryStats::destroyTexture(texture);
         texture = nullptr;
     }
     needsTextureUpdate = true; // Defer texture creation to render()
@@ -113,13 +115,13 @@ void Button::render() {
         SDL_SetRenderDrawColor(renderer, 200, 200, 200, 255); // Gray when not hovered
         rect = originalRect;
     }
-    SDL_RenderFillRect(renderer, &rect);
+    RenderStats::fillRect(renderer, &rect);
 
     if (texture) {
         int texW, texH;
         SDL_QueryTexture(texture, nullptr, nullptr, &texW, &texH);
         SDL_Rect textRect = { rect.x + (rect.w - texW) / 2, rect.y + (rect.h - texH) / 2, texW, texH };
-        SDL_RenderCopy(renderer, texture, nullptr, &textRect);
+        RenderStats::copy(renderer, texture, nullptr, &textRect);
     }
 }
 
@@ -144,8 +146,13 @@ void Button::setPosition(int x, int y) {
     originalRect.x = x;
     originalRect.y = y;
     if (texture) {
-        SDL_DestroyTexture(texture);
+        MemoryStats::destroyTexture(texture);
         texture = nullptr;
     }
     needsTextureUpdate = true; // Defer texture creation to render()
+}
+
+void Button::setRect(const SDL_Rect& newRect) {
+    rect = newRect;
+    originalRect = newRect;
 }
\ No newline at end of file
@@ -1,25 +1,105 @@
 #include "../includes/ui/Card.h"
 #include "../includes/common/Constants.h"
+#include "../includes/systems/RenderStats.h"
+#include "../includes/systems/FrameArena.h"
+#include "../includes/systems/MemoryStats.h"
 #include <SDL_image.h>
+#include <cctype>
 #include <iostream>
-#include <sstream>
 
 Card::Card(int x, int y, const std::string& name, int damage, int energyCost, SDL_Renderer* renderer, TTF_Font* font, CardEffect effect)
     : rect{ x, y, Constants::CARD_WIDTH, Constants::CARD_HEIGHT }, originalRect{ x, y, Constants::CARD_WIDTH, Constants::CARD_HEIGHT },
-    name(name), damage(damage), energyCost(energyCost), effect(effect), renderer(renderer), font(font),
-    textTexture(nullptr), imageTexture(nullptr), isDragging(false), isHovered(false), isMagnified(false),
-    hoverStartTime(0), needsTextTextureUpdate(true) {
+    name(name), damage(damage), energyCost(energyCost), effect(effect), renderer(renderer), font(font), magnifiedFont(nullptr),
+    textTexture(nullptr), magnifiedTextTexture(nullptr), image(nullptr), isDragging(false), isHovered(false), isMagnified(false),
+    magnification(1.0f), tweens(nullptr), magnifyTween(TweenScheduler::INVALID_HANDLE), moveTween(TweenScheduler::INVALID_HANDLE),
+    moveFrom{ x, y, Constants::CARD_WIDTH, Constants::CARD_HEIGHT },
+    hoverStartTime(0), needsTextTextureUpdate(true), needsMagnifiedTextUpdate(true) {
+}
+
+void Card::setRect(const SDL_Rect& newRect) {
+    if (isDragging) {
+        originalRect = newRect;
+        return;
+    }
+    bool sameTarget = newRect.x == originalRect.x && newRect.y == originalRect.y &&
+        newRect.w == originalRect.w && newRect.h == originalRect.h;
+    bool atTarget = newRect.x == rect.x && newRect.y == rect.y && newRect.w == rect.w && newRect.h == rect.h;
+    originalRect = newRect;
+    if (!tweens) {
+        rect = newRect;
+        return;
+    }
+    // Layout passes re-apply every slot; only start a move when something changed.
+    if (isMoving() ? sameTarget : atTarget) {
+        return;
+    }
+
+    tweens->cancel(moveTween);
+    moveFrom = rect;
+    moveTween = tweens->start(0.0f, 1.0f, Constants::CARD_MOVE_DURATION);
+}
+
+void Card::placeAt(const SDL_Rect& newRect) {
+    if (tweens) {
+        tweens->cancel(moveTween);
+    }
+    moveTween = TweenScheduler::INVALID_HANDLE;
+    rect = newRect;
+    originalRect = newRect;
+}
+
+void Card::setMagnified(bool magnified) {
+    if (isMagnified == magnified) {
+        return;
+    }
+    isMagnified = magnified;
+    float target = magnified ? Constants::CARD_MAGNIFICATION_SCALE : 1.0f;
+    if (!tweens) {
+        magnification = target;
+        return;
+    }
+    tweens->cancel(magnifyTween);
+    magnifyTween = tweens->start(magnification, target, Constants::CARD_MAGNIFY_DURATION);
+}
+
+void Card::update(Uint32 now) {
+    // Checked every tick so a card magnifies even if the mouse stays still.
+    if (isHovered && !isDragging && !isMagnified && now - hoverStartTime >= HOVER_DELAY) {
+        setMagnified(true);
+    }
+
+    if (!tweens) {
+        return;
+    }
+    if (magnifyTween != TweenScheduler::INVALID_HANDLE) {
+        float target = isMagnified ? Constants::CARD_MAGNIFICATION_SCALE : 1.0f;
+        magnification = tweens->getValue(magnifyTween, target);
+        if (!tweens->isActive(magnifyTween)) {
+            magnifyTween = TweenScheduler::INVALID_HANDLE;
+        }
+    }
+    if (moveTween != TweenScheduler::INVALID_HANDLE) {
+        float t = tweens->getValue(moveTween, 1.0f);
+        rect.x = moveFrom.x + static_cast<int>((originalRect.x - moveFrom.x) * t);
+        rect.y = moveFrom.y + static_cast<int>((originalRect.y - moveFrom.y) * t);
+        rect.w = moveFrom.w + static_cast<int>((originalRect.w - moveFrom.w) * t);
+        rect.h = moveFrom.h + static_cast<int>((originalRect.h - moveFrom.h) * t);
+        if (!tweens->isActive(moveTween)) {
+            rect = originalRect;
+            moveTween = TweenScheduler::INVALID_HANDLE;
+        }
+    }
 }
 
 void Card::setRenderer(SDL_Renderer* newRenderer) {
     renderer = newRenderer;
-    if (imageTexture) {
-        imageTexture = nullptr; // TextureManager will reload the image texture
-    }
+    image = nullptr; // TextureManager will reload the image
     if (textTexture) {
         textTexture = nullptr;
     }
+    magnifiedTextTexture = nullptr;
     needsTextTextureUpdate = true;
+    needsMagnifiedTextUpdate = true;
 }
 
 void Card::setFont(TTF_Font* newFont) {
@@ -30,6 +110,12 @@ void Card::setFont(TTF_Font* newFont) {
     needsTextTextureUpdate = true;
 }
 
+void Card::setMagnifiedFont(TTF_Font* newFont) {
+    magnifiedFont = newFont;
+    magnifiedTextTexture = nullptr;
+    needsMagnifiedTextUpdate = true;
+}
+
 void Card::createTextTexture() {
     if (textTexture) {
         textTexture = nullptr;
@@ -40,28 +126,41 @@ void Card::createTextTexture() {
         return;
     }
 
+    textTexture = renderText(font, Constants::CARD_WIDTH - 10);
+    needsTextTextureUpdate = !textTexture;
+}
+
+void Card::createMagnifiedTextTexture() {
+    magnifiedTextTexture = nullptr;
+    if (!renderer || !magnifiedFont) {
+        return;
+    }
+
+    magnifiedTextTexture = renderText(magnifiedFont, static_cast<int>((Constants::CARD_WIDTH - 10) * Constants::CARD_MAGNIFICATION_SCALE));
+    needsMagnifiedTextUpdate = !magnifiedTextTexture;
+}
+
+std::shared_ptr<SDL_Texture> Card::renderText(TTF_Font* textFont, int wrapWidth) const {
     // Create a string with the card's details
-    std::stringstream ss;
-    ss << name << "\nDmg: " << damage << "\nCost: " << energyCost;
-    std::string text = ss.str();
+    FrameText text;
+    text << name << "\nDmg: " << damage << "\nCost: " << energyCost;
 
     SDL_Color textColor = { 255, 255, 255, 255 }; // White text
-    SDL_Surface* surface = TTF_RenderText_Blended_Wrapped(font, text.c_str(), textColor, Constants::CARD_WIDTH - 10);
+    SDL_Surface* surface = TTF_RenderText_Blended_Wrapped(textFont, text.c_str(), textColor, wrapWidth);
     if (!surface) {
         std::cerr << "Failed to create surface for card text: " << TTF_GetError() << std::endl;
-        return;
+        return nullptr;
     }
 
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_Texture* texture = MemoryStats::createTextureFromSurface(renderer, surface);
     if (!texture) {
         std::cerr << "Failed to create texture for card text: " << SDL_GetError() << std::endl;
         SDL_FreeSurface(surface);
-        return;
+        return nullptr;
     }
 
-    textTexture = std::shared_ptr<SDL_Texture>(texture, SDL_DestroyTexture);
     SDL_FreeSurface(surface);
-    needsTextTextureUpdate = false;
+    return std::shared_ptr<SDL_Texture>(texture, MemoryStats::destroyTexture);
 }
 
 void Card::render(SDL_Renderer* renderer, int playerEnergy, int windowWidth, int windowHeight) {
@@ -69,10 +168,16 @@ void Card::render(SDL_Renderer* renderer, int playerEnergy, int windowWidth, int
         createTextTexture();
     }
 
+    bool magnified = magnification > 1.0f && !isDragging;
+    bool fullyMagnified = magnified && magnification >= Constants::CARD_MAGNIFICATION_SCALE;
+    if (fullyMagnified && needsMagnifiedTextUpdate && renderer && magnifiedFont) {
+        createMagnifiedTextTexture();
+    }
+
     SDL_Rect renderRect = rect;
-    if (isMagnified && !isDragging) {
-        renderRect.w = originalRect.w * 1.5;
-        renderRect.h = originalRect.h * 1.5;
+    if (magnified) {
+        renderRect.w = static_cast<int>(rect.w * magnification);
+        renderRect.h = static_cast<int>(rect.h * magnification);
 
         renderRect.x = rect.x - (renderRect.w - rect.w) / 2;
         renderRect.y = rect.y - (renderRect.h - rect.h) / 2;
@@ -91,69 +196,75 @@ void Card::render(SDL_Renderer* renderer, int playerEnergy, int windowWidth, int
         }
     }
 
-    if (playerEnergy < energyCost && !isDragging) {
-        SDL_SetTextureAlphaMod(imageTexture.get(), 128);
-    }
-    else {
-        SDL_SetTextureAlphaMod(imageTexture.get(), 255);
-    }
-
+    SDL_Texture* imageTexture = image ? image->select(renderRect.w, renderRect.h) : nullptr;
     if (imageTexture) {
-        SDL_RenderCopy(renderer, imageTexture.get(), nullptr, &renderRect);
+        SDL_SetTextureAlphaMod(imageTexture, playerEnergy < energyCost && !isDragging ? 128 : 255);
+        RenderStats::copy(renderer, imageTexture, nullptr, &renderRect);
+        SDL_SetTextureAlphaMod(imageTexture, 255);
     }
     else {
         SDL_SetRenderDrawColor(renderer, Constants::COLOR_GRAY.r, Constants::COLOR_GRAY.g, Constants::COLOR_GRAY.b, Constants::COLOR_GRAY.a);
-        SDL_RenderFillRect(renderer, &renderRect);
+        RenderStats::fillRect(renderer, &renderRect);
     }
 
-    if (textTexture) {
+    SDL_Texture* text = (fullyMagnified && magnifiedTextTexture) ? magnifiedTextTexture.get() : textTexture.get();
+    if (text) {
         int texW, texH;
-        SDL_QueryTexture(textTexture.get(), nullptr, nullptr, &texW, &texH);
+        SDL_QueryTexture(text, nullptr, nullptr, &texW, &texH);
         SDL_Rect textRect = { renderRect.x + 5, renderRect.y + 5, texW, texH };
-        SDL_RenderCopy(renderer, textTexture.get(), nullptr, &textRect);
+        RenderStats::copy(renderer, text, nullptr, &textRect);
     }
-
-    SDL_SetTextureAlphaMod(imageTexture.get(), 255);
 }
 
-void Card::handleEvent(SDL_Event& e) {
-    int x, y;
-    SDL_GetMouseState(&x, &y);
-    bool inside = (x >= rect.x && x <= rect.x + rect.w && y >= rect.y && y <= rect.y + rect.h);
-
+void Card::handleEvent(SDL_Event& e, bool inside) {
     if (e.type == SDL_MOUSEMOTION) {
         if (inside && !isDragging) {
             if (!isHovered) {
                 isHovered = true;
                 hoverStartTime = SDL_GetTicks();
             }
-
-            if (!isMagnified && (SDL_GetTicks() - hoverStartTime >= HOVER_DELAY)) {
-                isMagnified = true;
-            }
         }
         else {
             isHovered = false;
-            isMagnified = false;
+            setMagnified(false);
         }
     }
 
     if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT && inside) {
         isDragging = true;
+        isHovered = false;
         isMagnified = false;
+        magnification = 1.0f;
+        if (tweens) {
+            tweens->cancel(magnifyTween);
+            tweens->cancel(moveTween);
+        }
+        magnifyTween = TweenScheduler::INVALID_HANDLE;
+        moveTween = TweenScheduler::INVALID_HANDLE;
     }
 
     if (e.type == SDL_MOUSEMOTION && isDragging) {
-        rect.x = x - rect.w / 2;
-        rect.y = y - rect.h / 2;
+        rect.x = e.motion.x - rect.w / 2;
+        rect.y = e.motion.y - rect.h / 2;
     }
 }
 
-void Card::loadImage(const std::string& path, SDL_Renderer* renderer, TextureManager& textureManager) {
-    imageTexture = textureManager.loadTexture(path, renderer);
+void Card::clearHover() {
+    isHovered = false;
+    setMagnified(false);
+}
+
+void Card::loadImage(SDL_Renderer* renderer, TextureManager& textureManager) {
+    FrameText path;
+    path << Constants::CARD_PATH;
+    for (char c : name) {
+        path << (c == ' ' ? '_' : static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+    }
+    path << Constants::CARD_SUFFIX;
+    image = textureManager.loadImage(path.view(), renderer);
 }
 
 void Card::resetPosition() {
-    rect = originalRect;
-    isMagnified = false;
+    setMagnified(false);
+    setRect(originalRect);
 }
\ No newline at end of file
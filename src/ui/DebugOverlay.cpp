@@ -0,0 +1,83 @@
+#include "../includes/ui/DebugOverlay.h"
+#include "../includes/systems/RenderStats.h"
+#include "../includes/systems/MemoryStats.h"
+#include <iostream>
+
+namespace {
+    constexpr int MARGIN = 10;
+    constexpr int PADDING = 6;
+    constexpr int WRAP_WIDTH = 640;
+}
+
+DebugOverlay::DebugOverlay()
+    : renderer(nullptr), font(nullptr), texture(nullptr), rect{ MARGIN + PADDING, MARGIN + PADDING, 0, 0 },
+    needsTextureUpdate(false) {
+}
+
+DebugOverlay::~DebugOverlay() {
+    destroyTexture();
+}
+
+void DebugOverlay::destroyTexture() {
+    if (texture) {
+        MemoryStats::destroyTexture(texture);
+        texture = nullptr;
+    }
+}
+
+void DebugOverlay::setRenderer(SDL_Renderer* newRenderer) {
+    renderer = newRenderer;
+    destroyTexture();
+    needsTextureUpdate = true;
+}
+
+void DebugOverlay::setFont(TTF_Font* newFont) {
+    font = newFont;
+    destroyTexture();
+    needsTextureUpdate = true;
+}
+
+void DebugOverlay::setText(std::string_view newText) {
+    if (newText == text) {
+        return;
+    }
+    text.assign(newText.data(), newText.size());
+    needsTextureUpdate = true;
+}
+
+void DebugOverlay::createTexture() {
+    destroyTexture();
+    needsTextureUpdate = false;
+    if (!renderer || !font || text.empty()) {
+        return;
+    }
+
+    SDL_Color textColor = { 255, 255, 255, 255 };
+    SDL_Surface* surface = TTF_RenderText_Blended_Wrapped(font, text.c_str(), textColor, WRAP_WIDTH);
+    if (!surface) {
+        std::cerr << "Failed to create surface for debug overlay: " << TTF_GetError() << std::endl;
+        return;
+    }
+    texture = MemoryStats::createTextureFromSurface(renderer, surface);
+    if (!texture) {
+        std::cerr << "Failed to create texture for debug overlay: " << SDL_GetError() << std::endl;
+    }
+    rect.w = surface->w;
+    rect.h = surface->h;
+    SDL_FreeSurface(surface);
+}
+
+void DebugOverlay::render() {
+    if (needsTextureUpdate) {
+        createTexture();
+    }
+    if (!texture) {
+        return;
+    }
+
+    SDL_Rect background = { MARGIN, MARGIN, rect.w + 2 * PADDING, rect.h + 2 * PADDING };
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
+    RenderStats::fillRect(renderer, &background);
+    RenderStats::copy(renderer, texture, nullptr, &rect);
+}
\ No newline at end of file
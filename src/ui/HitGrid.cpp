@@ -0,0 +1,77 @@
+#include "../includes/ui/HitGrid.h"
+#include <algorithm>
+
+HitGrid::HitGrid(int cellSize) : cellSize(cellSize), columns(0), rows(0) {
+}
+
+void HitGrid::reset(int width, int height) {
+    columns = std::max(1, (width + cellSize - 1) / cellSize);
+    rows = std::max(1, (height + cellSize - 1) / cellSize);
+    entries.clear();
+    cellEntries.clear();
+    cellStart.assign(static_cast<size_t>(columns) * rows + 1, 0);
+}
+
+void HitGrid::insert(int id, const SDL_Rect& rect, int z) {
+    entries.push_back(Entry{ id, rect, z });
+}
+
+void HitGrid::build() {
+    // Counting pass, prefix sum, then fill: every cell's entries end up contiguous.
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+    int minColumn, minRow, maxColumn, maxRow;
+    for (const auto& entry : entries) {
+        if (!cellRange(entry.rect, minColumn, minRow, maxColumn, maxRow)) continue;
+        for (int row = minRow; row <= maxRow; ++row) {
+            for (int column = minColumn; column <= maxColumn; ++column) {
+                ++cellStart[row * columns + column + 1];
+            }
+        }
+    }
+    for (size_t i = 1; i < cellStart.size(); ++i) {
+        cellStart[i] += cellStart[i - 1];
+    }
+
+    cellEntries.assign(cellStart.back(), 0);
+    std::vector<int> cursor(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (!cellRange(entries[i].rect, minColumn, minRow, maxColumn, maxRow)) continue;
+        for (int row = minRow; row <= maxRow; ++row) {
+            for (int column = minColumn; column <= maxColumn; ++column) {
+                cellEntries[cursor[row * columns + column]++] = static_cast<int>(i);
+            }
+        }
+    }
+}
+
+int HitGrid::query(int x, int y) const {
+    if (x < 0 || y < 0 || cellStart.empty()) {
+        return -1;
+    }
+    int column = x / cellSize;
+    int row = y / cellSize;
+    if (column >= columns || row >= rows) {
+        return -1;
+    }
+
+    int cell = row * columns + column;
+    const Entry* best = nullptr;
+    for (int i = cellStart[cell]; i < cellStart[cell + 1]; ++i) {
+        const Entry& entry = entries[cellEntries[i]];
+        // Inclusive edges, matching the widgets' own hit tests.
+        if (x >= entry.rect.x && x <= entry.rect.x + entry.rect.w &&
+            y >= entry.rect.y && y <= entry.rect.y + entry.rect.h &&
+            (!best || entry.z >= best->z)) {
+            best = &entry;
+        }
+    }
+    return best ? best->id : -1;
+}
+
+bool HitGrid::cellRange(const SDL_Rect& rect, int& minColumn, int& minRow, int& maxColumn, int& maxRow) const {
+    minColumn = std::max(0, rect.x / cellSize);
+    minRow = std::max(0, rect.y / cellSize);
+    maxColumn = std::min(columns - 1, (rect.x + rect.w) / cellSize);
+    maxRow = std::min(rows - 1, (rect.y + rect.h) / cellSize);
+    return rect.x + rect.w >= 0 && rect.y + rect.h >= 0 && minColumn <= maxColumn && minRow <= maxRow;
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "../includes/ui/Layout.h"
+#include <algorithm>
+
+Layout::Layout(int referenceWidth, int referenceHeight)
+    : referenceWidth(referenceWidth), referenceHeight(referenceHeight), windowWidth(0), windowHeight(0),
+    scale(1.0f), dirty(true) {
+}
+
+int Layout::addAnchor(const LayoutAnchor& anchor) {
+    anchors.push_back(anchor);
+    anchorRects.push_back(SDL_Rect{ 0, 0, 0, 0 });
+    dirty = true;
+    return static_cast<int>(anchors.size()) - 1;
+}
+
+int Layout::addFlex(const LayoutFlex& flex, int itemCount) {
+    flexes.push_back(FlexEntry{ flex, itemCount, {} });
+    dirty = true;
+    return static_cast<int>(flexes.size()) - 1;
+}
+
+void Layout::setItemCount(int flexId, int count) {
+    if (flexes[flexId].count != count) {
+        flexes[flexId].count = count;
+        dirty = true;
+    }
+}
+
+bool Layout::update(int newWindowWidth, int newWindowHeight) {
+    if (!dirty && newWindowWidth == windowWidth && newWindowHeight == windowHeight) {
+        return false;
+    }
+
+    windowWidth = newWindowWidth;
+    windowHeight = newWindowHeight;
+    scale = std::min(static_cast<float>(windowWidth) / referenceWidth, static_cast<float>(windowHeight) / referenceHeight);
+
+    for (size_t i = 0; i < anchors.size(); ++i) {
+        const LayoutAnchor& anchor = anchors[i];
+        int width = scaled(anchor.width) + static_cast<int>(anchor.relativeWidth * windowWidth);
+        int height = scaled(anchor.height) + static_cast<int>(anchor.relativeHeight * windowHeight);
+        anchorRects[i] = resolve(anchor, width, height);
+    }
+    for (auto& flex : flexes) {
+        computeFlex(flex);
+    }
+
+    dirty = false;
+    return true;
+}
+
+SDL_Rect Layout::placeContent(int anchorId, int contentWidth, int contentHeight) const {
+    const SDL_Rect& rect = anchorRects[anchorId];
+    const LayoutAnchor& anchor = anchors[anchorId];
+    return SDL_Rect{
+        rect.x + static_cast<int>((rect.w - contentWidth) * anchor.pivotX),
+        rect.y + static_cast<int>((rect.h - contentHeight) * anchor.pivotY),
+        contentWidth, contentHeight
+    };
+}
+
+SDL_Rect Layout::resolve(const LayoutAnchor& anchor, int width, int height) const {
+    int x = static_cast<int>(anchor.anchorX * windowWidth) + scaled(anchor.offsetX) - static_cast<int>(anchor.pivotX * width);
+    int y = static_cast<int>(anchor.anchorY * windowHeight) + scaled(anchor.offsetY) - static_cast<int>(anchor.pivotY * height);
+    return SDL_Rect{ x, y, width, height };
+}
+
+void Layout::computeFlex(FlexEntry& flex) const {
+    const LayoutFlex& spec = flex.spec;
+    int itemWidth = scaled(spec.itemWidth);
+    int itemHeight = scaled(spec.itemHeight);
+    int spacing = scaled(spec.spacing);
+    int count = std::max(0, flex.count);
+
+    int mainSize = count > 0 ? count * ((spec.direction == FlexDirection::Row ? itemWidth : itemHeight) + spacing) - spacing : 0;
+    int width = spec.direction == FlexDirection::Row ? mainSize : itemWidth;
+    int height = spec.direction == FlexDirection::Row ? itemHeight : mainSize;
+    SDL_Rect box = resolve(spec.box, width, height);
+
+    flex.rects.resize(count);
+    for (int i = 0; i < count; ++i) {
+        if (spec.direction == FlexDirection::Row) {
+            flex.rects[i] = SDL_Rect{ box.x + i * (itemWidth + spacing), box.y, itemWidth, itemHeight };
+        }
+        else {
+            flex.rects[i] = SDL_Rect{ box.x, box.y + i * (itemHeight + spacing), itemWidth, itemHeight };
+        }
+    }
+}
\ No newline at end of file
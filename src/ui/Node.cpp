@@ -1,4 +1,6 @@
 #include "../includes/ui/Node.h"
+#include "../includes/systems/RenderStats.h"
+#include "../includes/systems/MemoryStats.h"
 #include <iostream>
 
 Node::Node(int x, int y, int size, const std::string& label, float opacity,
@@ -7,13 +9,13 @@ Node::Node(int x, int y, int size, const std::string& label, float opacity,
     SDL_Color color, std::vector<int> nextNodes)
     : rect{ x, y, size, size }, label(label), opacity(opacity), isCompleted(false),
     renderer(renderer), font(font), onClick(onClick), type(type),
-    color(color), nextNodes(nextNodes), labelTexture(nullptr), needsTextureUpdate(true) {
+    color(color), nextNodes(nextNodes), labelTexture(nullptr), labelRect{ 0, 0, 0, 0 }, needsTextureUpdate(true) {
     // Defer label creation to render()
 }
 
 Node::~Node() {
     if (labelTexture) {
-        SDL_DestroyTexture(labelTexture);
+        MemoryStats::destroyTexture(labelTexture);
         labelTexture = nullptr;
     }
 }
@@ -21,7 +23,7 @@ Node::~Node() {
 void Node::setRenderer(SDL_Renderer* newRenderer) {
     renderer = newRenderer;
     if (labelTexture) {
-        SDL_DestroyTexture(labelTexture);
+        MemoryStats::destroyTexture(labelTexture);
         labelTexture = nullptr;
     }
     needsTextureUpdate = true; // Defer texture creation to render()
@@ -30,15 +32,21 @@ void Node::setRenderer(SDL_Renderer* newRenderer) {
 void Node::setFont(TTF_Font* newFont) {
     font = newFont;
     if (labelTexture) {
-        SDL_DestroyTexture(labelTexture);
+        MemoryStats::destroyTexture(labelTexture);
         labelTexture = nullptr;
     }
     needsTextureUpdate = true; // Defer texture creation to render()
 }
 
+void Node::setRect(const SDL_Rect& newRect) {
+    rect = newRect;
+    labelRect.x = rect.x + (rect.w - labelRect.w) / 2;
+    labelRect.y = rect.y + rect.h + 5;
+}
+
 void Node::createLabelTexture() {
     if (labelTexture) {
-        SDL_DestroyTexture(labelTexture);
+        MemoryStats::destroyTexture(labelTexture);
         labelTexture = nullptr;
     }
 
@@ -59,7 +67,7 @@ void Node::createLabelTexture() {
         return;
     }
 
-    labelTexture = SDL_CreateTextureFromSurface(renderer, surface);
+    labelTexture = MemoryStats::createTextureFromSurface(renderer, surface);
     if (!labelTexture) {
         std::cerr << "Failed to create texture for label '" << label << "': " << SDL_GetError() << std::endl;
         SDL_FreeSurface(surface);
@@ -95,11 +103,11 @@ bool Node::handleEvent(SDL_Event& e) {
 void Node::render() const {
     SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, static_cast<Uint8>(opacity * 255));
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    SDL_RenderFillRect(renderer, &rect);
+    RenderStats::fillRect(renderer, &rect);
 
     if (opacity < 1.0f && !isCompleted) {
         SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-        SDL_RenderDrawRect(renderer, &rect);
+        RenderStats::drawRect(renderer, &rect);
     }
 
     // Create label texture if needed (non-const cast to modify labelTexture)
@@ -116,10 +124,10 @@ void Node::render() const {
         labelBgRect.h += 4;
         SDL_SetRenderDrawColor(renderer, 200, 200, 200, 200);
         SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-        SDL_RenderFillRect(renderer, &labelBgRect);
+        RenderStats::fillRect(renderer, &labelBgRect);
 
         SDL_SetTextureAlphaMod(labelTexture, static_cast<Uint8>(opacity * 255));
-        SDL_RenderCopy(renderer, labelTexture, nullptr, &labelRect);
+        RenderStats::copy(renderer, labelTexture, nullptr, &labelRect);
     }
     else {
         std::cerr << "No label texture for '" << label << "' during render" << std::endl;